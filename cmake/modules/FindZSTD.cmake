@@ -0,0 +1,63 @@
+#.rst:
+# FindZSTD
+# --------
+#
+# Find the Zstandard library header and define variables.
+#
+# Imported Targets
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines :prop_tgt:`IMPORTED` target ``ZSTD::ZSTD``,
+# if Zstandard has been found
+#
+# Result Variables
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines the following variables:
+#
+# ::
+#
+#   ZSTD_FOUND          - True if Zstandard is found.
+#   ZSTD_INCLUDE_DIRS   - Where to find zstd.h
+#
+# ::
+#
+#   ZSTD_VERSION        - The version of Zstandard found (x.y.z)
+#   ZSTD_VERSION_MAJOR  - The major version of Zstandard
+#   ZSTD_VERSION_MINOR  - The minor version of Zstandard
+#   ZSTD_VERSION_PATCH  - The patch version of Zstandard
+
+find_path(ZSTD_INCLUDE_DIR NAME zstd.h PATH_SUFFIXES include)
+
+if(NOT ZSTD_LIBRARY)
+  find_library(ZSTD_LIBRARY NAMES zstd PATH_SUFFIXES lib)
+endif()
+
+mark_as_advanced(ZSTD_INCLUDE_DIR)
+
+if(ZSTD_INCLUDE_DIR AND EXISTS "${ZSTD_INCLUDE_DIR}/zstd.h")
+  file(STRINGS "${ZSTD_INCLUDE_DIR}/zstd.h" ZSTD_H REGEX "^#define ZSTD_VERSION_[A-Z]+[ ]+[0-9]+.*$")
+  string(REGEX REPLACE ".+ZSTD_VERSION_MAJOR[ ]+([0-9]+).*$"   "\\1" ZSTD_VERSION_MAJOR "${ZSTD_H}")
+  string(REGEX REPLACE ".+ZSTD_VERSION_MINOR[ ]+([0-9]+).*$"   "\\1" ZSTD_VERSION_MINOR "${ZSTD_H}")
+  string(REGEX REPLACE ".+ZSTD_VERSION_RELEASE[ ]+([0-9]+).*$" "\\1" ZSTD_VERSION_PATCH "${ZSTD_H}")
+  set(ZSTD_VERSION "${ZSTD_VERSION_MAJOR}.${ZSTD_VERSION_MINOR}.${ZSTD_VERSION_PATCH}")
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(ZSTD
+  REQUIRED_VARS ZSTD_LIBRARY ZSTD_INCLUDE_DIR VERSION_VAR ZSTD_VERSION)
+
+if(ZSTD_FOUND)
+  set(ZSTD_INCLUDE_DIRS "${ZSTD_INCLUDE_DIR}")
+
+  if(NOT ZSTD_LIBRARIES)
+    set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+  endif()
+
+  if(NOT TARGET ZSTD::ZSTD)
+    add_library(ZSTD::ZSTD UNKNOWN IMPORTED)
+    set_target_properties(ZSTD::ZSTD PROPERTIES
+      IMPORTED_LOCATION "${ZSTD_LIBRARY}"
+      INTERFACE_INCLUDE_DIRECTORIES "${ZSTD_INCLUDE_DIRS}")
+  endif()
+endif()
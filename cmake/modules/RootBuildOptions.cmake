@@ -173,6 +173,7 @@ ROOT_BUILD_OPTION(x11 ON "X11 support")
 ROOT_BUILD_OPTION(xft ON "Xft support (X11 antialiased fonts)")
 ROOT_BUILD_OPTION(xml ON "XML parser interface")
 ROOT_BUILD_OPTION(xrootd ON "Build xrootd file server and its client (if supported)")
+ROOT_BUILD_OPTION(zstd ON "Zstandard compression support, requires libzstd")
 ROOT_BUILD_OPTION(coverage OFF "Test coverage")
 
 option(fail-on-missing "Fail the configure step if a required external package is missing" OFF)
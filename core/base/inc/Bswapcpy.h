@@ -36,12 +36,19 @@
 //                                                                      //
 // Author: Alexandre V. Vaniachine <AVVaniachine@lbl.gov>               //
 //                                                                      //
+// DEPRECATED: ROOT does not use these routines any longer. Use         //
+// ROOT::Internal::ByteSwapCopy16() and ByteSwapCopy32() declared in    //
+// ROOT/RByteSwapArray.hxx instead.                                     //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
+#include "ROOT/RConfig.h"
+
 #if !defined(__CINT__)
 #include <sys/types.h>
 #endif
 
+R__DEPRECATED(6,18, "Use ROOT::Internal::ByteSwapCopy16() from ROOT/RByteSwapArray.hxx")
 extern inline void * bswapcpy16(void * to, const void * from, size_t n)
 {
 int d0, d1, d2, d3;
@@ -57,6 +64,7 @@ __asm__ __volatile__(
 return (to);
 }
 
+R__DEPRECATED(6,18, "Use ROOT::Internal::ByteSwapCopy32() from ROOT/RByteSwapArray.hxx")
 extern inline void * bswapcpy32(void * to, const void * from, size_t n)
 {
 int d0, d1, d2, d3;
@@ -0,0 +1,49 @@
+// @(#)root/base
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RByteSwapArray
+#define ROOT_RByteSwapArray
+
+#include "Rtypes.h"
+
+#include <cstddef>
+
+namespace ROOT {
+namespace Internal {
+
+// Byte swapping of whole arrays between the big-endian on-file representation
+// and the host representation. The kernels are selected at run time according
+// to the instruction set supported by the CPU (SSSE3, AVX2 or AVX-512BW on
+// x86, a portable scalar loop elsewhere).
+//
+// n is the number of elements, not the number of bytes. to and from need not
+// be aligned and may be identical (in-place conversion), but must not
+// otherwise overlap.
+
+void ByteSwapCopy16(void *to, const void *from, std::size_t n);
+void ByteSwapCopy32(void *to, const void *from, std::size_t n);
+void ByteSwapCopy64(void *to, const void *from, std::size_t n);
+
+// Decode n Float16_t/Double32_t values stored with nbits of mantissa, i.e. as
+// one exponent byte followed by a big-endian short holding the truncated
+// mantissa and the sign (see TBufferFile::WriteFloat16). from points to 3*n bytes.
+void UnpackTruncatedFloats(Float_t *to, const char *from, std::size_t n, Int_t nbits);
+void UnpackTruncatedFloats(Double_t *to, const char *from, std::size_t n, Int_t nbits);
+
+// Decode n big-endian floats into doubles (Double32_t without range nor nbits).
+void UnpackFloatsToDoubles(Double_t *to, const char *from, std::size_t n);
+
+// Name of the kernel set in use: "scalar", "ssse3", "avx2" or "avx512".
+const char *GetByteSwapKernelName();
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,294 @@
+// @(#)root/base
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// \file RByteSwapArray.cxx
+///
+/// Array conversion between the big-endian on-file representation and the
+/// host representation, with SIMD kernels selected once, at first use,
+/// according to the capabilities of the CPU.
+
+#include "ROOT/RByteSwapArray.hxx"
+
+#include <string.h>
+
+#if defined(R__BYTESWAP) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 6)) && !defined(__INTEL_COMPILER)
+#define R__BSWAP_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using SwapFun_t = void (*)(char *, const char *, std::size_t);
+using UnpackFloatFun_t = void (*)(Float_t *, const char *, std::size_t, Int_t);
+using UnpackDoubleFun_t = void (*)(Double_t *, const char *, std::size_t, Int_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Portable element by element conversion, also used for the tails of the
+/// SIMD kernels.
+
+template <int Size>
+inline void SwapScalar(char *to, const char *from, std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      char tmp[Size];
+      memcpy(tmp, from + Size * i, Size);
+      for (int j = 0; j < Size; ++j)
+         to[Size * i + j] = tmp[Size - 1 - j];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Rebuild one float from its exponent byte and its big-endian truncated
+/// mantissa. Same encoding as TBufferFile::ReadWithNbits, without branches.
+
+inline Float_t UnpackOne(const char *rec, Int_t nbits)
+{
+   const UInt_t theExp = (UChar_t)rec[0];
+   const UInt_t theMan = ((UInt_t)(UChar_t)rec[1] << 8) | (UChar_t)rec[2];
+   UInt_t bits = theExp << 23;
+   bits |= (theMan & ((1u << (nbits + 1)) - 1)) << (23 - nbits);
+   bits |= ((theMan >> (nbits + 1)) & 1u) << 31;
+   Float_t value;
+   memcpy(&value, &bits, sizeof(value));
+   return value;
+}
+
+template <typename T>
+inline void UnpackTruncated(T *to, const char *from, std::size_t n, Int_t nbits)
+{
+   for (std::size_t i = 0; i < n; ++i)
+      to[i] = UnpackOne(from + 3 * i, nbits);
+}
+
+inline void UnpackFloats(Double_t *to, const char *from, std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      UInt_t bits;
+      memcpy(&bits, from + 4 * i, 4);
+#ifdef R__BYTESWAP
+      bits = (bits >> 24) | ((bits >> 8) & 0xff00u) | ((bits << 8) & 0xff0000u) | (bits << 24);
+#endif
+      Float_t value;
+      memcpy(&value, &bits, 4);
+      to[i] = value;
+   }
+}
+
+#ifdef R__BYTESWAP
+void Swap16Scalar(char *to, const char *from, std::size_t n) { SwapScalar<2>(to, from, n); }
+void Swap32Scalar(char *to, const char *from, std::size_t n) { SwapScalar<4>(to, from, n); }
+void Swap64Scalar(char *to, const char *from, std::size_t n) { SwapScalar<8>(to, from, n); }
+#else
+void CopyBytes(char *to, const char *from, std::size_t n)
+{
+   if (to != from)
+      memcpy(to, from, n);
+}
+void Swap16Scalar(char *to, const char *from, std::size_t n) { CopyBytes(to, from, 2 * n); }
+void Swap32Scalar(char *to, const char *from, std::size_t n) { CopyBytes(to, from, 4 * n); }
+void Swap64Scalar(char *to, const char *from, std::size_t n) { CopyBytes(to, from, 8 * n); }
+#endif
+void UnpackFloatScalar(Float_t *to, const char *from, std::size_t n, Int_t nbits) { UnpackTruncated(to, from, n, nbits); }
+void UnpackDoubleScalar(Double_t *to, const char *from, std::size_t n, Int_t nbits) { UnpackTruncated(to, from, n, nbits); }
+
+#ifdef R__BSWAP_X86_DISPATCH
+
+////////////////////////////////////////////////////////////////////////////////
+/// Byte shuffle reversing each Size-byte element of a 16-byte lane.
+
+template <int Size>
+struct SwapMask {
+   alignas(16) char fBytes[16];
+   SwapMask()
+   {
+      for (int j = 0; j < 16; ++j)
+         fBytes[j] = (j / Size) * Size + (Size - 1 - j % Size);
+   }
+};
+
+template <int Size>
+const char *GetSwapMask()
+{
+   static const SwapMask<Size> mask;
+   return mask.fBytes;
+}
+
+template <int Size>
+__attribute__((target("ssse3"))) void SwapSSSE3(char *to, const char *from, std::size_t n)
+{
+   const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i *>(GetSwapMask<Size>()));
+   const std::size_t perVec = 16 / Size;
+   std::size_t i = 0;
+   for (; i + perVec <= n; i += perVec) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + Size * i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(to + Size * i), _mm_shuffle_epi8(v, mask));
+   }
+   SwapScalar<Size>(to + Size * i, from + Size * i, n - i);
+}
+
+template <int Size>
+__attribute__((target("avx2"))) void SwapAVX2(char *to, const char *from, std::size_t n)
+{
+   // vpshufb works within 128-bit lanes: broadcast the lane mask.
+   const __m256i mask =
+      _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(GetSwapMask<Size>())));
+   const std::size_t perVec = 32 / Size;
+   std::size_t i = 0;
+   for (; i + 2 * perVec <= n; i += 2 * perVec) {
+      __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + Size * i));
+      __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + Size * (i + perVec)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + Size * i), _mm256_shuffle_epi8(v0, mask));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + Size * (i + perVec)), _mm256_shuffle_epi8(v1, mask));
+   }
+   for (; i + perVec <= n; i += perVec) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + Size * i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + Size * i), _mm256_shuffle_epi8(v, mask));
+   }
+   SwapScalar<Size>(to + Size * i, from + Size * i, n - i);
+}
+
+template <int Size>
+__attribute__((target("avx512f,avx512bw"))) void SwapAVX512(char *to, const char *from, std::size_t n)
+{
+   const __m512i mask =
+      _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i *>(GetSwapMask<Size>())));
+   const std::size_t perVec = 64 / Size;
+   std::size_t i = 0;
+   for (; i + perVec <= n; i += perVec) {
+      __m512i v = _mm512_loadu_si512(reinterpret_cast<const void *>(from + Size * i));
+      _mm512_storeu_si512(reinterpret_cast<void *>(to + Size * i), _mm512_shuffle_epi8(v, mask));
+   }
+   SwapScalar<Size>(to + Size * i, from + Size * i, n - i);
+}
+
+// The truncated encodings use 3-byte records, which do not map onto whole
+// registers; compiling the branchless loop for the wider instruction sets
+// lets the compiler vectorize the bit manipulation and the conversions.
+__attribute__((target("avx2"))) void UnpackFloatAVX2(Float_t *to, const char *from, std::size_t n, Int_t nbits)
+{
+   UnpackTruncated(to, from, n, nbits);
+}
+__attribute__((target("avx2"))) void UnpackDoubleAVX2(Double_t *to, const char *from, std::size_t n, Int_t nbits)
+{
+   UnpackTruncated(to, from, n, nbits);
+}
+
+#endif // R__BSWAP_X86_DISPATCH
+
+////////////////////////////////////////////////////////////////////////////////
+/// The set of kernels in use, chosen once per process.
+
+struct RKernels {
+   const char *fName = "scalar";
+   SwapFun_t fSwap16 = &Swap16Scalar;
+   SwapFun_t fSwap32 = &Swap32Scalar;
+   SwapFun_t fSwap64 = &Swap64Scalar;
+   UnpackFloatFun_t fUnpackFloat = &UnpackFloatScalar;
+   UnpackDoubleFun_t fUnpackDouble = &UnpackDoubleScalar;
+
+   RKernels()
+   {
+#ifdef R__BSWAP_X86_DISPATCH
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512bw")) {
+         fName = "avx512";
+         fSwap16 = &SwapAVX512<2>;
+         fSwap32 = &SwapAVX512<4>;
+         fSwap64 = &SwapAVX512<8>;
+         fUnpackFloat = &UnpackFloatAVX2;
+         fUnpackDouble = &UnpackDoubleAVX2;
+      } else if (__builtin_cpu_supports("avx2")) {
+         fName = "avx2";
+         fSwap16 = &SwapAVX2<2>;
+         fSwap32 = &SwapAVX2<4>;
+         fSwap64 = &SwapAVX2<8>;
+         fUnpackFloat = &UnpackFloatAVX2;
+         fUnpackDouble = &UnpackDoubleAVX2;
+      } else if (__builtin_cpu_supports("ssse3")) {
+         fName = "ssse3";
+         fSwap16 = &SwapSSSE3<2>;
+         fSwap32 = &SwapSSSE3<4>;
+         fSwap64 = &SwapSSSE3<8>;
+      }
+#endif
+   }
+};
+
+const RKernels &GetKernels()
+{
+   static const RKernels kernels;
+   return kernels;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n 2-byte values between big-endian and host byte order.
+
+void ByteSwapCopy16(void *to, const void *from, std::size_t n)
+{
+   GetKernels().fSwap16(static_cast<char *>(to), static_cast<const char *>(from), n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n 4-byte values between big-endian and host byte order.
+
+void ByteSwapCopy32(void *to, const void *from, std::size_t n)
+{
+   GetKernels().fSwap32(static_cast<char *>(to), static_cast<const char *>(from), n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n 8-byte values between big-endian and host byte order.
+
+void ByteSwapCopy64(void *to, const void *from, std::size_t n)
+{
+   GetKernels().fSwap64(static_cast<char *>(to), static_cast<const char *>(from), n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decode n truncated floats (exponent byte plus nbits of mantissa).
+
+void UnpackTruncatedFloats(Float_t *to, const char *from, std::size_t n, Int_t nbits)
+{
+   GetKernels().fUnpackFloat(to, from, n, nbits);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decode n truncated floats (exponent byte plus nbits of mantissa) into doubles.
+
+void UnpackTruncatedFloats(Double_t *to, const char *from, std::size_t n, Int_t nbits)
+{
+   GetKernels().fUnpackDouble(to, from, n, nbits);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decode n big-endian floats into doubles.
+
+void UnpackFloatsToDoubles(Double_t *to, const char *from, std::size_t n)
+{
+   UnpackFloats(to, from, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the kernel set selected for this CPU.
+
+const char *GetByteSwapKernelName()
+{
+   return GetKernels().fName;
+}
+
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/RByteSwapArray.hxx"
+#include "Bytes.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Reference conversion, element by element, with the scalar routines of Bytes.h.
+template <typename T>
+std::vector<T> Reference(const std::vector<char> &onfile, std::size_t n)
+{
+   std::vector<T> res(n);
+   char *cur = const_cast<char *>(onfile.data());
+   for (std::size_t i = 0; i < n; ++i)
+      frombuf(cur, &res[i]);
+   return res;
+}
+
+template <typename T>
+void CheckSwap(void (*swap)(void *, const void *, std::size_t))
+{
+   // Cover the vector bodies as well as all possible tail lengths.
+   for (std::size_t n : {0, 1, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000}) {
+      std::vector<char> onfile(n * sizeof(T));
+      for (std::size_t i = 0; i < onfile.size(); ++i)
+         onfile[i] = static_cast<char>(i * 37 + 11);
+      const auto expected = Reference<T>(onfile, n);
+
+      std::vector<T> values(n);
+      swap(values.data(), onfile.data(), n);
+      // Compare the bytes: the floating point patterns include NaNs.
+      EXPECT_EQ(0, memcmp(expected.data(), values.data(), onfile.size())) << "n = " << n;
+
+      // In place, as done for basket buffers.
+      swap(onfile.data(), onfile.data(), n);
+      EXPECT_EQ(0, memcmp(expected.data(), onfile.data(), onfile.size())) << "n = " << n;
+
+      // And back to the on-file representation.
+      std::vector<char> written(n * sizeof(T));
+      swap(written.data(), values.data(), n);
+      char *cur = onfile.data();
+      for (std::size_t i = 0; i < n; ++i)
+         tobuf(cur, values[i]);
+      EXPECT_EQ(onfile, written) << "n = " << n;
+   }
+}
+
+} // anonymous namespace
+
+TEST(RByteSwapArray, KernelName)
+{
+   const std::string name = ROOT::Internal::GetByteSwapKernelName();
+   EXPECT_TRUE(name == "scalar" || name == "ssse3" || name == "avx2" || name == "avx512") << name;
+}
+
+TEST(RByteSwapArray, Swap16)
+{
+   CheckSwap<Short_t>(ROOT::Internal::ByteSwapCopy16);
+}
+
+TEST(RByteSwapArray, Swap32)
+{
+   CheckSwap<Int_t>(ROOT::Internal::ByteSwapCopy32);
+   CheckSwap<Float_t>(ROOT::Internal::ByteSwapCopy32);
+}
+
+TEST(RByteSwapArray, Swap64)
+{
+   CheckSwap<Long64_t>(ROOT::Internal::ByteSwapCopy64);
+   CheckSwap<Double_t>(ROOT::Internal::ByteSwapCopy64);
+}
+
+TEST(RByteSwapArray, TruncatedFloats)
+{
+   // Exponent byte followed by the big-endian mantissa; with 12 bits, bit 13
+   // of the mantissa holds the sign.
+   const char onfile[] = {char(127), 0x08, 0x00, char(128), 0x20, 0x00, char(125), 0x00, 0x00};
+   Float_t f[3];
+   Double_t d[3];
+   ROOT::Internal::UnpackTruncatedFloats(f, onfile, 3, 12);
+   ROOT::Internal::UnpackTruncatedFloats(d, onfile, 3, 12);
+   EXPECT_FLOAT_EQ(1.5, f[0]);
+   EXPECT_FLOAT_EQ(-2., f[1]);
+   EXPECT_FLOAT_EQ(0.25, f[2]);
+   EXPECT_DOUBLE_EQ(1.5, d[0]);
+   EXPECT_DOUBLE_EQ(-2., d[1]);
+   EXPECT_DOUBLE_EQ(0.25, d[2]);
+
+   std::vector<Float_t> floats{1.f, -3.5f, 1e-3f, 42.f};
+   std::vector<char> packed(4 * floats.size());
+   char *cur = packed.data();
+   for (auto v : floats)
+      tobuf(cur, v);
+   std::vector<Double_t> doubles(floats.size());
+   ROOT::Internal::UnpackFloatsToDoubles(doubles.data(), packed.data(), floats.size());
+   for (std::size_t i = 0; i < floats.size(); ++i)
+      EXPECT_EQ((Double_t)floats[i], doubles[i]);
+}
@@ -12,12 +12,17 @@
 #include "Bits.h"
 #include "ZipLZMA.h"
 #include "ZipLZ4.h"
+#ifdef R__HAS_ZSTD
+#include "ZipZSTD.h"
+#endif
 
 #include "zlib.h"
 
 #include <stdio.h>
 #include <assert.h>
 
+#include <mutex>
+
 // The size of the ROOT block framing headers for compression:
 // - 3 bytes to identify the compression algorithm and version.
 // - 3 bytes to identify the deflated buffer size.
@@ -37,6 +42,7 @@ static void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigne
    R__ZipMode = 1 : ZLIB compression algorithm is used (default)
    R__ZipMode = 2 : LZMA compression algorithm is used
    R__ZipMode = 4 : LZ4  compression algorithm is used
+   R__ZipMode = 5 : ZSTD compression algorithm is used
    R__ZipMode = 0 or 3 : a very old compression algorithm is used
    (the very old algorithm is supported for backward compatibility)
    The LZMA algorithm requires the external XZ package be installed when linking
@@ -46,12 +52,17 @@ static void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigne
   The LZ4 algorithm requires the external LZ4 package to be installed when linking
   is done.  LZ4 typically has the worst compression ratios, but much faster decompression
   speeds - sometimes by an order of magnitude.
+
+  The ZSTD algorithm requires the external Zstandard package to be installed when
+  linking is done.  ZSTD compresses almost as well as LZMA at its higher levels, with
+  decompression speeds comparable to LZ4.
 */
 #ifdef R__HAS_DEFAULT_LZ4
-enum ROOT::ECompressionAlgorithm R__ZipMode = ROOT::ECompressionAlgorithm::kLZ4;
+static const enum ROOT::ECompressionAlgorithm R__DefaultZipMode = ROOT::ECompressionAlgorithm::kLZ4;
 #else
-enum ROOT::ECompressionAlgorithm R__ZipMode = ROOT::ECompressionAlgorithm::kZLIB;
+static const enum ROOT::ECompressionAlgorithm R__DefaultZipMode = ROOT::ECompressionAlgorithm::kZLIB;
 #endif
+enum ROOT::ECompressionAlgorithm R__ZipMode = R__DefaultZipMode;
 
 /* ===========================================================================
    Function to set the ZipMode
@@ -72,6 +83,8 @@ unsigned long R__crc32(unsigned long crc, const unsigned char* buf, unsigned int
 /*                      1 = zlib */
 /*                      2 = lzma */
 /*                      3 = old */
+/*                      4 = lz4 */
+/*                      5 = zstd */
 void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::ECompressionAlgorithm compressionAlgorithm)
      /* int cxlevel;                      compression level */
 {
@@ -97,6 +110,19 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
   } else if (compressionAlgorithm == ROOT::ECompressionAlgorithm::kLZ4) {
      R__zipLZ4(cxlevel, srcsize, src, tgtsize, tgt, irep);
      return;
+  } else if (compressionAlgorithm == ROOT::ECompressionAlgorithm::kZSTD) {
+#ifdef R__HAS_ZSTD
+     R__zipZSTD(cxlevel, srcsize, src, tgtsize, tgt, irep);
+#else
+     // Use the default algorithm instead, telling once rather than for every buffer.
+     static std::once_flag warnOnce;
+     std::call_once(warnOnce, []() {
+        fprintf(stderr, "Warning in R__zipMultipleAlgorithm: ROOT was built without ZSTD support, "
+                        "the default compression algorithm is used instead\n");
+     });
+     R__zipMultipleAlgorithm(cxlevel, srcsize, src, tgtsize, tgt, irep, R__DefaultZipMode);
+#endif
+     return;
   } else if (compressionAlgorithm == ROOT::ECompressionAlgorithm::kOldCompressionAlgo || compressionAlgorithm == ROOT::ECompressionAlgorithm::kUseGlobalCompressionSetting) {
      R__zipOld(cxlevel, srcsize, src, tgtsize, tgt, irep);
      return;
@@ -269,10 +295,15 @@ static int is_valid_header_lz4(unsigned char *src)
    return src[0] == 'L' && src[1] == '4';
 }
 
+static int is_valid_header_zstd(unsigned char *src)
+{
+   return src[0] == 'Z' && src[1] == 'S' && src[2] == 1;
+}
+
 static int is_valid_header(unsigned char *src)
 {
    return is_valid_header_zlib(src) || is_valid_header_old(src) || is_valid_header_lzma(src) ||
-          is_valid_header_lz4(src);
+          is_valid_header_lz4(src) || is_valid_header_zstd(src);
 }
 
 int R__unzip_header(int *srcsize, uch *src, int *tgtsize)
@@ -364,6 +395,13 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
   } else if (is_valid_header_lz4(src)) {
      R__unzipLZ4(srcsize, src, tgtsize, tgt, irep);
      return;
+  } else if (is_valid_header_zstd(src)) {
+#ifdef R__HAS_ZSTD
+     R__unzipZSTD(srcsize, src, tgtsize, tgt, irep);
+#else
+     fprintf(stderr, "R__unzip: buffer is ZSTD compressed but ROOT was built without ZSTD support\n");
+#endif
+     return;
   }
 
   /* Old zlib format */
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+
+#include "Compression.h"
+#include "RConfigure.h"
+#include "RZip.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Compressible content: repeated text with slowly varying bytes.
+std::vector<char> MakeInput(std::size_t size)
+{
+   const char text[] = "ROOT compression round trip ";
+   std::vector<char> input(size);
+   for (std::size_t i = 0; i < size; ++i)
+      input[i] = text[i % (sizeof(text) - 1)] + (i / 1000) % 3;
+   return input;
+}
+
+// Compress the input with the given algorithm, check the header and decompress it again.
+// Returns the two characters identifying the algorithm which was actually used.
+std::string RoundTrip(ROOT::ECompressionAlgorithm algorithm, int level)
+{
+   auto input = MakeInput(100000);
+   int srcSize = input.size();
+   std::vector<char> zipped(srcSize);
+   int zippedSize = zipped.size();
+   int irep = 0;
+   R__zipMultipleAlgorithm(level, &srcSize, input.data(), &zippedSize, zipped.data(), &irep, algorithm);
+   EXPECT_GT(irep, 0);
+   EXPECT_LT(irep, srcSize);
+   if (irep <= 0)
+      return "";
+
+   int nin = 0;
+   int nbuf = 0;
+   EXPECT_EQ(0, R__unzip_header(&nin, reinterpret_cast<unsigned char *>(zipped.data()), &nbuf));
+   EXPECT_EQ(irep, nin);
+   EXPECT_EQ(srcSize, nbuf);
+
+   std::vector<char> output(srcSize);
+   int nout = 0;
+   R__unzip(&nin, reinterpret_cast<unsigned char *>(zipped.data()), &nbuf,
+            reinterpret_cast<unsigned char *>(output.data()), &nout);
+   EXPECT_EQ(srcSize, nout);
+   EXPECT_EQ(input, output);
+   return std::string(zipped.data(), 2);
+}
+
+} // anonymous namespace
+
+TEST(RZip, RoundTripZLIB)
+{
+   for (int level : {1, 6, 9})
+      EXPECT_EQ("ZL", RoundTrip(ROOT::kZLIB, level));
+}
+
+TEST(RZip, RoundTripLZ4)
+{
+   for (int level : {1, 4, 9})
+      EXPECT_EQ("L4", RoundTrip(ROOT::kLZ4, level));
+}
+
+#ifdef R__HAS_ZSTD
+TEST(RZip, RoundTripZSTD)
+{
+   for (int level : {1, 5, 9})
+      EXPECT_EQ("ZS", RoundTrip(ROOT::kZSTD, level));
+}
+#else
+TEST(RZip, ZSTDFallback)
+{
+   // Without ZSTD support, buffers are compressed with the default algorithm and can be read back
+   EXPECT_NE("ZS", RoundTrip(ROOT::kZSTD, 5));
+}
+#endif
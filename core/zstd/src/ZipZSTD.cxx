@@ -0,0 +1,138 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ZipZSTD.h"
+
+#include "ROOT/RConfig.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <zstd.h>
+
+// Header consists of:
+// - 2 byte identifier "ZS"
+// - 1 byte ROOT-ZSTD format version.
+// - 3 bytes of compressed size
+// - 3 bytes of uncompressed size
+// The payload is a single, self-describing ZSTD frame.
+static const int kHeaderSize = 2 + 1 + 3 + 3;
+static const char kFormatVersion = 1;
+
+// ROOT compression levels go from 1 to 9; ZSTD levels go from 1 to ZSTD_maxCLevel() (19 or 22).
+// Spread the ROOT levels over the useful ZSTD range, keeping the low levels in the fast
+// strategies and leaving the slow "ultra" levels (20+) out since they need large windows.
+static const int kZSTDLevel[10] = {0, 1, 2, 3, 5, 7, 9, 12, 15, 19};
+
+namespace {
+struct ZSTDCCtxDeleter {
+   void operator()(ZSTD_CCtx *ctx) const { ZSTD_freeCCtx(ctx); }
+};
+struct ZSTDDCtxDeleter {
+   void operator()(ZSTD_DCtx *ctx) const { ZSTD_freeDCtx(ctx); }
+};
+
+// Creating a context allocates the (level dependent) work tables; keep one per thread
+// so that compressing many small baskets does not pay for it on every call.
+ZSTD_CCtx *GetCompressionContext()
+{
+   thread_local std::unique_ptr<ZSTD_CCtx, ZSTDCCtxDeleter> ctx(ZSTD_createCCtx());
+   return ctx.get();
+}
+
+ZSTD_DCtx *GetDecompressionContext()
+{
+   thread_local std::unique_ptr<ZSTD_DCtx, ZSTDDCtxDeleter> ctx(ZSTD_createDCtx());
+   return ctx.get();
+}
+} // namespace
+
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+   *irep = 0;
+
+   if (R__unlikely(*tgtsize <= kHeaderSize)) {
+      return;
+   }
+
+   // Refuse to compress more than 16MB at a time -- we are only allowed 3 bytes for size info.
+   if (R__unlikely(*srcsize > 0xffffff || *srcsize < 0)) {
+      return;
+   }
+
+   if (cxlevel > 9) {
+      cxlevel = 9;
+   }
+   if (cxlevel < 1) {
+      cxlevel = 1;
+   }
+
+   ZSTD_CCtx *ctx = GetCompressionContext();
+   if (R__unlikely(!ctx)) {
+      return;
+   }
+
+   size_t returnStatus =
+      ZSTD_compressCCtx(ctx, &tgt[kHeaderSize], *tgtsize - kHeaderSize, src, *srcsize, kZSTDLevel[cxlevel]);
+
+   // The most common error is the target buffer being too small, i.e. the data is not
+   // compressible; the caller then stores the buffer uncompressed.
+   if (R__unlikely(ZSTD_isError(returnStatus))) {
+      return;
+   }
+
+   uint64_t in_size = (unsigned)(*srcsize);
+   uint64_t out_size = returnStatus; /* compressed size */
+
+   tgt[0] = 'Z';
+   tgt[1] = 'S';
+   tgt[2] = kFormatVersion;
+
+   // NOTE: these next 6 bytes are required from the ROOT compressed buffer format;
+   // upper layers will assume they are laid out in a specific manner.
+   tgt[3] = (char)(out_size & 0xff);
+   tgt[4] = (char)((out_size >> 8) & 0xff);
+   tgt[5] = (char)((out_size >> 16) & 0xff);
+
+   tgt[6] = (char)(in_size & 0xff); /* decompressed size */
+   tgt[7] = (char)((in_size >> 8) & 0xff);
+   tgt[8] = (char)((in_size >> 16) & 0xff);
+
+   *irep = (int)returnStatus + kHeaderSize;
+}
+
+void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+{
+   // NOTE: We don't check that srcsize / tgtsize is reasonable or within the ROOT-imposed limits.
+   // This is assumed to be handled by the upper layers.
+
+   *irep = 0;
+   if (R__unlikely(src[0] != 'Z' || src[1] != 'S')) {
+      fprintf(stderr, "R__unzipZSTD: algorithm run against buffer with incorrect header (got %d%d; expected %d%d).\n",
+              src[0], src[1], 'Z', 'S');
+      return;
+   }
+   if (R__unlikely(src[2] != kFormatVersion)) {
+      fprintf(stderr, "R__unzipZSTD: unknown on-disk format version (got %d; expected %d).\n", src[2],
+              kFormatVersion);
+      return;
+   }
+
+   ZSTD_DCtx *ctx = GetDecompressionContext();
+   if (R__unlikely(!ctx)) {
+      return;
+   }
+
+   size_t returnStatus = ZSTD_decompressDCtx(ctx, tgt, *tgtsize, &src[kHeaderSize], *srcsize - kHeaderSize);
+   if (R__unlikely(ZSTD_isError(returnStatus))) {
+      fprintf(stderr, "R__unzipZSTD: error in decompression: %s\n", ZSTD_getErrorName(returnStatus));
+      return;
+   }
+
+   *irep = (int)returnStatus;
+}
@@ -166,6 +166,9 @@ namespace ROOT {
          /// evaluate the partial derivative with respect to the parameter
          T DoParameterDerivative(const T *x, const double *p, unsigned int ipar) const;
 
+         /// evaluate the function at n points at once, when the TF1 supports it
+         bool DoEvalParBatch(unsigned int n, const T *const *x, const double *p, T *f) const;
+
          bool fLinear;                 // flag for linear functions
          bool fPolynomial;             // flag for polynomial functions
          bool fOwnFunc;                 // flag to indicate we own the TF1 function pointer
@@ -207,6 +210,27 @@ namespace ROOT {
          }
       };
 
+      /**
+       * Auxiliar class to select at compile time the batch evaluation of TF1, which
+       * exists only for double.
+       */
+      template <class T>
+      struct TF1BatchEvaluation {
+         static bool EvalParBatch(TF1 *, unsigned int, unsigned int, const T *const *, const double *, T *)
+         {
+            return false;
+         }
+      };
+
+      template <>
+      struct TF1BatchEvaluation<double> {
+         static bool EvalParBatch(TF1 *func, unsigned int dim, unsigned int n, const double *const *x,
+                                  const double *p, double *f)
+         {
+            return func->EvalParBatch(n, dim, x, p, f);
+         }
+      };
+
       // implementations for WrappedMultiTF1Templ<T>
       template<class T>
       WrappedMultiTF1Templ<T>::WrappedMultiTF1Templ(TF1 &f, unsigned int dim)  :
@@ -288,6 +312,12 @@ namespace ROOT {
          }
       }
 
+      template<class T>
+      bool WrappedMultiTF1Templ<T>::DoEvalParBatch(unsigned int n, const T *const *x, const double *p, T *f) const
+      {
+         return TF1BatchEvaluation<T>::EvalParBatch(fFunc, fDim, n, x, p, f);
+      }
+
       template <class T>
       T WrappedMultiTF1Templ<T>::DoParameterDerivative(const T *x, const double *p, unsigned int ipar) const
       {
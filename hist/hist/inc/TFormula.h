@@ -99,9 +99,12 @@ private:
 
    TInterpreter::CallFuncIFacePtr_t::Generic_t fFuncPtr;   //!  function pointer
    void *   fLambdaPtr;                                    //!  pointer to the lambda function
+   TInterpreter::CallFuncIFacePtr_t::Generic_t fBatchFuncPtr = nullptr; //!  function pointer of the batch evaluation (see EvalParBatch)
+   Bool_t   fBatchFailed = kFALSE;                         //!  true if the batch evaluation could not be compiled
 
    void     InputFormulaIntoCling();
    Bool_t   PrepareEvalMethod();
+   Bool_t   PrepareBatchEvalMethod();
    void     FillDefaults();
    void     HandlePolN(TString &formula);
    void     HandleParametrizedFunctions(TString &formula);
@@ -187,6 +190,7 @@ public:
 #ifdef R__HAS_VECCORE
    ROOT::Double_v EvalParVec(const ROOT::Double_v *x, const Double_t *params = 0) const;
 #endif
+   Bool_t         EvalParBatch(Int_t n, Int_t ndim, const Double_t *const *x, const Double_t *params, Double_t *result) const;
    TString        GetExpFormula(Option_t *option="") const;
    const TObject *GetLinearPart(Int_t i) const;
    Int_t          GetNdim() const {return fNdim;}
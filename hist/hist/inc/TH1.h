@@ -81,6 +81,7 @@ public:
    };
 
    friend class TH1Merger;
+   friend class TH1ConcurrentFiller;
 
 protected:
     Int_t         fNcells;          ///< number of bins(1D), cells (2D) +U/Overflows
@@ -145,6 +146,7 @@ protected:
                                Option_t * opt, Bool_t doerr = kFALSE) const;
 
    virtual void     DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride=1);
+           void     DoFillNExtend(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride=1);
    Bool_t    GetStatOverflowsBehaviour() const { return EStatOverflows::kNeutral == fStatOverflows ? fgStatOverflows : EStatOverflows::kConsider == fStatOverflows; }
 
    static bool CheckAxisLimits(const TAxis* a1, const TAxis* a2);
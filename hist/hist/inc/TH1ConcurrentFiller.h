@@ -0,0 +1,112 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentFiller
+#define ROOT_TH1ConcurrentFiller
+
+#include "Rtypes.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class TH1;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class TH1ConcurrentFiller
+/// Fill one TH1, TH2 or TH3 from several threads at the same time, without
+/// a copy of the histogram per thread.
+///
+/// ~~~ {.cpp}
+/// TH2D h("h", "h", 100, -4, 4, 100, -4, 4);
+/// {
+///    TH1ConcurrentFiller filler(h);
+///    // in each thread:
+///    filler.Fill(x, y);
+/// } // the destructor calls Flush(); h now holds all the entries
+/// ~~~
+///
+/// The meaning of the arguments of Fill follows the histogram dimension, as
+/// for TH1::Fill, TH2::Fill and TH3::Fill: Fill(a, b) is Fill(x, w) for a
+/// TH1 and Fill(x, y) for a TH2.
+///
+/// Two storage strategies are available:
+///  - kAtomic: one shared array of bin contents updated with atomic
+///    operations. Memory does not grow with the number of threads; it is
+///    used for small histograms, where it costs little.
+///  - kSharded: each thread accumulates into its own blocks of bins,
+///    allocated only when a bin of the block is first filled. Memory grows
+///    with the region of the histogram actually filled by each thread
+///    rather than with its total size, and threads never contend. The sums
+///    of squares of weights of a block are only allocated once a weight
+///    different from 1 falls into it.
+/// With kAuto (the default), kAtomic is used for histograms of up to
+/// fgAtomicMaxCells cells and kSharded for bigger ones.
+///
+/// Bins are found with TAxis::FindFixBin: axes are not extended while filling
+/// concurrently. Statistics (entries, sums of weights and moments) are kept
+/// per thread. Everything is added to the histogram by Flush(), which must
+/// not run concurrently with Fill().
+///
+/// Only histograms whose bins count the entries falling into them are
+/// supported. Profiles (TProfile, TProfile2D, TProfile3D) need the sums of the
+/// profiled variable as well, TH2Poly bins are polygons that are not found on
+/// the axes, and TH1K keeps the filled values: they are rejected.
+
+class TH1ConcurrentFiller {
+public:
+   enum EMode {
+      kAuto,   ///< Choose according to the number of cells of the histogram
+      kAtomic, ///< Shared bins, updated atomically
+      kSharded ///< Per-thread bin blocks, allocated on demand
+   };
+
+   static Int_t fgAtomicMaxCells; ///< Largest histogram (in cells) filled atomically in kAuto mode
+   static const Int_t kBlockSize = 4096; ///< Number of cells in a block of kSharded mode
+
+   TH1ConcurrentFiller(TH1 &hist, EMode mode = kAuto);
+   TH1ConcurrentFiller(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller &operator=(const TH1ConcurrentFiller &) = delete;
+   ~TH1ConcurrentFiller();
+
+   Int_t Fill(Double_t x);
+   Int_t Fill(Double_t x, Double_t y);
+   Int_t Fill(Double_t x, Double_t y, Double_t z);
+   Int_t Fill(Double_t x, Double_t y, Double_t z, Double_t w);
+
+   void  Flush();
+
+   EMode GetMode() const { return fMode; }
+   TH1  &GetHist() const { return fHist; }
+
+private:
+   struct RShard;
+
+   TH1 &fHist;
+   EMode fMode;
+   Int_t fDimension;
+   Int_t fNcells;
+   Bool_t fStatOverflows;
+   ULong64_t fId; ///< Unique identifier, used to validate the per-thread shard cache
+
+   std::unique_ptr<std::atomic<Double_t>[]> fSumw;  ///< Bin contents in kAtomic mode
+   std::unique_ptr<std::atomic<Double_t>[]> fSumw2; ///< Sum of squares of weights in kAtomic mode
+
+   std::mutex fShardsMutex;
+   std::map<std::thread::id, std::unique_ptr<RShard>> fShards;
+
+   RShard &GetShard();
+   RShard &GetShardSlow();
+   Int_t   DoFill(Int_t binx, Int_t biny, Int_t binz, Double_t x, Double_t y, Double_t z, Double_t w);
+};
+
+#endif
@@ -52,6 +52,7 @@ protected:
    virtual TProfile *DoProfile(bool onX, const char *name, Int_t firstbin, Int_t lastbin, Option_t *option) const;
    virtual TH1D     *DoQuantiles(bool onX, const char *name, Double_t prob) const;
    virtual void      DoFitSlices(bool onX, TF1 *f1, Int_t firstbin, Int_t lastbin, Int_t cut, Option_t *option, TObjArray* arr);
+           void      DoFillNFixed(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *w, Int_t stride);
 
    Int_t    BufferFill(Double_t, Double_t) {return -2;} //may not use
    Int_t    Fill(Double_t); //MayNotUse
@@ -32,14 +32,14 @@
 #include "TArrayC.h"
 
 class THnSparseCompactBinCoord;
+class THnSparseBinMap;
 
 class THnSparse: public THnBase {
  private:
    Int_t      fChunkSize;    // number of entries for each chunk
    Long64_t   fFilledBins;   // number of filled bins
    TObjArray  fBinContent;   // array of THnSparseArrayChunk
-   TExMap     fBins;         //! filled bins
-   TExMap     fBinsContinued;//! filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   THnSparseBinMap *fBins;   //! filled bins: maps compact bin coordinates to bin indexes
    THnSparseCompactBinCoord *fCompactCoord; //! compact coordinate
 
    THnSparse(const THnSparse&); // Not implemented
@@ -52,6 +52,7 @@ class THnSparse: public THnBase {
              const Int_t* nbins, const Double_t* xmin, const Double_t* xmax,
              Int_t chunksize);
    THnSparseCompactBinCoord* GetCompactCoord() const;
+   THnSparseBinMap* GetBinMap();
    THnSparseArrayChunk* GetChunk(Int_t idx) const {
       return (THnSparseArrayChunk*) fBinContent[idx]; }
 
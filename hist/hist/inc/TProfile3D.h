@@ -81,6 +81,8 @@ private:
       { MayNotUse("SetBins(Int_t, Double_t, Double_t, Int_t, Double_t, Double_t"); }
    void SetBins(Int_t, const Double_t*, Int_t, const Double_t*)
       { MayNotUse("SetBins(Int_t, const Double_t*, Int_t, const Double_t*"); }
+   void FillN(Int_t, const Double_t *, const Double_t *, const Double_t *, const Double_t *, Int_t)
+      { MayNotUse("FillN(Int_t, const Double_t*, const Double_t*, const Double_t*, const Double_t*, Int_t"); }
 
 public:
    TProfile3D();
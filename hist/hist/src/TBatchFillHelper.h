@@ -0,0 +1,82 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBatchFillHelper
+#define ROOT_TBatchFillHelper
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TBatchFillHelper                                                     //
+//                                                                      //
+// Building blocks of the FillN fast paths of the histogram classes:    //
+// entries are processed in chunks, bin numbers are computed for a      //
+// whole chunk with TAxis::FindFixBins and the statistics are reduced   //
+// with independent partial sums, which the compiler can vectorize.    //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+namespace ROOT {
+namespace Internal {
+
+struct TBatchFillHelper {
+   /// Number of entries processed at once.
+   static const Int_t kChunk = 256;
+
+   /// Sum of a[0..n-1].
+   static Double_t Sum(Int_t n, const Double_t *a)
+   {
+      Double_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+      Int_t i = 0;
+      for (; i + 4 <= n; i += 4) {
+         s0 += a[i];
+         s1 += a[i + 1];
+         s2 += a[i + 2];
+         s3 += a[i + 3];
+      }
+      for (; i < n; ++i)
+         s0 += a[i];
+      return (s0 + s1) + (s2 + s3);
+   }
+
+   /// Sum of a[i]*b[i] for i in [0, n).
+   static Double_t SumProd(Int_t n, const Double_t *a, const Double_t *b)
+   {
+      Double_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+      Int_t i = 0;
+      for (; i + 4 <= n; i += 4) {
+         s0 += a[i] * b[i];
+         s1 += a[i + 1] * b[i + 1];
+         s2 += a[i + 2] * b[i + 2];
+         s3 += a[i + 3] * b[i + 3];
+      }
+      for (; i < n; ++i)
+         s0 += a[i] * b[i];
+      return (s0 + s1) + (s2 + s3);
+   }
+
+   /// Whether one of w[0], w[stride], ..., w[(n-1)*stride] differs from 1.
+   static Bool_t HasWeights(Int_t n, const Double_t *w, Int_t stride)
+   {
+      if (!w)
+         return kFALSE;
+      for (Int_t i = 0; i < n; ++i) {
+         if (w[i * stride] != 1.)
+            return kTRUE;
+      }
+      return kFALSE;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
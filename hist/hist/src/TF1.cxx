@@ -1425,6 +1425,28 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function at n points in one call, see TFormula::EvalParBatch.
+/// result[i] is the value of the function at the point (x[0][i], ..., x[ndim-1][i])
+/// for the parameters params (or the current parameters if params is null).
+///
+/// Only functions defined by a formula support it; returns false, without
+/// evaluating anything, otherwise. The fit utilities use it to evaluate the
+/// model function on whole chunks of the data set.
+
+Bool_t TF1::EvalParBatch(Int_t n, Int_t ndim, const Double_t *const *x, const Double_t *params, Double_t *result)
+{
+   if (fType != EFType::kFormula || !fFormula)
+      return kFALSE;
+   if (!fFormula->EvalParBatch(n, ndim, x, params, result))
+      return kFALSE;
+   if (fNormalized && fNormIntegral != 0) {
+      for (Int_t i = 0; i < n; ++i)
+         result[i] /= fNormIntegral;
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
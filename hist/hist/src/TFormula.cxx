@@ -213,6 +213,8 @@ static const TString gNamePrefix = "TFormula__";
 // static map of function pointers and expressions
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
+// static map of the batch evaluation functions, by name (see TFormula::EvalParBatch)
+static std::unordered_map<std::string,  void *> gClingBatchFunctions;
 
 ////////////////////////////////////////////////////////////////////////////////
 Bool_t TFormula::IsOperator(const char c)
@@ -691,6 +693,8 @@ void TFormula::Copy(TObject &obj) const
    }
 
    fnew.fFuncPtr = fFuncPtr;
+   fnew.fBatchFuncPtr = fBatchFuncPtr;
+   fnew.fBatchFailed = fBatchFailed;
 
 }
 
@@ -705,6 +709,8 @@ void TFormula::Clear(Option_t * )
    fNumber = 0;
    fFormula = "";
    fClingName = "";
+   fBatchFuncPtr = nullptr;
+   fBatchFailed = false;
 
 
    if(fMethod) fMethod->Delete();
@@ -795,6 +801,56 @@ bool TFormula::PrepareEvalMethod()
    return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compile in Cling the batch evaluation function of the formula: a loop
+/// calling the formula function (fClingName) for n points, in which Cling
+/// can inline the expression and vectorize it.
+/// The function is shared by all formulas with the same expression and
+/// dimension. Must be called with gROOTMutex locked.
+
+Bool_t TFormula::PrepareBatchEvalMethod()
+{
+   TString batchName = TString::Format("%s_batch%d", fClingName.Data(), fNdim);
+   auto funcit = gClingBatchFunctions.find(batchName.Data());
+   if (funcit != gClingBatchFunctions.end()) {
+      fBatchFuncPtr = (TInterpreter::CallFuncIFacePtr_t::Generic_t)funcit->second;
+      return kTRUE;
+   }
+
+   // same arguments as the prototype built in ProcessFormula
+   TString callArgs;
+   if (fNdim > 0 || fNpar > 0)
+      callArgs = (fNpar > 0) ? "xi, p" : "xi";
+   TString batchInput = TString::Format("#pragma cling optimize(2)\n"
+                                        "void %s(Int_t n, const Double_t *const *x, Double_t *p, Double_t *result) {\n"
+                                        "   for (Int_t i = 0; i < n; ++i) {\n"
+                                        "      Double_t xi[%d] = {};\n"
+                                        "      for (Int_t d = 0; d < %d; ++d) xi[d] = x[d][i];\n"
+                                        "      result[i] = %s(%s);\n"
+                                        "   }\n"
+                                        "}\n",
+                                        batchName.Data(), fNdim > 0 ? fNdim : 1, fNdim, fClingName.Data(),
+                                        callArgs.Data());
+   if (!gCling->Declare(batchInput)) {
+      Error("PrepareBatchEvalMethod", "Can't compile the batch evaluation of %s", fClingName.Data());
+      return kFALSE;
+   }
+
+   TMethodCall method;
+   method.InitWithPrototype(batchName, "Int_t,const Double_t*const*,Double_t*,Double_t*");
+   if (!method.IsValid() || !gCling->CallFunc_IsValid(method.GetCallFunc())) {
+      Error("PrepareBatchEvalMethod", "Can't find the batch evaluation function %s", batchName.Data());
+      return kFALSE;
+   }
+   fBatchFuncPtr = gCling->CallFunc_IFacePtr(method.GetCallFunc()).fGeneric;
+   if (!fBatchFuncPtr) {
+      Error("PrepareBatchEvalMethod", "Compiled function pointer is null");
+      return kFALSE;
+   }
+   gClingBatchFunctions.insert(std::make_pair(std::string(batchName.Data()), (void *)fBatchFuncPtr));
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///    Inputs formula, transfered to C++ code into Cling
 
@@ -2265,6 +2321,8 @@ void TFormula::ProcessFormula(TString &formula)
          // set the cling name using hash of the static formulae map
          auto hasher = gClingFunctions.hash_function();
          fClingName = TString::Format("%s__id%zu", gNamePrefix.Data(), hasher(inputFormulaVecFlag));
+         fBatchFuncPtr = nullptr;
+         fBatchFailed = false;
 
          fClingInput = TString::Format("%s %s(%s){ return %s ; }", argType.Data(), fClingName.Data(),
                                        argumentsPrototype.Data(), inputFormula.c_str());
@@ -3042,6 +3100,8 @@ void TFormula::SetVectorized(Bool_t vectorized)
       fReadyToExecute = false;
       fClingName = "";
       fClingInput = fFormula;
+      fBatchFuncPtr = nullptr;
+      fBatchFailed = false;
 
       if (fMethod)
          fMethod->Delete();
@@ -3137,6 +3197,52 @@ ROOT::Double_v TFormula::EvalParVec(const ROOT::Double_v *x, const Double_t *par
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula at n points in one call: result[i] is the value for
+/// the variables x[0][i], ..., x[ndim-1][i] and the parameters params (or the
+/// parameters of the formula if params is null).
+///
+/// The coordinates are passed per dimension, as they are stored by the fit
+/// data classes. On first use, a loop over the points calling the formula is
+/// compiled by Cling next to the formula function; the formula is inlined in
+/// the loop, which saves the cost of a call through the interpreter wrapper
+/// per point and lets the compiler vectorize the expression.
+///
+/// Returns false, without evaluating anything, if the batch evaluation is
+/// not available: for vectorized formulas, lambda expressions, formulas
+/// which are not ready to be executed, or if ndim is smaller than the
+/// dimension of the formula. The caller should then use EvalPar.
+
+Bool_t TFormula::EvalParBatch(Int_t n, Int_t ndim, const Double_t *const *x, const Double_t *params,
+                              Double_t *result) const
+{
+   if (fVectorized || TestBit(TFormula::kLambda) || !fReadyToExecute || fBatchFailed || ndim < fNdim)
+      return kFALSE;
+
+   if (!fBatchFuncPtr) {
+      R__LOCKGUARD(gROOTMutex);
+      auto thisFormula = const_cast<TFormula*>(this);
+      if (!fClingInitialized && fLazyInitialization)
+         thisFormula->ReInitializeEvalMethod();
+      if (!fClingInitialized)
+         return kFALSE;
+      if (!fBatchFuncPtr && !thisFormula->PrepareBatchEvalMethod()) {
+         thisFormula->fBatchFailed = kTRUE;
+         return kFALSE;
+      }
+   }
+
+   if (n <= 0) return kTRUE;
+   Double_t *pars = (params) ? const_cast<Double_t *>(params) : const_cast<Double_t *>(fClingParameters.data());
+   void *args[4];
+   args[0] = &n;
+   args[1] = const_cast<const Double_t *const **>(&x);
+   args[2] = &pars;
+   args[3] = &result;
+   (*fBatchFuncPtr)(0, 4, args, nullptr);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets first 4  variables (e.g. x, y, z, t) and evaluate formula.
 
@@ -15,6 +15,7 @@
 #include <ctype.h>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
 
 #include "Riostream.h"
 #include "TROOT.h"
@@ -51,6 +52,7 @@
 #include "Math/QuantFuncMathCore.h"
 
 #include "TH1Merger.h"
+#include "TBatchFillHelper.h"
 
 /** \addtogroup Hist
 @{
@@ -313,6 +315,16 @@ When using the options 2 or 3 above, the labels are automatically
  capacity (127 or 32767). Histograms of all types may have positive
  or/and negative bin contents.
 
+ The Fill functions are not thread safe. To fill one histogram from several
+ threads without making a copy of it per thread, use TH1ConcurrentFiller:
+~~~ {.cpp}
+       TH1ConcurrentFiller filler(*h2);
+       // in each thread
+       filler.Fill(x, y);
+       // once all threads are done
+       filler.Flush();
+~~~
+
 #### Rebinning
  At any time, an histogram can be rebinned via TH1::Rebin. This function
  returns a new histogram with the rebinned contents.
@@ -3380,6 +3392,53 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 /// called directly by TH1::BufferEmpty
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
+{
+   // An axis which can be extended needs TAxis::FindBin entry by entry.
+   if (fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) {
+      DoFillNExtend(ntimes, x, w, stride);
+      return;
+   }
+
+   using ROOT::Internal::TBatchFillHelper;
+   const Int_t kChunk = TBatchFillHelper::kChunk;
+
+   fEntries += ntimes;
+   // Same rule as in TH1::Fill: a weight different from 1 triggers Sumw2.
+   if (!fSumw2.fN && !TestBit(TH1::kIsNotW) && TBatchFillHelper::HasWeights(ntimes, w, stride))
+      Sumw2();
+
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   const Int_t nbins = fXaxis.GetNbins();
+   Int_t bins[kChunk];
+   Double_t z[kChunk], zx[kChunk], xs[kChunk];
+   for (Int_t first = 0; first < ntimes; first += kChunk) {
+      const Int_t n = std::min(kChunk, ntimes - first);
+      const Double_t *xc = x + first * stride;
+      const Double_t *wc = w ? w + first * stride : nullptr;
+      fXaxis.FindFixBins(n, xc, bins, stride);
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t ww = wc ? wc[i * stride] : 1.;
+         if (fSumw2.fN) fSumw2.fArray[bins[i]] += ww*ww;
+         AddBinContent(bins[i], ww);
+      }
+      // Entries not used for the statistics contribute zeros.
+      for (Int_t i = 0; i < n; ++i) {
+         const Bool_t inRange = statOverflows || (bins[i] > 0 && bins[i] <= nbins);
+         z[i] = inRange ? (wc ? wc[i * stride] : 1.) : 0.;
+         xs[i] = inRange ? xc[i * stride] : 0.;
+         zx[i] = z[i] * xs[i];
+      }
+      fTsumw   += TBatchFillHelper::Sum(n, z);
+      fTsumw2  += TBatchFillHelper::SumProd(n, z, z);
+      fTsumwx  += TBatchFillHelper::Sum(n, zx);
+      fTsumwx2 += TBatchFillHelper::SumProd(n, zx, xs);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Entry by entry version of TH1::DoFillN, for axes which can be extended.
+
+void TH1::DoFillNExtend(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
    Int_t bin,i;
 
@@ -0,0 +1,330 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TH1ConcurrentFiller.h"
+#include "TH1.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile3D.h"
+#include "TH2Poly.h"
+#include "TH1K.h"
+#include "TAxis.h"
+#include "TArrayD.h"
+#include "TError.h"
+
+#include <algorithm>
+#include <vector>
+
+/** \class TH1ConcurrentFiller
+    \ingroup Hist
+Fill a TH1, TH2 or TH3 concurrently from several threads.
+See the class description in TH1ConcurrentFiller.h.
+*/
+
+Int_t TH1ConcurrentFiller::fgAtomicMaxCells = 4096;
+
+namespace {
+
+std::atomic<ULong64_t> gFillerId{0};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Atomic addition for doubles (std::atomic<double>::fetch_add is C++20).
+
+inline void AtomicAdd(std::atomic<Double_t> &target, Double_t value)
+{
+   Double_t old = target.load(std::memory_order_relaxed);
+   while (!target.compare_exchange_weak(old, old + value, std::memory_order_relaxed))
+      ;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// What each filling thread accumulates on its own.
+
+struct TH1ConcurrentFiller::RShard {
+   Double_t fStats[TH1::kNstat] = {0}; ///< Same layout as TH1::GetStats
+   Double_t fEntries = 0;
+   Bool_t fWeighted = kFALSE; ///< Whether a weight different from 1 was used
+   /// kSharded mode: blocks of kBlockSize sums of weights, allocated on first use.
+   std::vector<std::unique_ptr<Double_t[]>> fBlocks;
+   /// kSharded mode: the matching sums of squares of weights, allocated when a
+   /// weight different from 1 first falls into the block. Until then they are
+   /// equal to the sums of weights.
+   std::vector<std::unique_ptr<Double_t[]>> fBlocks2;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare to fill hist concurrently. hist must outlive the filler and must
+/// not be used otherwise until Flush() has been called.
+
+TH1ConcurrentFiller::TH1ConcurrentFiller(TH1 &hist, EMode mode)
+   : fHist(hist), fMode(mode), fDimension(hist.GetDimension()), fNcells(hist.GetNcells()),
+     fStatOverflows(hist.GetStatOverflowsBehaviour()), fId(++gFillerId)
+{
+   // Entries still sitting in the buffer define the axis limits: the
+   // concurrent fill needs them fixed.
+   if (fHist.GetBuffer())
+      fHist.BufferEmpty(1);
+
+   // The bins of these classes are not plain counters of the entries found on the axes.
+   if (hist.InheritsFrom(TProfile::Class()) || hist.InheritsFrom(TProfile2D::Class()) ||
+       hist.InheritsFrom(TProfile3D::Class()) || hist.InheritsFrom(TH2Poly::Class()) ||
+       hist.InheritsFrom(TH1K::Class())) {
+      Error("TH1ConcurrentFiller::TH1ConcurrentFiller", "%s histograms are not supported, %s will not be filled",
+            hist.ClassName(), hist.GetName());
+      // No Fill overload matches a dimension of 0: every call is rejected.
+      fDimension = 0;
+      return;
+   }
+
+   if (fMode == kAuto)
+      fMode = fNcells <= fgAtomicMaxCells ? kAtomic : kSharded;
+
+   if (fMode == kAtomic) {
+      fSumw.reset(new std::atomic<Double_t>[fNcells]());
+      fSumw2.reset(new std::atomic<Double_t>[fNcells]());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Flush the remaining entries into the histogram.
+
+TH1ConcurrentFiller::~TH1ConcurrentFiller()
+{
+   Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the shard of the calling thread, creating it if needed.
+/// The last lookup of each thread is cached, so that the mutex is only
+/// taken the first time a thread fills or when it alternates between fillers.
+
+TH1ConcurrentFiller::RShard &TH1ConcurrentFiller::GetShard()
+{
+   struct RCache {
+      ULong64_t fId = 0;
+      RShard *fShard = nullptr;
+   };
+   thread_local RCache cache;
+   if (R__likely(cache.fId == fId))
+      return *cache.fShard;
+   RShard &shard = GetShardSlow();
+   cache.fId = fId;
+   cache.fShard = &shard;
+   return shard;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up (or create) the shard of the calling thread.
+
+TH1ConcurrentFiller::RShard &TH1ConcurrentFiller::GetShardSlow()
+{
+   std::lock_guard<std::mutex> lock(fShardsMutex);
+   auto &shard = fShards[std::this_thread::get_id()];
+   if (!shard) {
+      shard.reset(new RShard);
+      if (fMode == kSharded) {
+         shard->fBlocks.resize((fNcells + kBlockSize - 1) / kBlockSize);
+         shard->fBlocks2.resize(shard->fBlocks.size());
+      }
+   }
+   return *shard;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Increment the cell (binx, biny, binz) and the statistics, following the
+/// rules of TH1::Fill, TH2::Fill and TH3::Fill.
+
+Int_t TH1ConcurrentFiller::DoFill(Int_t binx, Int_t biny, Int_t binz, Double_t x, Double_t y, Double_t z, Double_t w)
+{
+   RShard &shard = GetShard();
+   ++shard.fEntries;
+   if (binx < 0 || biny < 0 || binz < 0)
+      return -1;
+   if (w != 1.)
+      shard.fWeighted = kTRUE;
+
+   const Int_t bin = fHist.GetBin(binx, biny, binz);
+   if (fMode == kAtomic) {
+      AtomicAdd(fSumw[bin], w);
+      AtomicAdd(fSumw2[bin], w * w);
+   } else {
+      const Int_t b = bin / kBlockSize;
+      const Int_t i = bin % kBlockSize;
+      std::unique_ptr<Double_t[]> &block = shard.fBlocks[b];
+      if (!block)
+         block.reset(new Double_t[kBlockSize]());
+      std::unique_ptr<Double_t[]> &block2 = shard.fBlocks2[b];
+      if (!block2 && w != 1.) {
+         // All previous entries of the block had a unit weight.
+         block2.reset(new Double_t[kBlockSize]);
+         std::copy(block.get(), block.get() + kBlockSize, block2.get());
+      }
+      block[i] += w;
+      if (block2)
+         block2[i] += w * w;
+   }
+
+   if (!fStatOverflows) {
+      if (binx == 0 || binx > fHist.GetXaxis()->GetNbins())
+         return -1;
+      if (fDimension > 1 && (biny == 0 || biny > fHist.GetYaxis()->GetNbins()))
+         return -1;
+      if (fDimension > 2 && (binz == 0 || binz > fHist.GetZaxis()->GetNbins()))
+         return -1;
+   }
+   Double_t *s = shard.fStats;
+   s[0] += w;
+   s[1] += w * w;
+   s[2] += w * x;
+   s[3] += w * x * x;
+   if (fDimension > 1) {
+      s[4] += w * y;
+      s[5] += w * y * y;
+      s[6] += w * x * y;
+   }
+   if (fDimension > 2) {
+      s[7] += w * z;
+      s[8] += w * z * z;
+      s[9] += w * x * z;
+      s[10] += w * y * z;
+   }
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 1D histogram with x; for 2D and 3D histograms, see the other overloads.
+
+Int_t TH1ConcurrentFiller::Fill(Double_t x)
+{
+   if (fDimension != 1) {
+      Error("TH1ConcurrentFiller::Fill", "Wrong number of coordinates for histogram %s", fHist.GetName());
+      return -1;
+   }
+   return DoFill(fHist.GetXaxis()->FindFixBin(x), 0, 0, x, 0., 0., 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill (x, w) for a 1D histogram, (x, y) for a 2D histogram.
+
+Int_t TH1ConcurrentFiller::Fill(Double_t x, Double_t y)
+{
+   if (fDimension == 1)
+      return DoFill(fHist.GetXaxis()->FindFixBin(x), 0, 0, x, 0., 0., y);
+   if (fDimension == 2)
+      return DoFill(fHist.GetXaxis()->FindFixBin(x), fHist.GetYaxis()->FindFixBin(y), 0, x, y, 0., 1.);
+   Error("TH1ConcurrentFiller::Fill", "Wrong number of coordinates for histogram %s", fHist.GetName());
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill (x, y, w) for a 2D histogram, (x, y, z) for a 3D histogram.
+
+Int_t TH1ConcurrentFiller::Fill(Double_t x, Double_t y, Double_t z)
+{
+   if (fDimension == 2)
+      return DoFill(fHist.GetXaxis()->FindFixBin(x), fHist.GetYaxis()->FindFixBin(y), 0, x, y, 0., z);
+   if (fDimension == 3)
+      return DoFill(fHist.GetXaxis()->FindFixBin(x), fHist.GetYaxis()->FindFixBin(y),
+                    fHist.GetZaxis()->FindFixBin(z), x, y, z, 1.);
+   Error("TH1ConcurrentFiller::Fill", "Wrong number of coordinates for histogram %s", fHist.GetName());
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill (x, y, z) with weight w for a 3D histogram.
+
+Int_t TH1ConcurrentFiller::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
+{
+   if (fDimension != 3) {
+      Error("TH1ConcurrentFiller::Fill", "Wrong number of coordinates for histogram %s", fHist.GetName());
+      return -1;
+   }
+   return DoFill(fHist.GetXaxis()->FindFixBin(x), fHist.GetYaxis()->FindFixBin(y), fHist.GetZaxis()->FindFixBin(z),
+                 x, y, z, w);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add everything filled so far to the histogram and start from scratch.
+/// Must be called once the filling threads are done; the filler can be
+/// reused afterwards.
+
+void TH1ConcurrentFiller::Flush()
+{
+   std::lock_guard<std::mutex> lock(fShardsMutex);
+
+   Double_t entries = 0;
+   Bool_t weighted = kFALSE;
+   Double_t stats[TH1::kNstat] = {0};
+   for (auto &idShard : fShards) {
+      const RShard &shard = *idShard.second;
+      entries += shard.fEntries;
+      weighted |= shard.fWeighted;
+      for (Int_t i = 0; i < TH1::kNstat; ++i)
+         stats[i] += shard.fStats[i];
+   }
+   if (entries == 0) {
+      fShards.clear();
+      return;
+   }
+
+   // Take the statistics before touching the bins: TH1::GetStats might
+   // recompute them from the bin contents.
+   Double_t histStats[TH1::kNstat] = {0};
+   fHist.GetStats(histStats);
+   const Double_t histEntries = fHist.GetEntries();
+
+   // Same rule as TH1::Fill: weights different from 1 trigger the storage of
+   // the sum of squares of weights.
+   if (weighted && fHist.GetSumw2N() == 0 && !fHist.TestBit(TH1::kIsNotW))
+      fHist.Sumw2();
+   Double_t *sumw2 = fHist.GetSumw2N() ? fHist.GetSumw2()->GetArray() : nullptr;
+
+   if (fMode == kAtomic) {
+      for (Int_t bin = 0; bin < fNcells; ++bin) {
+         const Double_t w = fSumw[bin].exchange(0., std::memory_order_relaxed);
+         const Double_t w2 = fSumw2[bin].exchange(0., std::memory_order_relaxed);
+         if (w == 0 && w2 == 0)
+            continue;
+         fHist.AddBinContent(bin, w);
+         if (sumw2)
+            sumw2[bin] += w2;
+      }
+   } else {
+      for (auto &idShard : fShards) {
+         const RShard &shard = *idShard.second;
+         for (std::size_t b = 0; b < shard.fBlocks.size(); ++b) {
+            const Double_t *block = shard.fBlocks[b].get();
+            if (!block)
+               continue;
+            const Double_t *block2 = shard.fBlocks2[b] ? shard.fBlocks2[b].get() : block;
+            const Int_t first = b * kBlockSize;
+            const Int_t n = std::min<Int_t>(kBlockSize, fNcells - first);
+            for (Int_t i = 0; i < n; ++i) {
+               if (block[i] == 0 && block2[i] == 0)
+                  continue;
+               fHist.AddBinContent(first + i, block[i]);
+               if (sumw2)
+                  sumw2[first + i] += block2[i];
+            }
+         }
+      }
+   }
+
+   for (Int_t i = 0; i < TH1::kNstat; ++i)
+      histStats[i] += stats[i];
+   fHist.PutStats(histStats);
+   fHist.SetEntries(histEntries + entries);
+
+   fShards.clear();
+   // Shards are gone: force the threads to look them up again.
+   fId = ++gFillerId;
+}
@@ -24,6 +24,9 @@
 #include "TMath.h"
 #include "TObjString.h"
 #include "TVirtualHistPainter.h"
+#include "TBatchFillHelper.h"
+
+#include <algorithm>
 
 
 ClassImp(TH2);
@@ -551,6 +554,12 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
          return;
    }
 
+   // Fast path, for axes which cannot be extended.
+   if (!(fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) && !(fYaxis.CanExtend() && !fYaxis.IsAlphanumeric())) {
+      DoFillNFixed((ntimes - ifirst) / stride, x + ifirst, y + ifirst, w ? w + ifirst : nullptr, stride);
+      return;
+   }
+
    Double_t ww = 1;
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
@@ -580,6 +589,57 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of TH2::FillN for axes which cannot be extended: the bin
+/// numbers are computed a chunk of entries at a time and the statistics are
+/// accumulated with vectorizable reductions.
+
+void TH2::DoFillNFixed(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *w, Int_t stride)
+{
+   using ROOT::Internal::TBatchFillHelper;
+   const Int_t kChunk = TBatchFillHelper::kChunk;
+
+   fEntries += ntimes;
+   if (!fSumw2.fN && !TestBit(TH1::kIsNotW) && TBatchFillHelper::HasWeights(ntimes, w, stride))
+      Sumw2();   // must be called before AddBinContent
+
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   const Int_t nbinsx = fXaxis.GetNbins();
+   const Int_t nbinsy = fYaxis.GetNbins();
+   Int_t binx[kChunk], biny[kChunk];
+   Double_t z[kChunk], xs[kChunk], ys[kChunk], zx[kChunk], zy[kChunk];
+   for (Int_t first = 0; first < ntimes; first += kChunk) {
+      const Int_t n = std::min(kChunk, ntimes - first);
+      const Double_t *xc = x + first * stride;
+      const Double_t *yc = y + first * stride;
+      const Double_t *wc = w ? w + first * stride : nullptr;
+      fXaxis.FindFixBins(n, xc, binx, stride);
+      fYaxis.FindFixBins(n, yc, biny, stride);
+      for (Int_t i = 0; i < n; ++i) {
+         const Int_t bin = biny[i] * (nbinsx + 2) + binx[i];
+         const Double_t ww = wc ? wc[i * stride] : 1.;
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin, ww);
+      }
+      // Entries not used for the statistics contribute zeros.
+      for (Int_t i = 0; i < n; ++i) {
+         const Bool_t inRange = statOverflows || (binx[i] > 0 && binx[i] <= nbinsx && biny[i] > 0 && biny[i] <= nbinsy);
+         z[i] = inRange ? (wc ? wc[i * stride] : 1.) : 0.;
+         xs[i] = inRange ? xc[i * stride] : 0.;
+         ys[i] = inRange ? yc[i * stride] : 0.;
+         zx[i] = z[i] * xs[i];
+         zy[i] = z[i] * ys[i];
+      }
+      fTsumw   += TBatchFillHelper::Sum(n, z);
+      fTsumw2  += TBatchFillHelper::SumProd(n, z, z);
+      fTsumwx  += TBatchFillHelper::Sum(n, zx);
+      fTsumwx2 += TBatchFillHelper::SumProd(n, zx, xs);
+      fTsumwy  += TBatchFillHelper::Sum(n, zy);
+      fTsumwy2 += TBatchFillHelper::SumProd(n, zy, ys);
+      fTsumwxy += TBatchFillHelper::SumProd(n, zx, ys);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill histogram following distribution in function fname.
 ///
@@ -23,6 +23,9 @@
 #include "TError.h"
 #include "TMath.h"
 #include "TObjString.h"
+#include "TBatchFillHelper.h"
+
+#include <algorithm>
 
 ClassImp(TH3);
 
@@ -382,6 +385,101 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+/// Equivalent to calling Fill(x[i], y[i], z[i], w[i]) for each entry. When
+/// none of the axes can be extended, the bins are computed a chunk of entries
+/// at a time with TAxis::FindFixBins and the statistics are accumulated with
+/// vectorizable reductions.
+/// If w is NULL each entry is assumed a weight=1
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t first = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (; first < ntimes; ++first) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         const Int_t i = first * stride;
+         BufferFill(x[i], y[i], z[i], w ? w[i] : 1.);
+      }
+      if (first == ntimes)
+         return;
+   }
+
+   if ((fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) || (fYaxis.CanExtend() && !fYaxis.IsAlphanumeric()) ||
+       (fZaxis.CanExtend() && !fZaxis.IsAlphanumeric())) {
+      for (; first < ntimes; ++first) {
+         const Int_t i = first * stride;
+         Fill(x[i], y[i], z[i], w ? w[i] : 1.);
+      }
+      return;
+   }
+
+   using ROOT::Internal::TBatchFillHelper;
+   const Int_t kChunk = TBatchFillHelper::kChunk;
+
+   fEntries += ntimes - first;
+   if (!fSumw2.fN && !TestBit(TH1::kIsNotW) &&
+       TBatchFillHelper::HasWeights(ntimes - first, w ? w + first * stride : nullptr, stride))
+      Sumw2();   // must be called before AddBinContent
+
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   const Int_t nbinsx = fXaxis.GetNbins();
+   const Int_t nbinsy = fYaxis.GetNbins();
+   const Int_t nbinsz = fZaxis.GetNbins();
+   Int_t binx[kChunk], biny[kChunk], binz[kChunk];
+   Double_t u[kChunk], xs[kChunk], ys[kChunk], zs[kChunk], ux[kChunk], uy[kChunk], uz[kChunk];
+   for (; first < ntimes; first += kChunk) {
+      const Int_t n = std::min(kChunk, ntimes - first);
+      const Double_t *xc = x + first * stride;
+      const Double_t *yc = y + first * stride;
+      const Double_t *zc = z + first * stride;
+      const Double_t *wc = w ? w + first * stride : nullptr;
+      fXaxis.FindFixBins(n, xc, binx, stride);
+      fYaxis.FindFixBins(n, yc, biny, stride);
+      fZaxis.FindFixBins(n, zc, binz, stride);
+      for (Int_t i = 0; i < n; ++i) {
+         const Int_t bin = binx[i] + (nbinsx + 2) * (biny[i] + (nbinsy + 2) * binz[i]);
+         const Double_t ww = wc ? wc[i * stride] : 1.;
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin, ww);
+      }
+      // Entries not used for the statistics contribute zeros.
+      for (Int_t i = 0; i < n; ++i) {
+         const Bool_t inRange = statOverflows || (binx[i] > 0 && binx[i] <= nbinsx && biny[i] > 0 &&
+                                                  biny[i] <= nbinsy && binz[i] > 0 && binz[i] <= nbinsz);
+         u[i] = inRange ? (wc ? wc[i * stride] : 1.) : 0.;
+         xs[i] = inRange ? xc[i * stride] : 0.;
+         ys[i] = inRange ? yc[i * stride] : 0.;
+         zs[i] = inRange ? zc[i * stride] : 0.;
+         ux[i] = u[i] * xs[i];
+         uy[i] = u[i] * ys[i];
+         uz[i] = u[i] * zs[i];
+      }
+      fTsumw   += TBatchFillHelper::Sum(n, u);
+      fTsumw2  += TBatchFillHelper::SumProd(n, u, u);
+      fTsumwx  += TBatchFillHelper::Sum(n, ux);
+      fTsumwx2 += TBatchFillHelper::SumProd(n, ux, xs);
+      fTsumwy  += TBatchFillHelper::Sum(n, uy);
+      fTsumwy2 += TBatchFillHelper::SumProd(n, uy, ys);
+      fTsumwxy += TBatchFillHelper::SumProd(n, ux, ys);
+      fTsumwz  += TBatchFillHelper::Sum(n, uz);
+      fTsumwz2 += TBatchFillHelper::SumProd(n, uz, zs);
+      fTsumwxz += TBatchFillHelper::SumProd(n, ux, zs);
+      fTsumwyz += TBatchFillHelper::SumProd(n, uy, zs);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
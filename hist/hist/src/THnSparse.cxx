@@ -410,6 +410,141 @@ THnSparseCompactBinCoord::~THnSparseCompactBinCoord()
    delete [] fCurrentBin;
 }
 
+/** \class THnSparseBinMap
+THnSparseBinMap is used internally by THnSparse to find the linear index of
+a filled bin given its compacted coordinates.
+
+It is a flat open-addressing hash table: keys (the hash of the compact
+coordinates, which is the compact coordinate itself if it fits into 8 bytes)
+and values (linear bin index + 1, 0 marking an empty slot) are stored in two
+contiguous arrays. Slots are probed in aligned groups of kGroupSize keys; the
+comparisons within a group are independent of each other, so that the
+compiler can turn them into a few vector instructions, and a lookup touches
+a single cache line in the vast majority of cases.
+
+Bins are never removed individually, only all at once by Clear(). Hence a
+lookup can stop at the first group that has an empty slot. Colliding hashes
+(only possible for compact coordinates larger than 8 bytes) simply occupy
+several slots; the caller disambiguates them by comparing the coordinates.
+*/
+
+class THnSparseBinMap {
+public:
+   enum { kGroupSize = 4 }; // slots probed at once; must be a power of 2
+
+   THnSparseBinMap(): fMask(0), fShift(64), fSize(0), fKeys(0), fValues(0) {}
+   ~THnSparseBinMap() { delete [] fKeys; delete [] fValues; }
+
+   /// Return the linear bin index stored for hash for which matches(index)
+   /// is true, or -1. If not found, slot is set to the slot where such a bin
+   /// should be inserted (see Insert()).
+   template <class MATCHES>
+   Long64_t Find(ULong64_t hash, MATCHES matches, Long64_t &slot) const {
+      slot = -1;
+      if (!fValues) return -1;
+      Long64_t group = Home(hash) & ~(Long64_t)(kGroupSize - 1);
+      while (true) {
+         UInt_t matchMask = 0;
+         UInt_t emptyMask = 0;
+         for (Int_t i = 0; i < kGroupSize; ++i) {
+            matchMask |= (UInt_t)(fKeys[group + i] == hash && fValues[group + i]) << i;
+            emptyMask |= (UInt_t)(fValues[group + i] == 0) << i;
+         }
+         for (Int_t i = 0; matchMask; ++i, matchMask >>= 1) {
+            if ((matchMask & 1) && matches(fValues[group + i] - 1))
+               return fValues[group + i] - 1;
+         }
+         if (emptyMask) {
+            Int_t i = 0;
+            while (!(emptyMask & (1u << i))) ++i;
+            slot = group + i;
+            return -1;
+         }
+         group = (group + kGroupSize) & fMask;
+      }
+   }
+
+   /// Store linidx for hash in slot, as returned by Find() for the same hash.
+   /// If the table needs to grow, slot is ignored and a new one is looked up.
+   void Insert(ULong64_t hash, Long64_t linidx, Long64_t slot) {
+      if (slot < 0 || 2 * (fSize + 1) > fMask + 1) {
+         Reserve(fSize + 1);
+         slot = FindEmpty(hash);
+      }
+      fKeys[slot] = hash;
+      fValues[slot] = linidx + 1;
+      ++fSize;
+   }
+
+   /// Make room for n bins without rehashing, i.e. keep the load factor
+   /// below 1/2.
+   void Reserve(Long64_t n) {
+      Long64_t capacity = fMask + 1;
+      if (fValues && 2 * n <= capacity) return;
+      Int_t bits = 4;
+      while ((1LL << bits) < 2 * n) ++bits;
+      Rehash(bits);
+   }
+
+   void Clear() {
+      delete [] fKeys;
+      delete [] fValues;
+      fKeys = 0;
+      fValues = 0;
+      fMask = 0;
+      fShift = 64;
+      fSize = 0;
+   }
+
+   Long64_t GetSize() const { return fSize; }
+   Long64_t GetCapacity() const { return fValues ? fMask + 1 : 0; }
+
+private:
+   THnSparseBinMap(const THnSparseBinMap&); // intentionally not implemented
+   THnSparseBinMap& operator=(const THnSparseBinMap&); // intentionally not implemented
+
+   /// Home slot of hash: Fibonacci hashing spreads the compact coordinates,
+   /// whose low bits only encode the first axis, over the whole table.
+   Long64_t Home(ULong64_t hash) const {
+      return (Long64_t)((hash * 0x9E3779B97F4A7C15ULL) >> fShift);
+   }
+
+   Long64_t FindEmpty(ULong64_t hash) const {
+      Long64_t group = Home(hash) & ~(Long64_t)(kGroupSize - 1);
+      while (true) {
+         for (Int_t i = 0; i < kGroupSize; ++i)
+            if (!fValues[group + i]) return group + i;
+         group = (group + kGroupSize) & fMask;
+      }
+   }
+
+   void Rehash(Int_t bits) {
+      ULong64_t *oldKeys = fKeys;
+      Long64_t *oldValues = fValues;
+      const Long64_t oldCapacity = GetCapacity();
+      const Long64_t capacity = 1LL << bits;
+      fKeys = new ULong64_t[capacity];
+      fValues = new Long64_t[capacity];
+      memset(fValues, 0, capacity * sizeof(Long64_t));
+      fMask = capacity - 1;
+      fShift = 64 - bits;
+      for (Long64_t i = 0; i < oldCapacity; ++i) {
+         if (!oldValues[i]) continue;
+         const Long64_t slot = FindEmpty(oldKeys[i]);
+         fKeys[slot] = oldKeys[i];
+         fValues[slot] = oldValues[i];
+      }
+      delete [] oldKeys;
+      delete [] oldValues;
+   }
+
+   Long64_t   fMask;   // capacity - 1
+   Int_t      fShift;  // 64 - log2(capacity)
+   Long64_t   fSize;   // number of bins stored
+   ULong64_t *fKeys;   //[capacity] hash of the compact coordinates
+   Long64_t  *fValues; //[capacity] linear bin index + 1, 0 for an empty slot
+};
+
 /** \class THnSparseArrayChunk
 THnSparseArrayChunk is used internally by THnSparse.
 THnSparse stores its (dynamic size) array of bin coordinates and their
@@ -571,14 +706,16 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in fBins, a flat open-addressing
+hash table (see the internal class THnSparseBinMap). For each slot with the
+same hash, the coordinates of the bin it points to are compared to the
+coordinates passed to GetBin(). Different coordinates with the same hash
+are extremely unlikely but (for the case where the compact bin coordinates
+are larger than 8 bytes) possible; they simply occupy several slots of the
+table.
+The table is not written to file: it is rebuilt from the coordinates stored
+in the chunks when a THnSparse is read back, so the on-file format does not
+depend on it.
 */
 
 
@@ -588,7 +725,7 @@ ClassImp(THnSparse);
 /// Construct an empty THnSparse.
 
 THnSparse::THnSparse():
-   fChunkSize(1024), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(1024), fFilledBins(0), fBins(0), fCompactCoord(0)
 {
    fBinContent.SetOwner();
 }
@@ -605,7 +742,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
                      const Int_t* nbins, const Double_t* xmin, const Double_t* xmax,
                      Int_t chunksize):
    THnBase(name, title, dim, nbins, xmin, xmax),
-   fChunkSize(chunksize), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(chunksize), fFilledBins(0), fBins(0), fCompactCoord(0)
 {
    fCompactCoord = new THnSparseCompactBinCoord(dim, nbins);
    fBinContent.SetOwner();
@@ -615,6 +752,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
 /// Destruct a THnSparse
 
 THnSparse::~THnSparse() {
+   delete fBins;
    delete fCompactCoord;
 }
 
@@ -651,35 +789,27 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///We have been streamed; set up fBins
+/// We have been streamed; set up fBins from the coordinates stored in the
+/// chunks. The bin map is not persistent, so the on-file layout is the same
+/// whatever the in-memory index.
 
 void THnSparse::FillExMap()
 {
    TIter iChunk(&fBinContent);
    THnSparseArrayChunk* chunk = 0;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
+   THnSparseBinMap* binMap = GetBinMap();
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   binMap->Reserve(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
       for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
+         // Bins are unique: no need to look for an existing entry.
+         ULong64_t hash = compactCoord.GetHashFromBuffer(buf);
+         binMap->Insert(hash, idx, -1);
       }
    }
 }
@@ -688,12 +818,11 @@ void THnSparse::FillExMap()
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
+   THnSparseBinMap* binMap = GetBinMap();
+   if (!binMap->GetSize() && fBinContent.GetSize()) {
       FillExMap();
    }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
-   }
+   binMap->Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -791,20 +920,15 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 {
    THnSparseCompactBinCoord* cc = GetCompactCoord();
    ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
+   THnSparseBinMap* binMap = GetBinMap();
+   if (fBinContent.GetSize() && !binMap->GetSize())
       FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
-
-      linidx = nextlinidx;
-   }
+   const Char_t* buf = cc->GetBuffer();
+   Long64_t slot = -1;
+   Long64_t linidx = binMap->Find(hash, [&](Long64_t idx) {
+         return GetChunk(idx / fChunkSize)->Matches(idx % fChunkSize, buf);
+      }, slot);
+   if (linidx >= 0) return linidx;
    if (!allocate) return -1;
 
    ++fFilledBins;
@@ -820,16 +944,7 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   binMap->Insert(hash, newidx, slot);
    return newidx;
 }
 
@@ -849,6 +964,16 @@ THnSparseCompactBinCoord* THnSparse::GetCompactCoord() const
    return fCompactCoord;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the filled bins, creating it if needed.
+
+THnSparseBinMap* THnSparse::GetBinMap()
+{
+   if (!fBins)
+      fBins = new THnSparseBinMap();
+   return fBins;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the amount of filled bins over all bins
 
@@ -881,7 +1006,8 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   if (fBins)
+      size += (sizeof(ULong64_t) + sizeof(Long64_t)) * fBins->GetCapacity();
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -963,8 +1089,8 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   if (fBins)
+      fBins->Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
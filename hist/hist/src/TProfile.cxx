@@ -20,6 +20,9 @@
 #include "TClass.h"
 
 #include "TProfileHelper.h"
+#include "TBatchFillHelper.h"
+
+#include <algorithm>
 
 Bool_t TProfile::fgApproximate = kFALSE;
 
@@ -770,6 +773,12 @@ void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const D
          return;
    }
 
+   // Fast path, for an axis which cannot be extended.
+   if (!(fXaxis.CanExtend() && !fXaxis.IsAlphanumeric())) {
+      DoFillNFixed((ntimes - ifirst) / stride, x + ifirst, y + ifirst, w ? w + ifirst : nullptr, stride);
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       if (fYmin != fYmax) {
          if (y[i] <fYmin || y[i]> fYmax || TMath::IsNaN(y[i])) continue;
@@ -795,6 +804,70 @@ void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const D
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of TProfile::FillN for an axis which cannot be extended:
+/// the bin numbers are computed a chunk of entries at a time and the
+/// statistics are accumulated with vectorizable reductions.
+
+void TProfile::DoFillNFixed(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *w, Int_t stride)
+{
+   using ROOT::Internal::TBatchFillHelper;
+   const Int_t kChunk = TBatchFillHelper::kChunk;
+
+   const Bool_t useRange = fYmin != fYmax;
+   auto accept = [&](Double_t yy) { return !useRange || !(yy < fYmin || yy > fYmax || TMath::IsNaN(yy)); };
+
+   // Same rule as in TProfile::Fill, restricted to the accepted entries.
+   if (!fBinSumw2.fN && w && !TestBit(TH1::kIsNotW)) {
+      for (Int_t i = 0; i < ntimes; ++i) {
+         if (w[i * stride] != 1. && accept(y[i * stride])) {
+            Sumw2();   // must be called before accumulating the entries
+            break;
+         }
+      }
+   }
+
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   const Int_t nbins = fXaxis.GetNbins();
+   Int_t bins[kChunk];
+   Double_t u[kChunk], xs[kChunk], ys[kChunk], ux[kChunk], uy[kChunk];
+   for (Int_t first = 0; first < ntimes; first += kChunk) {
+      const Int_t n = std::min(kChunk, ntimes - first);
+      const Double_t *xc = x + first * stride;
+      const Double_t *yc = y + first * stride;
+      const Double_t *wc = w ? w + first * stride : nullptr;
+      fXaxis.FindFixBins(n, xc, bins, stride);
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t yy = yc[i * stride];
+         if (!accept(yy)) {
+            bins[i] = -1;
+            continue;
+         }
+         const Double_t ww = wc ? wc[i * stride] : 1.;
+         fEntries++;
+         AddBinContent(bins[i], ww*yy);
+         fSumw2.fArray[bins[i]] += ww*yy*yy;
+         if (fBinSumw2.fN)  fBinSumw2.fArray[bins[i]] += ww*ww;
+         fBinEntries.fArray[bins[i]] += ww;
+      }
+      // Entries not used for the statistics contribute zeros.
+      for (Int_t i = 0; i < n; ++i) {
+         const Bool_t inRange = bins[i] >= 0 && (statOverflows || (bins[i] > 0 && bins[i] <= nbins));
+         u[i] = inRange ? (wc ? wc[i * stride] : 1.) : 0.;
+         xs[i] = inRange ? xc[i * stride] : 0.;
+         ys[i] = inRange ? yc[i * stride] : 0.;
+         ux[i] = u[i] * xs[i];
+         uy[i] = u[i] * ys[i];
+      }
+      fTsumw   += TBatchFillHelper::Sum(n, u);
+      fTsumw2  += TBatchFillHelper::SumProd(n, u, u);
+      fTsumwx  += TBatchFillHelper::Sum(n, ux);
+      fTsumwx2 += TBatchFillHelper::SumProd(n, ux, xs);
+      fTsumwy  += TBatchFillHelper::Sum(n, uy);
+      fTsumwy2 += TBatchFillHelper::SumProd(n, uy, ys);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return bin content of a Profile histogram.
 
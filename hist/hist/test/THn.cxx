@@ -1,9 +1,13 @@
 #include "gtest/gtest.h"
 
 #include "THn.h"
+#include "THnSparse.h"
+#include "TBufferFile.h"
 #include "TH1.h"
 #include "TH2.h"
 
+#include <memory>
+
 // Filling THn
 TEST(THn, Fill) {
    Int_t bins[2] = {2, 3};
@@ -108,3 +112,52 @@ TEST(THn, Projection) {
 
 
 }
+
+// Bin lookup in THnSparse, for compact coordinates fitting in 8 bytes and larger
+TEST(THnSparse, GetBin) {
+   for (Int_t nbinsPerDim : {10, 1000}) {
+      const Int_t ndim = 8; // 8 x 4 bits or 8 x 10 bits
+      Int_t bins[ndim];
+      Double_t xmin[ndim], xmax[ndim];
+      for (Int_t d = 0; d < ndim; ++d) {
+         bins[d] = nbinsPerDim;
+         xmin[d] = 0.;
+         xmax[d] = nbinsPerDim;
+      }
+      THnSparseD hs("hs", "hs", ndim, bins, xmin, xmax, 128);
+
+      const Int_t nfill = 5000;
+      Int_t coord[ndim];
+      // distinct coordinates for each i
+      auto setCoord = [&](Int_t i) {
+         for (Int_t d = 0; d < ndim; ++d, i /= nbinsPerDim)
+            coord[d] = 1 + i % nbinsPerDim;
+      };
+      for (Int_t i = 0; i < nfill; ++i) {
+         setCoord(i);
+         EXPECT_EQ(hs.GetBin(coord), i);
+         hs.AddBinContent(coord, i);
+      }
+      EXPECT_EQ(hs.GetNbins(), nfill);
+      for (Int_t i = nfill - 1; i >= 0; --i) {
+         setCoord(i);
+         EXPECT_EQ(hs.GetBin(coord, kFALSE), i);
+         EXPECT_DOUBLE_EQ(hs.GetBinContent(coord), i);
+      }
+      coord[0] = 0;
+      EXPECT_EQ(hs.GetBin(coord, kFALSE), -1);
+
+      // The bin index is rebuilt after streaming
+      TBufferFile buf(TBuffer::kWrite);
+      buf.WriteObject(&hs);
+      buf.SetReadMode();
+      buf.SetBufferOffset(0);
+      std::unique_ptr<THnSparseD> read(static_cast<THnSparseD *>(buf.ReadObject(THnSparseD::Class())));
+      ASSERT_TRUE(read.get());
+      EXPECT_EQ(read->GetNbins(), nfill);
+      for (Int_t i = 0; i < nfill; i += 7) {
+         setCoord(i);
+         EXPECT_EQ(read->GetBin(coord, kFALSE), i);
+      }
+   }
+}
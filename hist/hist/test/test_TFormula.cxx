@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+
+#include "TFormula.h"
+#include "TF1.h"
+#include "TH1.h"
+#include "TFitResult.h"
+
+#include <cmath>
+#include <vector>
+
+// Batch evaluation must give the same values as the point by point evaluation
+TEST(TFormula, EvalParBatch)
+{
+   TFormula f("f", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]*y");
+   const Double_t params[] = {2., 0.5, 1.5, 0.1};
+   f.SetParameters(params);
+
+   const Int_t n = 1001;
+   std::vector<Double_t> x(n), y(n), result(n);
+   for (Int_t i = 0; i < n; ++i) {
+      x[i] = -5. + 0.01 * i;
+      y[i] = 0.5 * i;
+   }
+   const Double_t *coords[] = {x.data(), y.data()};
+   ASSERT_TRUE(f.EvalParBatch(n, 2, coords, nullptr, result.data()));
+   for (Int_t i = 0; i < n; ++i) {
+      Double_t point[] = {x[i], y[i]};
+      EXPECT_DOUBLE_EQ(f.EvalPar(point), result[i]);
+   }
+
+   // explicit parameters, and a formula with the same expression sharing the batch function
+   const Double_t params2[] = {1., -1., 0.5, 0.};
+   TFormula g("g", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]*y");
+   ASSERT_TRUE(g.EvalParBatch(n, 2, coords, params2, result.data()));
+   for (Int_t i = 0; i < n; ++i) {
+      Double_t point[] = {x[i], y[i]};
+      EXPECT_DOUBLE_EQ(f.EvalPar(point, params2), result[i]);
+   }
+
+   // not enough coordinates
+   EXPECT_FALSE(f.EvalParBatch(n, 1, coords, nullptr, result.data()));
+}
+
+// A fit with a formula (batch evaluation) and with the same function written
+// in C++ (point by point evaluation) must agree
+TEST(TFormula, FitBatch)
+{
+   TH1D h("h", "h", 100, -5., 5.);
+   for (Int_t i = 1; i <= h.GetNbinsX(); ++i) {
+      const Double_t x = h.GetBinCenter(i);
+      h.SetBinContent(i, 1000. * std::exp(-0.5 * (x - 0.3) * (x - 0.3)) + 10.);
+      h.SetBinError(i, std::sqrt(h.GetBinContent(i)));
+   }
+
+   TF1 fFormula("fFormula", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]", -5., 5.);
+   TF1 fCode("fCode",
+             [](double *x, double *p) { return p[0] * std::exp(-0.5 * std::pow((x[0] - p[1]) / p[2], 2)) + p[3]; },
+             -5., 5., 4);
+   for (TF1 *f : {&fFormula, &fCode})
+      f->SetParameters(900., 0., 1.2, 5.);
+
+   for (const char *opt : {"Q N S", "Q N S L"}) {
+      TFitResultPtr rFormula = h.Fit(&fFormula, opt);
+      TFitResultPtr rCode = h.Fit(&fCode, opt);
+      ASSERT_EQ(rFormula->Status(), 0);
+      ASSERT_EQ(rCode->Status(), 0);
+      for (Int_t ipar = 0; ipar < 4; ++ipar)
+         EXPECT_NEAR(rFormula->Parameter(ipar), rCode->Parameter(ipar), 1e-6 * (1. + std::abs(rCode->Parameter(ipar))));
+      EXPECT_NEAR(rFormula->MinFcnValue(), rCode->MinFcnValue(), 1e-6 * (1. + rCode->MinFcnValue()));
+   }
+}
@@ -2,6 +2,13 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TH3D.h"
+#include "TProfile.h"
+
+#include <cmath>
+#include <vector>
 
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
@@ -30,3 +37,80 @@ TEST(TH1, StatOverflows)
    EXPECT_EQ(TH1::EStatOverflows::kConsider, h1.GetStatOverflows());
    EXPECT_EQ(TH1::EStatOverflows::kNeutral,  h2.GetStatOverflows());
 }
+
+// FillN must give the same result as Fill entry by entry
+namespace {
+void FillTestValues(std::vector<double> &v, double lo, double hi, unsigned seed)
+{
+   // Include under/overflows, exact bin edges and a NaN
+   for (std::size_t i = 0; i < v.size(); ++i) {
+      seed = seed * 1664525u + 1013904223u;
+      v[i] = lo - 1. + (hi - lo + 2.) * (seed >> 8) / double(1u << 24);
+   }
+   v[0] = lo;
+   v[1] = hi;
+   v[2] = std::nan("");
+}
+
+void ExpectSameFill(const TH1 &h1, const TH1 &h2)
+{
+   ASSERT_EQ(h1.GetNcells(), h2.GetNcells());
+   EXPECT_EQ(h1.GetEntries(), h2.GetEntries());
+   EXPECT_EQ(h1.GetSumw2N(), h2.GetSumw2N());
+   for (Int_t bin = 0; bin < h1.GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(h1.GetBinContent(bin), h2.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(h1.GetBinError(bin), h2.GetBinError(bin)) << "bin " << bin;
+   }
+   Double_t s1[TH1::kNstat], s2[TH1::kNstat];
+   h1.GetStats(s1);
+   h2.GetStats(s2);
+   for (Int_t i = 0; i < TH1::kNstat; ++i)
+      EXPECT_NEAR(s1[i], s2[i], 1e-9 * (1. + std::abs(s1[i]))) << "stat " << i;
+}
+} // namespace
+
+TEST(TH1, FillN)
+{
+   const Int_t n = 1000;
+   std::vector<double> x(n), y(n), z(n), w(n);
+   FillTestValues(x, -2., 2., 1);
+   FillTestValues(y, 0., 5., 2);
+   FillTestValues(z, -1., 1., 3);
+   FillTestValues(w, 0.5, 1.5, 4);
+   w[2] = 2.;
+   const Double_t edges[] = {-2., -1.5, -0.2, 0., 0.1, 1., 2.};
+
+   for (bool weighted : {false, true}) {
+      const Double_t *pw = weighted ? w.data() : nullptr;
+      auto weight = [&](Int_t i) { return weighted ? w[i] : 1.; };
+
+      TH1D h1("h1", "h1", 20, -2., 2.), h1n("h1n", "h1n", 20, -2., 2.);
+      TH1D v1("v1", "v1", 6, edges), v1n("v1n", "v1n", 6, edges);
+      for (Int_t i = 0; i < n; ++i) {
+         h1.Fill(x[i], weight(i));
+         v1.Fill(x[i], weight(i));
+      }
+      h1n.FillN(n, x.data(), pw);
+      v1n.FillN(n, x.data(), pw);
+      ExpectSameFill(h1, h1n);
+      ExpectSameFill(v1, v1n);
+
+      TH2D h2("h2", "h2", 6, edges, 7, 0., 5.), h2n("h2n", "h2n", 6, edges, 7, 0., 5.);
+      for (Int_t i = 0; i < n; ++i)
+         h2.Fill(x[i], y[i], weight(i));
+      h2n.FillN(n, x.data(), y.data(), pw);
+      ExpectSameFill(h2, h2n);
+
+      TH3D h3("h3", "h3", 5, -2., 2., 4, 0., 5., 3, -1., 1.), h3n("h3n", "h3n", 5, -2., 2., 4, 0., 5., 3, -1., 1.);
+      for (Int_t i = 0; i < n; ++i)
+         h3.Fill(x[i], y[i], z[i], weight(i));
+      h3n.FillN(n, x.data(), y.data(), z.data(), pw);
+      ExpectSameFill(h3, h3n);
+
+      TProfile p("p", "p", 6, edges, 1., 4.), pn("pn", "pn", 6, edges, 1., 4.);
+      for (Int_t i = 0; i < n; ++i)
+         p.Fill(x[i], y[i], weight(i));
+      pn.FillN(n, x.data(), y.data(), pw);
+      ExpectSameFill(p, pn);
+   }
+}
@@ -0,0 +1,191 @@
+#include "gtest/gtest.h"
+
+#include "TH1ConcurrentFiller.h"
+#include "TH1D.h"
+#include "TH2Poly.h"
+#include "TH3D.h"
+#include "TProfile.h"
+#include "TRandom3.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int kNThreads = 4;
+const int kNPerThread = 20000;
+
+// Fill the same values sequentially and concurrently and compare.
+// Weights are powers of two so that the bin contents are exact whatever the order of the additions.
+void Compare1D(TH1ConcurrentFiller::EMode mode, Int_t nbins, bool weighted)
+{
+   TH1D ref("ref", "ref", nbins, -3, 3);
+   TH1D h("h", "h", nbins, -3, 3);
+   std::vector<std::vector<std::pair<Double_t, Double_t>>> values(kNThreads);
+   for (int t = 0; t < kNThreads; ++t) {
+      TRandom3 rnd(t + 1);
+      for (int i = 0; i < kNPerThread; ++i) {
+         const Double_t w = weighted ? (i % 3 == 0 ? 0.5 : 2.) : 1.;
+         values[t].emplace_back(rnd.Gaus(0, 1), w);
+         if (weighted)
+            ref.Fill(values[t].back().first, w);
+         else
+            ref.Fill(values[t].back().first);
+      }
+   }
+
+   {
+      TH1ConcurrentFiller filler(h, mode);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < kNThreads; ++t) {
+         threads.emplace_back([&filler, &values, t, weighted]() {
+            for (auto &xw : values[t]) {
+               if (weighted)
+                  filler.Fill(xw.first, xw.second);
+               else
+                  filler.Fill(xw.first);
+            }
+         });
+      }
+      for (auto &thread : threads)
+         thread.join();
+   }
+
+   EXPECT_EQ(ref.GetEntries(), h.GetEntries());
+   EXPECT_EQ(ref.GetSumw2N(), h.GetSumw2N());
+   for (Int_t bin = 0; bin < ref.GetNcells(); ++bin) {
+      EXPECT_EQ(ref.GetBinContent(bin), h.GetBinContent(bin));
+      EXPECT_EQ(ref.GetBinError(bin), h.GetBinError(bin));
+   }
+   EXPECT_NEAR(ref.GetMean(), h.GetMean(), 1e-10);
+   EXPECT_NEAR(ref.GetStdDev(), h.GetStdDev(), 1e-10);
+   EXPECT_NEAR(ref.GetEffectiveEntries(), h.GetEffectiveEntries(), 1e-6);
+}
+
+} // anonymous namespace
+
+TEST(TH1ConcurrentFiller, AutoMode)
+{
+   TH1D small("small", "small", 100, 0, 1);
+   TH3D big("big", "big", 100, 0, 1, 100, 0, 1, 100, 0, 1);
+   TH1ConcurrentFiller fillSmall(small);
+   TH1ConcurrentFiller fillBig(big);
+   EXPECT_EQ(TH1ConcurrentFiller::kAtomic, fillSmall.GetMode());
+   EXPECT_EQ(TH1ConcurrentFiller::kSharded, fillBig.GetMode());
+}
+
+TEST(TH1ConcurrentFiller, Atomic)
+{
+   Compare1D(TH1ConcurrentFiller::kAtomic, 50, false);
+   Compare1D(TH1ConcurrentFiller::kAtomic, 50, true);
+}
+
+TEST(TH1ConcurrentFiller, Sharded)
+{
+   // More cells than a block, with a partially filled last block.
+   Compare1D(TH1ConcurrentFiller::kSharded, 3 * TH1ConcurrentFiller::kBlockSize + 10, false);
+   Compare1D(TH1ConcurrentFiller::kSharded, 3 * TH1ConcurrentFiller::kBlockSize + 10, true);
+}
+
+TEST(TH1ConcurrentFiller, ThreeDimensions)
+{
+   TH3D ref("ref3", "ref3", 40, -3, 3, 40, -3, 3, 40, -3, 3);
+   TH3D h("h3", "h3", 40, -3, 3, 40, -3, 3, 40, -3, 3);
+   {
+      TH1ConcurrentFiller filler(h);
+      ASSERT_EQ(TH1ConcurrentFiller::kSharded, filler.GetMode());
+      std::vector<std::thread> threads;
+      for (int t = 0; t < kNThreads; ++t) {
+         threads.emplace_back([&filler, t]() {
+            TRandom3 rnd(t + 1);
+            for (int i = 0; i < kNPerThread; ++i) {
+               const Double_t x = rnd.Gaus(0, 1);
+               const Double_t y = rnd.Gaus(0, 1);
+               const Double_t z = rnd.Gaus(0, 1);
+               filler.Fill(x, y, z);
+            }
+         });
+      }
+      for (auto &thread : threads)
+         thread.join();
+   }
+   for (int t = 0; t < kNThreads; ++t) {
+      TRandom3 rnd(t + 1);
+      for (int i = 0; i < kNPerThread; ++i) {
+         // Same order of the draws as in the threads above.
+         const Double_t x = rnd.Gaus(0, 1);
+         const Double_t y = rnd.Gaus(0, 1);
+         const Double_t z = rnd.Gaus(0, 1);
+         ref.Fill(x, y, z);
+      }
+   }
+
+   EXPECT_EQ(ref.GetEntries(), h.GetEntries());
+   for (Int_t bin = 0; bin < ref.GetNcells(); ++bin)
+      ASSERT_EQ(ref.GetBinContent(bin), h.GetBinContent(bin));
+   for (int axis = 1; axis <= 3; ++axis) {
+      EXPECT_NEAR(ref.GetMean(axis), h.GetMean(axis), 1e-10);
+      EXPECT_NEAR(ref.GetStdDev(axis), h.GetStdDev(axis), 1e-10);
+   }
+   EXPECT_NEAR(ref.GetCovariance(1, 2), h.GetCovariance(1, 2), 1e-10);
+}
+
+TEST(TH1ConcurrentFiller, ShardedLateWeights)
+{
+   // Unit weights first, then a weight that requires the sums of squares of the block.
+   TH1D ref("reflate", "reflate", 10, 0, 10);
+   TH1D h("hlate", "hlate", 10, 0, 10);
+   {
+      TH1ConcurrentFiller filler(h, TH1ConcurrentFiller::kSharded);
+      for (int i = 0; i < 3; ++i) {
+         ref.Fill(1.5);
+         filler.Fill(1.5);
+      }
+      ref.Fill(1.5, 2.);
+      filler.Fill(1.5, 2.);
+      ref.Fill(4.5);
+      filler.Fill(4.5);
+   }
+   for (Int_t bin = 0; bin < ref.GetNcells(); ++bin) {
+      EXPECT_EQ(ref.GetBinContent(bin), h.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(ref.GetBinError(bin), h.GetBinError(bin));
+   }
+}
+
+TEST(TH1ConcurrentFiller, RejectProfile)
+{
+   TProfile p("prof", "prof", 10, 0, 10);
+   {
+      TH1ConcurrentFiller filler(p);
+      EXPECT_EQ(-1, filler.Fill(1.5, 2.));
+   }
+   EXPECT_EQ(0, p.GetEntries());
+}
+
+TEST(TH1ConcurrentFiller, RejectTH2Poly)
+{
+   TH2Poly poly("poly", "poly", 0, 10, 0, 10);
+   poly.AddBin(0, 0, 5, 5);
+   {
+      TH1ConcurrentFiller filler(poly);
+      EXPECT_EQ(-1, filler.Fill(1.5, 2.5));
+   }
+   EXPECT_EQ(0, poly.GetEntries());
+   EXPECT_EQ(0, poly.GetBinContent(1));
+}
+
+TEST(TH1ConcurrentFiller, FlushAndReuse)
+{
+   TH1D h("hreuse", "hreuse", 10, 0, 10);
+   TH1ConcurrentFiller filler(h);
+   filler.Fill(1.5);
+   filler.Flush();
+   EXPECT_EQ(1, h.GetEntries());
+   EXPECT_EQ(1, h.GetBinContent(2));
+   filler.Fill(2.5, 2.);
+   filler.Flush();
+   EXPECT_EQ(2, h.GetEntries());
+   EXPECT_EQ(2, h.GetBinContent(3));
+   EXPECT_DOUBLE_EQ(2., h.GetBinError(3));
+   EXPECT_DOUBLE_EQ(1., h.GetBinError(2));
+}
@@ -8,13 +8,16 @@
 #include <vector>
 #include <chrono>
 #include <iostream>
+#include <thread>
 
 #include "TH1.h"
 #include "TH2.h"
 #include "TH3.h"
+#include "TH1ConcurrentFiller.h"
 
 #include "ROOT/RHist.hxx"
 #include "ROOT/RHistBufferedFill.hxx"
+#include "ROOT/RHistConcurrentFill.hxx"
 
 using namespace ROOT;
 using namespace std;
@@ -737,6 +740,134 @@ void speedtest<float, 1>(size_t count)
    R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
 }
 
+namespace Concurrent {
+
+unsigned GetNThreads()
+{
+   const unsigned n = std::thread::hardware_concurrency();
+   return n ? n : 4;
+}
+
+// Run fill(begin, end) on consecutive slices of the input, one per thread.
+template <typename FILL>
+void RunThreads(std::vector<double> &input, size_t stride, FILL fill)
+{
+   const unsigned nThreads = GetNThreads();
+   const size_t nEntries = input.size() / stride;
+   std::vector<std::thread> threads;
+   for (unsigned t = 0; t < nThreads; ++t) {
+      const size_t begin = nEntries * t / nThreads * stride;
+      const size_t end = nEntries * (t + 1) / nThreads * stride;
+      threads.emplace_back([&fill, begin, end]() { fill(begin, end); });
+   }
+   for (auto &thread : threads)
+      thread.join();
+}
+
+std::string MakeConcurrentTitle(std::string_view version, std::string_view histname, std::string_view title)
+{
+   return MakeTitle(version, histname, title, std::to_string(GetNThreads()) + " threads");
+}
+
+// R7: each thread buffers its entries and hands them to the histogram under a lock.
+long fill1D7(std::vector<double> &input, int nbins, double minVal, double maxVal)
+{
+   using Hist_t = Experimental::RHist<1, double, STATCLASSES>;
+   Hist_t hist({nbins, minVal, maxVal});
+   Experimental::RHistConcurrentFillManager<Hist_t> manager(hist);
+   std::string title = MakeConcurrentTitle(R7::gVersion, "1D", "concurrent fills   ");
+   {
+      Timer t(title.c_str(), input.size());
+      RunThreads(input, 1, [&](size_t begin, size_t end) {
+         auto filler = manager.MakeFiller();
+         for (size_t i = begin; i < end; ++i)
+            filler.Fill({input[i]});
+      });
+   }
+   return hist.GetNDim();
+}
+
+long fill2D7(std::vector<double> &input, int nbins, double minVal, double maxVal)
+{
+   using Hist_t = Experimental::RHist<2, double, STATCLASSES>;
+   Hist_t hist({nbins, minVal, maxVal}, {nbins, minVal, maxVal});
+   Experimental::RHistConcurrentFillManager<Hist_t> manager(hist);
+   std::string title = MakeConcurrentTitle(R7::gVersion, "2D", "concurrent fills   ");
+   {
+      Timer t(title.c_str(), input.size() / 2);
+      RunThreads(input, 2, [&](size_t begin, size_t end) {
+         auto filler = manager.MakeFiller();
+         for (size_t i = begin; i < end; i += 2)
+            filler.Fill({input[i], input[i + 1]});
+      });
+   }
+   return hist.GetNDim();
+}
+
+// R6: all threads fill the same histogram through a TH1ConcurrentFiller.
+long fill1D6(std::vector<double> &input, int nbins, double minVal, double maxVal)
+{
+   TH1D hist("a", "a hist", nbins, minVal, maxVal);
+   std::string title = MakeConcurrentTitle(R6::gVersion, "1D", "concurrent fills   ");
+   {
+      Timer t(title.c_str(), input.size());
+      TH1ConcurrentFiller filler(hist);
+      RunThreads(input, 1, [&](size_t begin, size_t end) {
+         for (size_t i = begin; i < end; ++i)
+            filler.Fill(input[i]);
+      });
+   }
+   return (long)hist.GetEntries();
+}
+
+long fill2D6(std::vector<double> &input, int nbins, double minVal, double maxVal)
+{
+   TH2D hist("a", "a hist", nbins, minVal, maxVal, nbins, minVal, maxVal);
+   std::string title = MakeConcurrentTitle(R6::gVersion, "2D", "concurrent fills   ");
+   {
+      Timer t(title.c_str(), input.size() / 2);
+      TH1ConcurrentFiller filler(hist);
+      RunThreads(input, 2, [&](size_t begin, size_t end) {
+         for (size_t i = begin; i < end; i += 2)
+            filler.Fill(input[i], input[i + 1]);
+      });
+   }
+   return (long)hist.GetEntries();
+}
+
+} // namespace Concurrent
+
+// Compare RHistConcurrentFillManager with TH1ConcurrentFiller: a small
+// histogram (filled atomically by TH1ConcurrentFiller) and a big one (filled
+// through per-thread blocks).
+void concurrentspeedtest(size_t count)
+{
+   TH1::AddDirectory(kFALSE);
+
+   std::vector<double> input;
+   input.resize(count);
+
+   double minVal = -5.0;
+   double maxVal = +5.0;
+   GenerateInput(input, minVal, maxVal, 0);
+
+   // Make sure we have some overflow.
+   minVal *= 0.9;
+   maxVal *= 0.9;
+
+   for (int nbins : {100, 1000}) {
+      cout << '\n' << nbins << " bins per axis\n";
+      for (unsigned short i = 0; i < gRepeat; ++i)
+         Concurrent::fill1D7(input, nbins, minVal, maxVal);
+      for (unsigned short i = 0; i < gRepeat; ++i)
+         Concurrent::fill1D6(input, nbins, minVal, maxVal);
+      for (unsigned short i = 0; i < gRepeat; ++i)
+         Concurrent::fill2D7(input, nbins, minVal, maxVal);
+      for (unsigned short i = 0; i < gRepeat; ++i)
+         Concurrent::fill2D6(input, nbins, minVal, maxVal);
+   }
+}
+
 void histspeedtest(size_t iter = 1e6, int what = 255)
 {
    if (what & 1)
@@ -747,13 +878,15 @@ void histspeedtest(size_t iter = 1e6, int what = 255)
       speedtest<double, 1>(iter);
    if (what & 8)
       speedtest<float, 1>(iter);
+   if (what & 16)
+      concurrentspeedtest(iter);
 }
 
 int main(int argc, char **argv)
 {
 
    size_t iter = 1e7;
-   int what = 1 | 2 | 4 | 8;
+   int what = 1 | 2 | 4 | 8 | 16;
    if (argc > 1)
       iter = atof(argv[1]);
    if (argc > 2)
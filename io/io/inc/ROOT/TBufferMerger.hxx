@@ -15,6 +15,7 @@
 #include "TFileMerger.h"
 #include "TMemFile.h"
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -83,6 +84,32 @@ public:
     */
    void SetAutoSave(size_t size);
 
+   /** Returns the maximum number of buffers in the queue (default = 0, unbounded). */
+   size_t GetMaxQueueSize() const;
+
+   /** Bound the merge queue to @param size buffers (0 means unbounded).
+    *  When a TBufferMergerFile::Write() fills the queue, the writing thread
+    *  waits for the merge in progress, if any, and then merges the queue
+    *  itself before returning. This applies backpressure on the writers and
+    *  bounds the memory used by the buffers waiting to be merged.
+    */
+   void SetMaxQueueSize(size_t size);
+
+   /** Returns the largest number of buffers that were in the queue at once. */
+   size_t GetPeakQueueSize() const;
+
+   /** Returns the number of writes that were held back because the queue was full. */
+   size_t GetNBlockedWrites() const;
+
+   /** Returns the number of buffers merged into the output file so far. */
+   size_t GetNMergedBuffers() const;
+
+   /** Returns the number of bytes of the buffers merged into the output file so far. */
+   size_t GetMergedBytes() const;
+
+   /** Returns the total time spent merging, in seconds. */
+   double GetMergeTime() const;
+
    friend class TBufferMergerFile;
 
 private:
@@ -97,11 +124,17 @@ private:
 
    void Init(std::unique_ptr<TFile>);
 
-   void Merge();
+   void Merge(bool wait = false);
    void Push(TBufferFile *buffer);
 
    size_t fAutoSave{0};                                          //< AutoSave only every fAutoSave bytes
    size_t fBuffered{0};                                          //< Number of bytes currently buffered
+   size_t fMaxQueueSize{0};                                      //< Maximum number of buffers in fQueue (0: unbounded)
+   std::atomic<size_t> fPeakQueueSize{0};                        //< Largest number of buffers seen in fQueue
+   std::atomic<size_t> fNBlockedWrites{0};                       //< Number of pushes that found fQueue full
+   std::atomic<size_t> fNMergedBuffers{0};                       //< Number of buffers merged so far
+   std::atomic<size_t> fMergedBytes{0};                          //< Number of bytes merged so far
+   std::atomic<double> fMergeTime{0.};                           //< Time spent merging, in seconds
    TFileMerger fMerger{false, false};                            //< TFileMerger used to merge all buffers
    std::mutex fMergeMutex;                                       //< Mutex used to lock fMerger
    std::mutex fQueueMutex;                                       //< Mutex used to lock fQueue
@@ -106,6 +106,9 @@ protected:
    TList           *fInfoCache;      ///<!Cached list of the streamer infos in this file
    TList           *fOpenPhases;     ///<!Time info about open phases
 
+   char            *fMapBegin{nullptr}; ///<!Start of the read-only memory mapping of the file (if any)
+   Long64_t         fMapSize{0};        ///<!Size of the memory mapping
+
 #ifdef R__USE_IMT
    static ROOT::TRWSpinLock                   fgRwLock;     ///<!Read-write lock to protect global PID list
    std::mutex                                 fWriteMutex;  ///<!Lock for writing baskets / keys into the file.
@@ -130,6 +133,9 @@ protected:
    virtual void  Init(Bool_t create);
    Bool_t                    FlushWriteCache();
    Int_t                     ReadBufferViaCache(char *buf, Int_t len);
+   Bool_t                    ReadBufferViaMap(char *buf, Int_t len);
+   Bool_t                    MapFile();
+   void                      UnmapFile();
    Int_t                     WriteBufferViaCache(const char *buf, Int_t len);
    std::pair<TList *, Int_t> GetStreamerInfoListImpl(bool readSI);
 
@@ -206,6 +212,7 @@ public:
    virtual Int_t       GetErrno() const;
    virtual void        ResetErrno() const;
    Int_t               GetFd() const { return fD; }
+   const char         *GetMappedBuffer(Long64_t pos, Int_t len);
    virtual const TUrl *GetEndpointUrl() const { return &fUrl; }
    TObjArray          *GetListOfProcessIDs() const {return fProcessIDs;}
    TList              *GetListOfFree() const { return fFree; }
@@ -244,6 +251,9 @@ public:
    virtual void        Paint(Option_t *option="");
    virtual void        Print(Option_t *option="") const;
    virtual Bool_t      ReadBufferAsync(Long64_t offs, Int_t len);
+           Bool_t      IsMapped() const { return fMapBegin != nullptr; }
+           Bool_t      IsMapped(Long64_t pos, Int_t len) const
+                       { return fMapBegin && pos >= 0 && pos + fArchiveOffset + len <= fMapSize; }
    virtual Bool_t      ReadBuffer(char *buf, Int_t len);
    virtual Bool_t      ReadBuffer(char *buf, Long64_t pos, Int_t len);
    virtual Bool_t      ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
@@ -23,6 +23,8 @@ class TFileCacheRead : public TObject {
 
 protected:
    TFilePrefetch *fPrefetch;         ///<! Object that does the asynchronous reading in another thread
+   TFilePrefetch *fReadAhead;        ///<! Object reading upcoming blocks in another thread while fBuffer is used
+   Long64_t       fReadAheadHits;    ///<! Number of blocks found in the read-ahead buffers
    Int_t          fBufferSizeMin;    ///< Original size of fBuffer
    Int_t          fBufferSize;       ///< Allocated size of fBuffer (at a given time)
    Int_t          fBufferLen;        ///< Current buffer length (<= fBufferSize)
@@ -71,6 +73,7 @@ protected:
    Bool_t         fBIsTransferred;
 
    void SetEnablePrefetchingImpl(Bool_t setPrefetching = kFALSE); // Can not be virtual as it is called from the constructor.
+   Bool_t ReadBuffersWithReadAhead();
 
 private:
    TFileCacheRead(const TFileCacheRead &);            //cannot be copied
@@ -96,10 +99,12 @@ public:
    virtual Int_t       GetNoCacheReadCalls() const { return fNoCacheReadCalls; }
    virtual Int_t       GetUnzipBuffer(char ** /*buf*/, Long64_t /*pos*/, Int_t /*len*/, Bool_t * /*free*/) { return -1; }
            Long64_t    GetPrefetchedBlocks() const { return fPrefetchedBlocks; }
+           Long64_t    GetReadAheadHits() const { return fReadAheadHits; }
    virtual Bool_t      IsAsyncReading() const { return fAsyncReading; };
    virtual void        SetEnablePrefetching(Bool_t setPrefetching = kFALSE);
    virtual Bool_t      IsEnablePrefetching() const { return fEnablePrefetching; };
    virtual Bool_t      IsLearning() const {return kFALSE;}
+           Bool_t      IsReadAhead() const { return fReadAhead != 0; }
    virtual void        Prefetch(Long64_t pos, Int_t len);
    virtual void        Print(Option_t *option="") const;
    virtual Int_t       ReadBufferExt(char *buf, Long64_t pos, Int_t len, Int_t &loc);
@@ -108,6 +113,7 @@ public:
    virtual Int_t       ReadBuffer(char *buf, Long64_t pos, Int_t len);
    virtual Int_t       SetBufferSize(Int_t buffersize);
    virtual void        SetFile(TFile *file, TFile::ECacheAction action = TFile::kDisconnect);
+   virtual void        SetReadAhead(Int_t nblocks);
    virtual void        SetSkipZip(Bool_t /*skip*/ = kTRUE) {} // This function is only used by TTreeCacheUnzip (ignore it)
    virtual void        Sort();
    virtual void        SecondSort();                          //Method used to sort and merge the chunks in the second block
@@ -18,6 +18,7 @@
 #include "TStopwatch.h"
 
 #include <memory>
+#include <vector>
 
 class TList;
 class TFile;
@@ -43,6 +44,7 @@ protected:
    Bool_t         fNoTrees{kFALSE};           ///< True if Trees should not be merged (default is kFALSE)
    Bool_t         fExplicitCompLevel{kFALSE}; ///< True if the user explicitly requested a compressio level change (default kFALSE)
    Bool_t         fCompressionChange{kFALSE}; ///< True if the output and input have different compression level (default kFALSE)
+   Bool_t         fRecompressBaskets{kFALSE}; ///< True if TTree baskets are recompressed, rather than unstreamed, when the compression changes (default kFALSE)
    Int_t          fPrintLevel{0};             ///< How much information to print out at run time
    TString        fMergeOptions;              ///< Options (in string format) to be passed down to the Merge functions
    TIOFeatures   *fIOFeatures{nullptr};       ///< IO features to use in the output file.
@@ -114,10 +116,13 @@ public:
    virtual Bool_t Merge(Bool_t = kTRUE);
    virtual Bool_t PartialMerge(Int_t type = kAll | kIncremental);
    virtual void   SetFastMethod(Bool_t fast=kTRUE)  {fFastMethod = fast;}
+   virtual void   SetRecompressBaskets(Bool_t recompress=kTRUE) {fRecompressBaskets = recompress;}
    virtual void   SetNotrees(Bool_t notrees=kFALSE) {fNoTrees = notrees;}
    virtual void        RecursiveRemove(TObject *obj);
 
-   ClassDef(TFileMerger, 6)  // File copying and merging services
+   static std::vector<TFile *> OpenFiles(const std::vector<TString> &urls, UInt_t nthreads);
+
+   ClassDef(TFileMerger, 7)  // File copying and merging services
 };
 
 #endif
@@ -44,6 +44,11 @@ private:
    TStopwatch  fWaitTime;          // time wating to prefetch a buffer (in usec)
    Bool_t      fThreadJoined;      // mark if async thread was joined
    std::atomic<Bool_t> fPrefetchFinished;  // true if prefetching is over
+   Int_t       fMaxReadBlocks;     // maximum number of blocks kept in the read list
+   TFPBlock   *fInFlightBlock;     // block currently transferred by the consumer thread
+
+   Bool_t    IsRequested(Long64_t, Int_t);
+   Bool_t    CopyFromReadList(char*, Long64_t, Int_t);
 
    static TThread::VoidRtnFunc_t ThreadProc(void*);  //create a joinable worker thread
 
@@ -59,6 +64,7 @@ public:
 
    void      AddReadBlock(TFPBlock*);
    Bool_t    ReadBuffer(char*, Long64_t, Int_t);
+   Bool_t    ReadBufferIfRequested(char*, Long64_t, Int_t);
    void      ReadBlock(Long64_t*, Int_t*, Int_t);
    TFPBlock *CreateBlockObj(Long64_t*, Int_t*, Int_t);
 
@@ -78,6 +84,8 @@ public:
    std::condition_variable &GetCondNewBlock() { return fNewBlockAdded; };
    void      WaitFinishPrefetch();
    Bool_t    IsPrefetchFinished() const { return fPrefetchFinished; }
+   Int_t     GetMaxReadBlocks() const { return fMaxReadBlocks; }
+   void      SetMaxReadBlocks(Int_t n);
 
    ClassDef(TFilePrefetch, 0);  // File block prefetcher
 };
@@ -16,6 +16,7 @@
 #include "TROOT.h"
 #include "TVirtualMutex.h"
 
+#include <chrono>
 #include <utility>
 
 namespace ROOT {
@@ -67,13 +68,22 @@ size_t TBufferMerger::GetQueueSize() const
 
 void TBufferMerger::Push(TBufferFile *buffer)
 {
+   bool full = false;
    {
       std::lock_guard<std::mutex> lock(fQueueMutex);
       fBuffered += buffer->BufferSize();
       fQueue.push(buffer);
+      if (fQueue.size() > fPeakQueueSize)
+         fPeakQueueSize = fQueue.size();
+      full = fMaxQueueSize && fQueue.size() >= fMaxQueueSize;
    }
 
-   if (fBuffered > fAutoSave)
+   if (full) {
+      // The merging does not keep up with the writers: hold this one back
+      // until the queue has been merged, rather than letting it grow.
+      ++fNBlockedWrites;
+      Merge(true);
+   } else if (fBuffered > fAutoSave)
       Merge();
 }
 
@@ -87,27 +97,83 @@ void TBufferMerger::SetAutoSave(size_t size)
    fAutoSave = size;
 }
 
-void TBufferMerger::Merge()
+size_t TBufferMerger::GetMaxQueueSize() const
 {
-   if (fMergeMutex.try_lock()) {
-      std::queue<TBufferFile *> queue;
-      {
-         std::lock_guard<std::mutex> q(fQueueMutex);
-         std::swap(queue, fQueue);
-         fBuffered = 0;
-      }
+   return fMaxQueueSize;
+}
+
+void TBufferMerger::SetMaxQueueSize(size_t size)
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   fMaxQueueSize = size;
+}
+
+size_t TBufferMerger::GetPeakQueueSize() const
+{
+   return fPeakQueueSize;
+}
+
+size_t TBufferMerger::GetNBlockedWrites() const
+{
+   return fNBlockedWrites;
+}
+
+size_t TBufferMerger::GetNMergedBuffers() const
+{
+   return fNMergedBuffers;
+}
+
+size_t TBufferMerger::GetMergedBytes() const
+{
+   return fMergedBytes;
+}
+
+double TBufferMerger::GetMergeTime() const
+{
+   return fMergeTime;
+}
+
+void TBufferMerger::Merge(bool wait)
+{
+   if (wait)
+      fMergeMutex.lock();
+   else if (!fMergeMutex.try_lock())
+      return;
+
+   auto start = std::chrono::steady_clock::now();
+
+   std::queue<TBufferFile *> queue;
+   {
+      std::lock_guard<std::mutex> q(fQueueMutex);
+      std::swap(queue, fQueue);
+      fBuffered = 0;
+   }
+
+   if (!queue.empty()) {
+      size_t nbuffers = queue.size();
+      size_t nbytes = 0;
 
       while (!queue.empty()) {
          std::unique_ptr<TBufferFile> buffer{queue.front()};
+         nbytes += buffer->BufferSize();
          fMerger.AddAdoptFile(
             new TMemFile(fMerger.GetOutputFileName(), buffer->Buffer(), buffer->BufferSize(), "READ"));
          queue.pop();
       }
 
-      fMerger.PartialMerge();
+      // The TBufferMergerFiles use the compression settings of the output
+      // file, so their baskets can be copied as they are, without being
+      // decompressed and compressed again.
+      fMerger.PartialMerge(TFileMerger::kAllIncremental | TFileMerger::kKeepCompression);
       fMerger.Reset();
-      fMergeMutex.unlock();
+
+      fNMergedBuffers += nbuffers;
+      fMergedBytes += nbytes;
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      fMergeTime.store(fMergeTime.load() + elapsed.count());
    }
+
+   fMergeMutex.unlock();
 }
 
 } // namespace Experimental
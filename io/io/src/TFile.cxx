@@ -84,6 +84,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include <sys/stat.h>
 #ifndef WIN32
 #   include <unistd.h>
+#   include <sys/mman.h>
 #else
 #   define ssize_t int
 #   include <io.h>
@@ -265,6 +266,15 @@ TFile::TFile() : TDirectoryFile(), fInfoCache(0)
 ///
 /// This is convenient because the many remote file access plugins allow
 /// easy access to/from the many different mass storage systems.
+/// A local file opened for reading can be memory-mapped, using:
+///
+///     file.root?mmap=1
+///
+/// or for all local files by setting the rootrc variable TFile.MemoryMap
+/// to 1. Reads are then served from the mapping without system calls and
+/// compressed baskets are decompressed straight from the mapped pages,
+/// which are shared with all the processes reading the same file. The
+/// file must not be truncated while it is mapped.
 /// The title of the file (ftitle) will be shown by the ROOT browsers.
 /// A ROOT file (like a Unix file system) may contain objects and
 /// directories. There are no restrictions for the number of levels
@@ -300,6 +310,7 @@ TFile::TFile() : TDirectoryFile(), fInfoCache(0)
 /// will build an integer which will set the compression to use
 /// the LZMA algorithm and compression level 1.  These are defined
 /// in the header file <em>Compression.h</em>.
+/// ROOT::kZSTD (Zstandard) is available if ROOT was built with ZSTD support.
 /// Note that the compression settings may be changed at any time.
 /// The new compression settings will only apply to branches created
 /// or attached after the setting is changed and other objects written
@@ -517,6 +528,7 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
          goto zombie;
       }
       fWritable = kFALSE;
+      MapFile();
    }
 
    Init(create);
@@ -547,6 +559,7 @@ TFile::TFile(const TFile &) : TDirectoryFile(), fInfoCache(0)
 TFile::~TFile()
 {
    Close();
+   UnmapFile();
 
    // In case where the TFile is still open at 'tear-down' time the order of operation will be
    // call Close("nodelete")
@@ -924,6 +937,7 @@ void TFile::Close(Option_t *option)
 
    if (fIsArchive || !fIsRootFile) {
       FlushWriteCache();
+      UnmapFile();
       SysClose(fD);
       fD = -1;
 
@@ -979,6 +993,7 @@ void TFile::Close(Option_t *option)
    }
 
    if (IsOpen()) {
+      UnmapFile();
       SysClose(fD);
       fD = -1;
    }
@@ -1636,6 +1651,12 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
          return kFALSE;
       }
 
+      if (fMapBegin) {
+         fOffset = pos + fArchiveOffset;
+         if (ReadBufferViaMap(buf, len))
+            return kFALSE;
+      }
+
       Seek(pos);
       ssize_t siz;
 
@@ -1681,6 +1702,14 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
          return kFALSE;
       }
 
+      if (fMapBegin) {
+         if (ReadBufferViaMap(buf, len))
+            return kFALSE;
+         // Beyond the mapping: the descriptor offset does not follow the
+         // mapped reads, bring it to the current position.
+         SysSeek(fD, fOffset, SEEK_SET);
+      }
+
       ssize_t siz;
       Double_t start = 0;
 
@@ -1733,6 +1762,22 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   if (fMapBegin) {
+      // Copy straight from the mapping if all the blocks are in it.
+      Int_t j = 0;
+      while (j < nbuf && pos[j] >= 0 && pos[j] + fArchiveOffset + len[j] <= fMapSize)
+         j++;
+      if (j == nbuf) {
+         Int_t k = 0;
+         for (j = 0; j < nbuf; j++) {
+            fOffset = pos[j] + fArchiveOffset;
+            ReadBufferViaMap(&buf[k], len[j]);
+            k += len[j];
+         }
+         return kFALSE;
+      }
+   }
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -1783,6 +1828,107 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read len bytes at the current offset from the memory mapping of the file.
+///
+/// Returns kFALSE if the file is not mapped or if the requested block is
+/// not entirely within the mapping, in which case nothing is read.
+
+Bool_t TFile::ReadBufferViaMap(char *buf, Int_t len)
+{
+   if (!fMapBegin || fOffset < 0 || fOffset + len > fMapSize)
+      return kFALSE;
+
+   Double_t start = 0;
+   if (gPerfStats != 0) start = TTimeStamp();
+
+   memcpy(buf, fMapBegin + fOffset, len);
+   fOffset += len;
+
+   fBytesRead  += len;
+   fgBytesRead += len;
+   fReadCalls++;
+   fgReadCalls++;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats != 0) {
+      gPerfStats->FileReadEvent(this, len, start);
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the block of length 'len' at the offset 'pos' in the
+/// file if the file is memory-mapped and the block is entirely mapped.
+///
+/// The memory is read-only and remains valid until the file is closed.
+/// The block is accounted as read from the file, but no copy is done:
+/// this allows for example to decompress a basket straight from the page
+/// cache. Returns nullptr if the block is not available from a mapping,
+/// in which case it must be read with ReadBuffer.
+
+const char *TFile::GetMappedBuffer(Long64_t pos, Int_t len)
+{
+   Long64_t offset = pos + fArchiveOffset;
+   if (!fMapBegin || pos < 0 || offset + len > fMapSize)
+      return nullptr;
+
+   fBytesRead  += len;
+   fgBytesRead += len;
+   fReadCalls++;
+   fgReadCalls++;
+   if (gPerfStats != 0) {
+      gPerfStats->FileReadEvent(this, len, TTimeStamp());
+   }
+   return fMapBegin + offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Memory-map a local file opened for reading, if requested via the
+/// "mmap=1" URL option or the rootrc variable TFile.MemoryMap.
+///
+/// Returns kTRUE if the file is mapped. On failure the file is simply read
+/// with the regular system calls.
+
+Bool_t TFile::MapFile()
+{
+#ifndef WIN32
+   if (fMapBegin || fD == -1 || IsWritable())
+      return kFALSE;
+   if (!strstr(fUrl.GetOptions(), "mmap=1") && !gEnv->GetValue("TFile.MemoryMap", 0))
+      return kFALSE;
+
+   Long_t id, flags, modtime;
+   Long64_t size;
+   if (SysStat(fD, &id, &size, &flags, &modtime) || size <= 0)
+      return kFALSE;
+   void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fD, 0);
+   if (addr == MAP_FAILED) {
+      SysError("MapFile", "cannot map file %s, it will be read without mapping", GetName());
+      return kFALSE;
+   }
+   fMapBegin = static_cast<char *>(addr);
+   fMapSize  = size;
+   return kTRUE;
+#else
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the memory mapping of the file (if any).
+
+void TFile::UnmapFile()
+{
+#ifndef WIN32
+   if (fMapBegin)
+      munmap(fMapBegin, fMapSize);
+#endif
+   fMapBegin = nullptr;
+   fMapSize  = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read buffer via cache.
 ///
@@ -2116,12 +2262,14 @@ Int_t TFile::ReOpen(Option_t *mode)
          return -1;
       }
       SetWritable(kFALSE);
+      MapFile();
 
    } else {
       // switch to UPDATE mode
 
       // close readonly file
       if (IsOpen()) {
+         UnmapFile();
          SysClose(fD);
          fD = -1;
       }
@@ -32,6 +32,8 @@
 #include "TFilePrefetch.h"
 #include "TMath.h"
 
+#include <vector>
+
 ClassImp(TFileCacheRead);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -84,6 +86,8 @@ TFileCacheRead::TFileCacheRead() : TObject()
    fEnablePrefetching = kFALSE;
    fPrefetch        = 0;
    fPrefetchedBlocks= 0;
+   fReadAhead       = 0;
+   fReadAheadHits   = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -133,6 +137,8 @@ TFileCacheRead::TFileCacheRead(TFile *file, Int_t buffersize, TObject *tree)
    fBuffer = 0;
    fPrefetch = 0;
    fPrefetchedBlocks = 0;
+   fReadAhead = 0;
+   fReadAheadHits = 0;
 
    //initialise the prefetch object and set the cache directory
    // start the thread only if the file is not local
@@ -159,6 +165,7 @@ TFileCacheRead::TFileCacheRead(TFile *file, Int_t buffersize, TObject *tree)
 TFileCacheRead::~TFileCacheRead()
 {
    SafeDelete(fPrefetch);
+   SafeDelete(fReadAhead);
    delete [] fSeek;
    delete [] fSeekIndex;
    delete [] fSeekSort;
@@ -191,7 +198,7 @@ void TFileCacheRead::Close(Option_t * /* opt = "" */)
       delete fPrefetch;
       fPrefetch = 0;
    }
-
+   SafeDelete(fReadAhead);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -338,6 +345,10 @@ void TFileCacheRead::Print(Option_t *option) const
      printf("Prefetching .......................: %lli blocks\n", fPrefetchedBlocks);
      printf("Prefetching Wait Time..............: %f seconds\n", fPrefetch->GetWaitTime() / 1e+6);
    }
+   if (fReadAhead){
+     printf("Read-ahead ........................: %lli blocks found\n", fReadAheadHits);
+     printf("Read-ahead Wait Time...............: %f seconds\n", fReadAhead->GetWaitTime() / 1e+6);
+   }
 
    if (!opt.Contains("a")) return;
    for (Int_t i=0;i<fNseek;i++) {
@@ -458,8 +469,9 @@ Int_t TFileCacheRead::ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, In
 
       // If ReadBufferAsync is not supported by this implementation...
       if (!fAsyncReading) {
-         // Then we use the vectored read to read everything now
-         if (fFile->ReadBuffers(fBuffer,fPos,fLen,fNb)) {
+         // Then we use the vectored read to read everything now,
+         // taking what is available from the read-ahead blocks.
+         if (fReadAhead ? ReadBuffersWithReadAhead() : fFile->ReadBuffers(fBuffer,fPos,fLen,fNb)) {
             return -1;
          }
          fIsTransferred = kTRUE;
@@ -562,6 +574,86 @@ void TFileCacheRead::SetFile(TFile *file, TFile::ECacheAction action)
          SecondPrefetch(0, 0);
       fPrefetch->SetFile(file, action);
    }
+   if (fReadAhead) {
+      fReadAhead->SetFile(file, action);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable reading ahead up to 'nblocks' blocks in a background thread.
+///
+/// Blocks submitted to the read-ahead engine (see TTreeCache::SetReadAheadClusters)
+/// are transferred while the current content of the cache is being used; when
+/// the cache is refilled, the pieces already read ahead are copied into fBuffer
+/// and only the remaining ones are read from the file.
+/// As for TFile.AsyncPrefetching, this is only enabled for remote files since
+/// the reading from the file happens concurrently from two threads.
+/// If 'nblocks' is 0 read-ahead is disabled.
+
+void TFileCacheRead::SetReadAhead(Int_t nblocks)
+{
+   if (nblocks <= 0) {
+      SafeDelete(fReadAhead);
+      return;
+   }
+   if (fEnablePrefetching || fAsyncReading) {
+      Warning("SetReadAhead", "Read-ahead cannot be combined with asynchronous prefetching or reading.");
+      return;
+   }
+   if (!fFile || !strcmp(fFile->GetEndpointUrl()->GetProtocol(), "file")) {
+      // disable the read-ahead for local files
+      SafeDelete(fReadAhead);
+      return;
+   }
+   if (!fReadAhead) {
+      fReadAhead = new TFilePrefetch(fFile);
+      if (fReadAhead->ThreadStart()) {
+         Error("SetReadAhead", "Error starting the read-ahead thread. Disabling read-ahead.");
+         SafeDelete(fReadAhead);
+         return;
+      }
+   }
+   // Keep one more block than requested: the oldest one is still in use
+   // while the newest one is being transferred.
+   fReadAhead->SetMaxReadBlocks(nblocks + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transfer the sorted blocks into fBuffer, taking the blocks present in the
+/// read-ahead buffers from there and reading the others from the file with
+/// a single vectored read.
+/// Returns kTRUE in case of failure, as TFile::ReadBuffers.
+
+Bool_t TFileCacheRead::ReadBuffersWithReadAhead()
+{
+   std::vector<Long64_t> pos;
+   std::vector<Int_t> len;
+   std::vector<Int_t> where;
+   Int_t total = 0;
+   for (Int_t i = 0; i < fNseek; i++) {
+      if (fReadAhead->ReadBufferIfRequested(&fBuffer[fSeekPos[i]], fSeekSort[i], fSeekSortLen[i])) {
+         ++fReadAheadHits;
+         continue;
+      }
+      pos.push_back(fSeekSort[i]);
+      len.push_back(fSeekSortLen[i]);
+      where.push_back(fSeekPos[i]);
+      total += fSeekSortLen[i];
+   }
+   if (pos.empty())
+      return kFALSE;
+   if ((Int_t)pos.size() == fNseek)
+      return fFile->ReadBuffers(fBuffer,fPos,fLen,fNb);
+
+   std::vector<char> missed(total);
+   if (fFile->ReadBuffers(missed.data(), pos.data(), len.data(), pos.size()))
+      return kTRUE;
+   Int_t offset = 0;
+   for (size_t i = 0; i < pos.size(); i++) {
+      memcpy(&fBuffer[where[i]], &missed[offset], len[i]);
+      offset += len[i];
+   }
+   return kFALSE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -50,6 +50,13 @@ to be merged, like the standalone hadd program.
 #include <sys/resource.h>
 #endif
 
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 ClassImp(TFileMerger);
 
 TClassRef R__TH1_Class("TH1");
@@ -84,6 +91,33 @@ static Int_t R__GetSystemMaxOpenedFiles()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open the files `urls` for reading on the ROOT thread pool, created with
+/// `nthreads` threads if it does not exist yet, so that the latencies of opening
+/// (remote) files overlap. Return the files in the same order, with a null
+/// pointer for the ones that could not be opened.
+
+std::vector<TFile *> TFileMerger::OpenFiles(const std::vector<TString> &urls, UInt_t nthreads)
+{
+   std::vector<TFile *> files(urls.size(), nullptr);
+   auto open = [&](UInt_t i) {
+      TDirectory::TContext ctxt;
+      files[i] = TFile::Open(urls[i], "READ");
+   };
+#ifdef R__USE_IMT
+   if (nthreads > 1 && urls.size() > 1) {
+      ROOT::TThreadExecutor pool(nthreads);
+      pool.Foreach(open, ROOT::TSeqU(urls.size()));
+      return files;
+   }
+#else
+   (void)nthreads;
+#endif
+   for (UInt_t i = 0; i < urls.size(); ++i)
+      open(i);
+   return files;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create file merger object.
 
@@ -408,6 +442,10 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
    info.fOptions = fMergeOptions;
    if (fFastMethod && ((type&kKeepCompression) || !fCompressionChange) ) {
       info.fOptions.Append(" fast");
+   } else if (fFastMethod && fRecompressBaskets) {
+      // Copy the TTree baskets without unstreaming them, recompressing the
+      // ones whose compression differs from the output (see TTreeCloner).
+      info.fOptions.Append(" fast recompress");
    }
 
    TFile      *current_file;
@@ -911,9 +949,22 @@ Bool_t TFileMerger::OpenExcessFiles()
    TString localcopy;
    // We want gDirectory untouched by anything going on here
    TDirectory::TContext ctxt;
+
+   // With implicit multi-threading, open the next set of files concurrently.
+   std::vector<TFile *> opened;
+   if (!fLocal && ROOT::IsImplicitMTEnabled()) {
+      std::vector<TString> urls;
+      TIter nexturl(&fExcessFiles);
+      while ((Int_t)urls.size() < (fMaxOpenedFiles-1) && ( url = (TObjString*)nexturl() ))
+         urls.emplace_back(url->GetName());
+      opened = OpenFiles(urls, ROOT::GetImplicitMTPoolSize());
+   }
+
    while( nfiles < (fMaxOpenedFiles-1) && ( url = (TObjString*)next() ) ) {
       TFile *newfile = 0;
-      if (fLocal) {
+      if (nfiles < (Int_t)opened.size()) {
+         newfile = opened[nfiles];
+      } else if (fLocal) {
          TUUID uuid;
          localcopy.Form("file:%s/ROOTMERGE-%s.root", gSystem->TempDirectory(), uuid.AsString());
          if (!TFile::Cp(url->GetName(), localcopy, url->TestBit(kCpProgress))) {
@@ -931,6 +982,8 @@ Bool_t TFileMerger::OpenExcessFiles()
                   localcopy.Data(), url->GetName());
          else
             Error("OpenExcessFiles", "cannot open file %s", url->GetName());
+         for (size_t i = nfiles + 1; i < opened.size(); ++i)
+            delete opened[i];
          return kFALSE;
       } else {
          if (fOutputFile && fOutputFile->GetCompressionLevel() != newfile->GetCompressionLevel()) fCompressionChange = kTRUE;
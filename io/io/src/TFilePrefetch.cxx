@@ -22,7 +22,7 @@
 #include <cctype>
 #include <cassert>
 
-static const int kMAX_READ_SIZE    = 2;   //maximum size of the read list of blocks
+static const int kMAX_READ_SIZE    = 2;   //default maximum size of the read list of blocks
 
 inline int xtod(char c) { return (c>='0' && c<='9') ? c-'0' : ((c>='A' && c<='F') ? c-'A'+10 : ((c>='a' && c<='f') ? c-'a'+10 : 0)); }
 
@@ -53,7 +53,9 @@ TFilePrefetch::TFilePrefetch(TFile* file) :
   fFile(file),
   fConsumer(0),
   fThreadJoined(kTRUE),
-  fPrefetchFinished(kFALSE)
+  fPrefetchFinished(kFALSE),
+  fMaxReadBlocks(kMAX_READ_SIZE),
+  fInFlightBlock(0)
 {
    fPendingBlocks    = new TList();
    fReadBlocks       = new TList();
@@ -206,6 +208,88 @@ Bool_t TFilePrefetch::ReadBuffer(char* buf, Long64_t offset, Int_t len)
    return found;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the piece [offset, offset+len) was requested, i.e. it is part
+/// of a block still in the pending list or currently being transferred.
+
+Bool_t TFilePrefetch::IsRequested(Long64_t offset, Int_t len)
+{
+   Int_t index = -1;
+   std::lock_guard<std::mutex> lk(fMutexPendingList);
+   if (fInFlightBlock && BinarySearchReadList(fInFlightBlock, offset, len, &index))
+      return kTRUE;
+   TIter iter(fPendingBlocks);
+   TFPBlock* blockObj = 0;
+   while ((blockObj = (TFPBlock*) iter.Next())){
+      if (BinarySearchReadList(blockObj, offset, len, &index))
+         return kTRUE;
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the piece [offset, offset+len) into buf if it is present in one of the
+/// read blocks. The caller must hold fMutexReadList.
+
+Bool_t TFilePrefetch::CopyFromReadList(char* buf, Long64_t offset, Int_t len)
+{
+   TIter iter(fReadBlocks);
+   TFPBlock* blockObj = 0;
+   Int_t index = -1;
+   while ((blockObj = (TFPBlock*) iter.Next())){
+      if (BinarySearchReadList(blockObj, offset, len, &index)){
+         char *pBuff = blockObj->GetPtrToPiece(index);
+         pBuff += (offset - blockObj->GetPos(index));
+         memcpy(buf, pBuff, len);
+         return kTRUE;
+      }
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a prefetched element if it was read or requested.
+///
+/// Contrary to ReadBuffer(), this never waits for a piece which was not
+/// requested via ReadBlock(): it returns false instead so that the caller
+/// can read it synchronously. If the piece is pending or in flight, wait
+/// until the consumer thread has transferred it.
+
+Bool_t TFilePrefetch::ReadBufferIfRequested(char* buf, Long64_t offset, Int_t len)
+{
+   std::unique_lock<std::mutex> lk(fMutexReadList);
+   while (1){
+      if (CopyFromReadList(buf, offset, len))
+         return kTRUE;
+      if (fPrefetchFinished)
+         return kFALSE;
+      // Check the pending list without holding the read list lock; a block
+      // going from "in flight" to "read" is added to the read list first.
+      lk.unlock();
+      Bool_t requested = IsRequested(offset, len);
+      lk.lock();
+      if (CopyFromReadList(buf, offset, len))
+         return kTRUE;
+      if (!requested)
+         return kFALSE;
+      fWaitTime.Start(kFALSE);
+      fReadBlockAdded.wait(lk); //wait for a new block to be added
+      fWaitTime.Stop();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum number of blocks kept in the read list. When the list is
+/// full, the oldest block is recycled for the next request. Read-ahead over
+/// several blocks requires at least one more slot than the number of blocks
+/// requested in advance.
+
+void TFilePrefetch::SetMaxReadBlocks(Int_t n)
+{
+   std::lock_guard<std::mutex> lk(fMutexReadList);
+   fMaxReadBlocks = n < 1 ? 1 : n;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create a TFPBlock object or recycle one and add it to the prefetchBlocks list.
 
@@ -248,6 +332,7 @@ TFPBlock* TFilePrefetch::GetPendingBlock()
       block = (TFPBlock*)fPendingBlocks->First();
       block = (TFPBlock*)fPendingBlocks->Remove(block);
    }
+   fInFlightBlock = block;
    return block;
 }
 
@@ -258,7 +343,7 @@ void TFilePrefetch::AddReadBlock(TFPBlock* block)
 {
    fMutexReadList.lock();
 
-   if (fReadBlocks->GetSize() >= kMAX_READ_SIZE){
+   if (fReadBlocks->GetSize() >= fMaxReadBlocks){
       TFPBlock* movedBlock = (TFPBlock*) fReadBlocks->First();
       movedBlock = (TFPBlock*)fReadBlocks->Remove(movedBlock);
       delete movedBlock;
@@ -268,6 +353,11 @@ void TFilePrefetch::AddReadBlock(TFPBlock* block)
    fReadBlocks->Add(block);
    fMutexReadList.unlock();
 
+   // The block is now visible in the read list, it is no longer in flight.
+   fMutexPendingList.lock();
+   if (fInFlightBlock == block) fInFlightBlock = 0;
+   fMutexPendingList.unlock();
+
    //signal the addition of a new block
    fReadBlockAdded.notify_one();
 }
@@ -282,7 +372,7 @@ TFPBlock* TFilePrefetch::CreateBlockObj(Long64_t* offset, Int_t* len, Int_t nobl
 
    fMutexReadList.lock();
 
-   if (fReadBlocks->GetSize() >= kMAX_READ_SIZE){
+   if (fReadBlocks->GetSize() >= fMaxReadBlocks){
       blockObj = static_cast<TFPBlock*>(fReadBlocks->First());
       fReadBlocks->Remove(blockObj);
       fMutexReadList.unlock();
@@ -323,6 +413,7 @@ void TFilePrefetch::SetFile(TFile *file, TFile::ECacheAction action)
         // Remove all pending and read blocks
         fMutexPendingList.lock();
         fPendingBlocks->Clear();
+        fInFlightBlock = 0;
         fMutexPendingList.unlock();
 
         fMutexReadList.lock();
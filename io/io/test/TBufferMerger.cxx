@@ -168,6 +168,83 @@ TEST(TBufferMerger, AutoSave)
    remove("tbuffermerger_autosave.root");
 }
 
+TEST(TBufferMerger, MaxQueueSize)
+{
+   int nevents = 16384;
+   int nthreads = 8;
+   int nwrites = 8;
+   int events_per_write = nevents / (nthreads * nwrites);
+
+   ROOT::EnableThreadSafety();
+
+   {
+      TBufferMerger merger("tbuffermerger_maxqueue.root");
+
+      merger.SetAutoSave(16 * 1024 * 1024); // Only merge when the queue is full
+      merger.SetMaxQueueSize(2);
+      EXPECT_EQ(2u, merger.GetMaxQueueSize());
+
+      std::vector<std::thread> threads;
+      for (int i = 0; i < nthreads; ++i) {
+         threads.emplace_back([=, &merger]() {
+            auto myfile = merger.GetFile();
+            auto mytree = new TTree("mytree", "mytree");
+
+            // The resetting of the kCleanup bit below is necessary to avoid leaving
+            // the management of this object to ROOT, which leads to a race condition
+            // that may cause a crash once all threads are finished and the final
+            // merge is happening
+            mytree->ResetBit(kMustCleanup);
+
+            int n = 0;
+            mytree->Branch("n", &n, "n/I");
+            for (int w = 0; w < nwrites; ++w) {
+               for (int j = 0; j < events_per_write; ++j) {
+                  n = (i * nwrites + w) * events_per_write + j;
+                  mytree->Fill();
+               }
+               myfile->Write();
+            }
+            mytree->ResetBranchAddresses();
+         });
+      }
+
+      for (auto &&t : threads)
+         t.join();
+
+      // A writer finding the queue full is held back, so at most one buffer
+      // per thread can be added to a full queue before it is merged.
+      EXPECT_GE(1u + nthreads, merger.GetPeakQueueSize());
+      EXPECT_LT(0u, merger.GetNBlockedWrites());
+      EXPECT_LT(0u, merger.GetNMergedBuffers());
+      EXPECT_LT(0u, merger.GetMergedBytes());
+   }
+
+   EXPECT_TRUE(FileExists("tbuffermerger_maxqueue.root"));
+
+   {
+      TFile f("tbuffermerger_maxqueue.root");
+      auto t = (TTree *)f.Get("mytree");
+      ASSERT_TRUE(t != nullptr);
+
+      int n;
+      long long sum = 0;
+      int nentries = (int)t->GetEntries();
+
+      t->SetBranchAddress("n", &n);
+
+      for (int i = 0; i < nentries; ++i) {
+         t->GetEntry(i);
+         sum += n;
+      }
+
+      EXPECT_EQ(nevents, nentries);
+      EXPECT_EQ((long long)nevents * (nevents - 1) / 2, sum);
+   }
+
+   remove("tbuffermerger_maxqueue.root");
+}
+
 TEST(TBufferMerger, CheckTreeFillResults)
 {
    int sum_s, sum_p;
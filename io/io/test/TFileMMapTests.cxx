@@ -0,0 +1,94 @@
+#include "TFile.h"
+#include "TNamed.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+static void WriteFile(const char *filename, Int_t compress)
+{
+   TFile f(filename, "RECREATE", "", compress);
+   TTree t("t", "t");
+   Int_t i = 0;
+   Double_t x = 0;
+   t.Branch("i", &i);
+   t.Branch("x", &x);
+   for (i = 0; i < 10000; ++i) {
+      x = 0.5 * i;
+      t.Fill();
+   }
+   TNamed n("name", "title");
+   n.Write();
+   t.Write();
+}
+
+static void CheckFile(const char *filename, Bool_t mmap = kTRUE, Long64_t *bytesRead = nullptr)
+{
+   TFile f(mmap ? TString::Format("%s?mmap=1", filename) : TString(filename));
+   ASSERT_FALSE(f.IsZombie());
+   EXPECT_EQ(mmap, f.IsMapped());
+
+   TNamed *n = nullptr;
+   f.GetObject("name", n);
+   ASSERT_NE(nullptr, n);
+   EXPECT_STREQ("title", n->GetTitle());
+
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   ASSERT_NE(nullptr, t);
+   Int_t i = -1;
+   Double_t x = -1;
+   t->SetBranchAddress("i", &i);
+   t->SetBranchAddress("x", &x);
+   ASSERT_EQ(10000, t->GetEntries());
+   for (Long64_t e = 0; e < t->GetEntries(); ++e) {
+      t->GetEntry(e);
+      EXPECT_EQ(e, i);
+      EXPECT_DOUBLE_EQ(0.5 * e, x);
+   }
+   EXPECT_GT(f.GetBytesRead(), 0);
+   if (bytesRead)
+      *bytesRead = f.GetBytesRead();
+}
+
+TEST(TFileMMap, Compressed)
+{
+   const char *filename = "tfile_mmap_compressed.root";
+   WriteFile(filename, 101);
+   CheckFile(filename);
+   gSystem->Unlink(filename);
+}
+
+TEST(TFileMMap, BasketsReadOnce)
+{
+   // The compressed baskets are decompressed straight from the mapping: the
+   // TTreeCache must not copy them as well. Every key and basket is then read
+   // exactly once, as in a regular read.
+   const char *filename = "tfile_mmap_readonce.root";
+   WriteFile(filename, 101);
+   Long64_t mappedBytes = 0;
+   Long64_t readBytes = 0;
+   CheckFile(filename, kTRUE, &mappedBytes);
+   CheckFile(filename, kFALSE, &readBytes);
+   EXPECT_EQ(readBytes, mappedBytes);
+   gSystem->Unlink(filename);
+}
+
+TEST(TFileMMap, Uncompressed)
+{
+   const char *filename = "tfile_mmap_uncompressed.root";
+   WriteFile(filename, 0);
+   CheckFile(filename);
+   gSystem->Unlink(filename);
+}
+
+TEST(TFileMMap, NotRequested)
+{
+   const char *filename = "tfile_mmap_default.root";
+   WriteFile(filename, 101);
+   {
+      TFile f(filename);
+      EXPECT_FALSE(f.IsMapped());
+   }
+   gSystem->Unlink(filename);
+}
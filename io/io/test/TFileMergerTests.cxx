@@ -96,3 +96,100 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    output->SetWritable(false);
    EXPECT_ROOT_ERROR(merger.OutputFile(std::move(output)), "Error in .* output file output.root is not writable\n");
 }
+
+static void CreateATupleWithCompression(TMemFile &file, const char *name, Long64_t nentries, double offset = 0)
+{
+   auto mytree = new TTree(name, "A tree");
+   mytree->SetImplicitMT(false);
+
+   mytree->SetDirectory(&file);
+   double value = 0;
+   mytree->Branch(name, &value);
+   for (Long64_t i = 0; i < nentries; ++i) {
+      value = i % 10 + offset;
+      mytree->Fill();
+   }
+   file.Write();
+}
+
+TEST(TFileMerger, RecompressBaskets)
+{
+   const Long64_t nentries = 100000;
+   // Compressed with zlib, level 1.
+   TMemFile a("a.root", "RECREATE", "", 101);
+   CreateATupleWithCompression(a, "tree", nentries);
+   TMemFile b("b.root", "RECREATE", "", 101);
+   CreateATupleWithCompression(b, "tree", nentries);
+
+   TFileMerger merger;
+   // The output is not compressed.
+   auto output = std::unique_ptr<TMemFile>(new TMemFile("output.root", "CREATE", "", 0));
+   ASSERT_TRUE(merger.OutputFile(std::move(output)));
+   merger.SetRecompressBaskets();
+
+   merger.AddFile(&a, false);
+   merger.AddFile(&b, false);
+   merger.PartialMerge();
+
+   auto &result = *static_cast<TMemFile *>(merger.GetOutputFile());
+   auto t = static_cast<TTree *>(result.Get("tree"));
+   ASSERT_TRUE(t != nullptr);
+   ASSERT_EQ(2 * nentries, t->GetEntries());
+
+   // The baskets were uncompressed, rather than copied as they are.
+   auto branch = t->GetBranch("tree");
+   EXPECT_EQ(0, branch->GetCompressionSettings());
+   EXPECT_LT(branch->GetTotBytes(), 2 * branch->GetZipBytes());
+
+   double d;
+   t->SetBranchAddress("tree", &d);
+   for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+      ASSERT_LT(0, t->GetEntry(i));
+      ASSERT_EQ((i % nentries) % 10, d);
+   }
+   t->ResetBranchAddresses();
+}
+
+TEST(TFileMerger, RecompressBasketsMixedSettings)
+{
+   const Long64_t nentries = 100000;
+   // Compressed with zlib, level 1, and with LZ4, level 4.
+   TMemFile a("a.root", "RECREATE", "", 101);
+   CreateATupleWithCompression(a, "tree", nentries);
+   TMemFile b("b.root", "RECREATE", "", 404);
+   CreateATupleWithCompression(b, "tree", nentries, 10);
+
+   TFileMerger merger;
+   // The baskets of a are recompressed, the ones of b are copied as they are.
+   auto output = std::unique_ptr<TMemFile>(new TMemFile("output.root", "CREATE", "", 404));
+   ASSERT_TRUE(merger.OutputFile(std::move(output)));
+   merger.SetRecompressBaskets();
+
+   merger.AddFile(&a, false);
+   merger.AddFile(&b, false);
+   merger.PartialMerge();
+
+   auto &result = *static_cast<TMemFile *>(merger.GetOutputFile());
+   auto t = static_cast<TTree *>(result.Get("tree"));
+   ASSERT_TRUE(t != nullptr);
+   ASSERT_EQ(2 * nentries, t->GetEntries());
+   EXPECT_EQ(404, t->GetBranch("tree")->GetCompressionSettings());
+
+   // The merged entries are identical to the ones of the inputs, in order.
+   double d, in;
+   t->SetBranchAddress("tree", &d);
+   Long64_t entry = 0;
+   for (auto input : {&a, &b}) {
+      auto tin = static_cast<TTree *>(input->Get("tree"));
+      ASSERT_TRUE(tin != nullptr);
+      tin->SetBranchAddress("tree", &in);
+      for (Long64_t i = 0; i < tin->GetEntries(); ++i, ++entry) {
+         ASSERT_LT(0, tin->GetEntry(i));
+         ASSERT_LT(0, t->GetEntry(entry));
+         ASSERT_EQ(in, d);
+      }
+      tin->ResetBranchAddresses();
+   }
+   EXPECT_EQ(t->GetEntries(), entry);
+   t->ResetBranchAddresses();
+}
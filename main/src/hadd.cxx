@@ -48,6 +48,12 @@
   (i.e. direct copy of the raw byte on disk). The "fast" mode is typically
   5 times faster than the mode unzipping and unstreaming the baskets.
 
+  If the option -mt is used, hadd uses several threads: the input files are
+  opened concurrently and, when the sources and target compression settings
+  differ, the TTree baskets are still copied without being unstreamed, only
+  the baskets with a different compression are uncompressed and compressed
+  again, in parallel.
+
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
 
@@ -87,17 +93,21 @@
 #include <sstream>
 
 #include "TFileMerger.h"
+#include "TROOT.h"
 #ifndef R__WIN32
 #include "ROOT/TProcessExecutor.hxx"
 #endif
 
+#include <algorithm>
+#include <vector>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int main( int argc, char **argv )
 {
    if ( argc < 3 || "-h" == std::string(argv[1]) || "--help" == std::string(argv[1]) ) {
       std::cout << "Usage: " << argv[0] << " [-f[fk][0-9]] [-k] [-T] [-O] [-a] \n"
-      "            [-n maxopenedfiles] [-cachesize size] [-j ncpus] [-v [verbosity]] \n"
+      "            [-n maxopenedfiles] [-cachesize size] [-j ncpus] [-mt [nthreads]] [-v [verbosity]] \n"
       "            targetfile source1 [source2 source3 ...]\n" << std::endl;
       std::cout << "This program will add histograms from a list of root files and write them" << std::endl;
       std::cout << "   to a target root file. The target file is newly created and must not" << std::endl;
@@ -111,6 +121,11 @@ int main( int argc, char **argv )
       std::cout << "If the option -v is used, explicitly set the verbosity level;\n"\
                    "   0 request no output, 99 is the default" <<std::endl;
       std::cout << "If the option -j is used, the execution will be parallelized in multiple processes\n" << std::endl;
+      std::cout << "If the option -mt is used, the execution will use multiple threads (all the cores unless\n"
+                   "   nthreads is given): the input files are opened concurrently and, if the target and\n"
+                   "   sources have different compression settings, the TTree baskets are recompressed\n"
+                   "   in parallel instead of being unstreamed. It cannot be combined with -j.\n"
+                << std::endl;
       std::cout << "If the option -dbg is used, the execution will be parallelized in multiple processes in debug mode."
                    " This will not delete the partial files stored in the working directory\n"
                 << std::endl;
@@ -157,6 +172,8 @@ int main( int argc, char **argv )
    Bool_t keepCompressionAsIs = kFALSE;
    Bool_t useFirstInputCompression = kFALSE;
    Bool_t multiproc = kFALSE;
+   Bool_t multithread = kFALSE;
+   UInt_t nThreads = 0;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
    Int_t verbosity = 99;
@@ -231,6 +248,19 @@ int main( int argc, char **argv )
          }
          multiproc = kTRUE;
          ++ffirst;
+      } else if (strcmp(argv[a], "-mt") == 0) {
+         // If the number of threads is not specified, use all the cores.
+         if (a + 1 != argc && isdigit(argv[a + 1][0])) {
+            char *end = nullptr;
+            Long_t request = strtol(argv[a + 1], &end, 10);
+            if (*end == '\0' && request < kMaxInt) {
+               nThreads = (UInt_t)request;
+               ++a;
+               ++ffirst;
+            }
+         }
+         multithread = kTRUE;
+         ++ffirst;
       } else if ( strcmp(argv[a],"-cachesize=") == 0 ) {
          int size;
          static const size_t arglen = strlen("-cachesize=");
@@ -381,6 +411,18 @@ int main( int argc, char **argv )
 
    gSystem->Load("libTreePlayer");
 
+   if (multithread) {
+      if (multiproc) {
+         std::cerr << "Error: the options -mt and -j cannot be combined, -mt is ignored.\n";
+         multithread = kFALSE;
+      } else {
+         ROOT::EnableImplicitMT(nThreads);
+         if (verbosity > 1) {
+            std::cout << "hadd using " << ROOT::GetImplicitMTPoolSize() << " threads" << std::endl;
+         }
+      }
+   }
+
    const char *targetname = 0;
    if (outputPlace) {
       targetname = argv[outputPlace];
@@ -467,10 +509,14 @@ int main( int argc, char **argv )
       if (reoptimize) {
          merger.SetFastMethod(kFALSE);
       } else {
+         merger.SetRecompressBaskets(multithread);
          if (!keepCompressionAsIs && merger.HasCompressionChange()) {
             // Don't warn if the user any request re-optimization.
             std::cout << "hadd Sources and Target have different compression levels" << std::endl;
-            std::cout << "hadd merging will be slower" << std::endl;
+            if (multithread)
+               std::cout << "hadd the baskets will be recompressed in parallel" << std::endl;
+            else
+               std::cout << "hadd merging will be slower" << std::endl;
          }
       }
       merger.SetNotrees(noTrees);
@@ -486,6 +532,9 @@ int main( int argc, char **argv )
 
    auto sequentialMerge = [&](TFileMerger &merger, int start, int nFiles) {
 
+      // The inputs, and whether each one comes from an indirect file.
+      std::vector<std::string> inputs;
+      std::vector<bool> indirect;
       for (auto i = start; i < (start + nFiles) && i < argc; i++) {
          if (argv[i] && argv[i][0] == '@') {
             std::ifstream indirect_file(argv[i] + 1);
@@ -495,17 +544,40 @@ int main( int argc, char **argv )
             }
             while (indirect_file) {
                std::string line;
-               if (std::getline(indirect_file, line) && line.length() && !merger.AddFile(line.c_str())) {
-                  return kFALSE;
+               if (std::getline(indirect_file, line) && line.length()) {
+                  inputs.emplace_back(line);
+                  indirect.push_back(true);
                }
             }
-         } else if (!merger.AddFile(argv[i])) {
-            if (skip_errors) {
-               std::cerr << "hadd skipping file with error: " << argv[i] << std::endl;
-            } else {
-               std::cerr << "hadd exiting due to error in " << argv[i] << std::endl;
-               return kFALSE;
-            }
+         } else {
+            inputs.emplace_back(argv[i]);
+            indirect.push_back(false);
+         }
+      }
+
+      // With -mt, the files kept open by the merger are opened concurrently;
+      // the merger opens the other ones itself when it gets to them.
+      std::vector<TFile *> opened;
+      if (multithread && merger.GetMaxOpenedFiles() > 1) {
+         const size_t nopen = std::min<size_t>(merger.GetMaxOpenedFiles() - 1, inputs.size());
+         opened = TFileMerger::OpenFiles(std::vector<TString>(inputs.begin(), inputs.begin() + nopen),
+                                         ROOT::GetImplicitMTPoolSize());
+      }
+
+      for (size_t i = 0; i < inputs.size(); ++i) {
+         Bool_t added = i < opened.size() ? (opened[i] && merger.AddAdoptFile(opened[i]))
+                                          : merger.AddFile(inputs[i].c_str());
+         if (added) {
+            continue;
+         }
+         if (skip_errors && !indirect[i]) {
+            std::cerr << "hadd skipping file with error: " << inputs[i] << std::endl;
+         } else {
+            if (!indirect[i])
+               std::cerr << "hadd exiting due to error in " << inputs[i] << std::endl;
+            for (size_t j = i + 1; j < opened.size(); ++j)
+               delete opened[j];
+            return kFALSE;
          }
       }
       return mergeFiles(merger);
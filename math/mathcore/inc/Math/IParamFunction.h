@@ -127,6 +127,18 @@ namespace ROOT {
             return DoEval(x);
          }
 
+         /**
+            Evaluate the function for the parameters p at n points, given by
+            their coordinates per dimension: the i-th point is
+            (x[0][i], ..., x[NDim()-1][i]) and its value is stored in f[i].
+            Returns false, without evaluating anything, if the function does not
+            support batch evaluation; the caller must then evaluate point by point.
+         */
+         bool EvalParBatch(unsigned int n, const T *const *x, const double *p, T *f) const
+         {
+            return DoEvalParBatch(n, x, p, f);
+         }
+
       private:
          /**
             Implementation of the evaluation function using the x values and the parameters.
@@ -134,6 +146,16 @@ namespace ROOT {
          */
          virtual T DoEvalPar(const T *x, const double *p) const = 0;
 
+         /**
+            Implementation of the batch evaluation. Derived classes able to
+            evaluate many points more efficiently than one by one can override it;
+            the default does not support it.
+         */
+         virtual bool DoEvalParBatch(unsigned int, const T *const *, const double *, T *) const
+         {
+            return false;
+         }
+
          /**
             Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
          */
@@ -214,6 +214,49 @@ namespace ROOT {
          }
 
 
+         // evaluate the model function for the parameters p at all the points of data, using
+         // the batch interface of the function (IParamMultiFunction::EvalParBatch) on chunks of
+         // points, processed in parallel with the multithread execution policy.
+         // Return false if the function does not provide a batch evaluation.
+         bool EvaluateModelBatch(const IModelFunction &func, const FitData &data, const double *p,
+                                 std::vector<double> &fvals, ROOT::Fit::ExecutionPolicy executionPolicy)
+         {
+            const unsigned int kBatchSize = 1024;
+            const unsigned int n = data.Size();
+            const unsigned int ndim = data.NDim();
+            if (n == 0 || ndim == 0)
+               return false;
+            fvals.resize(n);
+
+            auto evalChunk = [&](unsigned int ichunk) {
+               const unsigned int first = ichunk * kBatchSize;
+               const unsigned int size = std::min(kBatchSize, n - first);
+               std::vector<const double *> x(ndim);
+               for (unsigned int j = 0; j < ndim; ++j)
+                  x[j] = data.GetCoordComponent(first, j);
+               return func.EvalParBatch(size, x.data(), p, fvals.data() + first);
+            };
+
+            // the first chunk tells whether the function supports it, and
+            // prepares it (e.g. compiles it) in a thread safe way
+            if (!evalChunk(0))
+               return false;
+            const unsigned int nchunks = (n + kBatchSize - 1) / kBatchSize;
+#ifdef R__USE_IMT
+            if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread && nchunks > 2) {
+               ROOT::TThreadExecutor pool;
+               pool.Foreach([&](unsigned int ichunk) { evalChunk(ichunk); }, ROOT::TSeq<unsigned>(1, nchunks));
+               return true;
+            }
+#else
+            (void)executionPolicy;
+#endif
+            for (unsigned int ichunk = 1; ichunk < nchunks; ++ichunk)
+               evalChunk(ichunk);
+            return true;
+         }
+
+
 
       } // end namespace  FitUtil
 
@@ -270,6 +313,10 @@ namespace ROOT {
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 
+   // evaluate the function on all the points at once when it supports it
+   std::vector<double> fvals;
+   const bool useBatch = !useBinIntegral && !useBinVolume && EvaluateModelBatch(func, data, p, fvals, executionPolicy);
+
    auto mapFunction = [&](const unsigned i){
 
       double chi2{};
@@ -296,7 +343,7 @@ namespace ROOT {
          x = xc.data();
          // normalize the bin volume using a reference value
          binVolume *= wrefVolume;
-      } else if(data.NDim() > 1) {
+      } else if(data.NDim() > 1 && !useBatch) {
          xc.resize(data.NDim());
          xc[0] = *x1;
          for (unsigned int j = 1; j < data.NDim(); ++j)
@@ -307,7 +354,10 @@ namespace ROOT {
       }
 
 
-      if (!useBinIntegral) {
+      if (useBatch) {
+         fval = fvals[i];
+      }
+      else if (!useBinIntegral) {
 #ifdef USE_PARAMCACHE
          fval = func ( x );
 #else
@@ -957,6 +1007,10 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
             }
          }
 
+         // evaluate the function on all the points at once when it supports it
+         std::vector<double> fvals;
+         const bool useBatch = EvaluateModelBatch(func, data, p, fvals, executionPolicy);
+
          // needed to compue effective global weight in case of extended likelihood
 
          auto mapFunction = [&](const unsigned i) {
@@ -964,7 +1018,9 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
             double W2 = 0;
             double fval = 0;
 
-            if (data.NDim() > 1) {
+            if (useBatch) {
+               fval = fvals[i];
+            } else if (data.NDim() > 1) {
                std::vector<double> x(data.NDim());
                for (unsigned int j = 0; j < data.NDim(); ++j)
                   x[j] = *data.GetCoordComponent(i, j);
@@ -1415,6 +1471,10 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
    IntegralEvaluator<> igEval(func, p, useBinIntegral);
 #endif
 
+   // evaluate the function on all the points at once when it supports it
+   std::vector<double> fvals;
+   const bool useBatch = !useBinIntegral && !useBinVolume && EvaluateModelBatch(func, data, p, fvals, executionPolicy);
+
    auto mapFunction = [&](const unsigned i) {
       auto x1 = data.GetCoordComponent(i, 0);
       auto y = *data.ValuePtr(i);
@@ -1436,7 +1496,7 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
          x = xc.data();
          // normalize the bin volume using a reference value
          binVolume *= wrefVolume;
-      } else if (data.NDim() > 1) {
+      } else if (data.NDim() > 1 && !useBatch) {
          xc.resize(data.NDim());
          xc[0] = *x1;
          for (unsigned int j = 1; j < data.NDim(); ++j) {
@@ -1447,7 +1507,9 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
          x = x1;
       }
 
-      if (!useBinIntegral) {
+      if (useBatch) {
+         fval = fvals[i];
+      } else if (!useBinIntegral) {
 #ifdef USE_PARAMCACHE
          fval = func(x);
 #else
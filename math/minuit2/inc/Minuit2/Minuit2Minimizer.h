@@ -303,10 +303,15 @@ protected:
    /// examine the minimum result
    bool ExamineMinimum(const ROOT::Minuit2::FunctionMinimum & min);
 
+   /// number of threads for the numerical derivatives ("NumberOfThreads" option),
+   /// 0 when the function cannot be evaluated concurrently
+   unsigned int NumberOfThreads() const;
+
 private:
 
    unsigned int fDim;       // dimension of the function to be minimized
    bool fUseFumili;
+   bool fThreadSafeFCN;     // false for the fit method functions of ROOT::Fit
 
    ROOT::Minuit2::MnUserParameterState fState;
    // std::vector<ROOT::Minuit2::MinosError> fMinosErrors;
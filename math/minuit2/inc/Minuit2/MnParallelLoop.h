@@ -0,0 +1,39 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_MnParallelLoop
+#define ROOT_Minuit2_MnParallelLoop
+
+#include <functional>
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+/**
+   Run func(i) for i = 0,...,n-1 using nthreads threads of the ROOT thread pool
+   (ROOT::TThreadExecutor). The calls are made serially and in order when nthreads < 2
+   or when Minuit2 is built without implicit multi-threading support.
+
+   func is called concurrently: it must be thread safe and its result must not depend
+   on the order in which the indices are processed (e.g. each call writes only the
+   elements of index i of the output vectors).
+ */
+void MnParallelLoop(unsigned int n, unsigned int nthreads, const std::function<void(unsigned int)> & func);
+
+/**
+   Return true if MnParallelLoop would really use nthreads (> 1) threads, i.e. if
+   Minuit2 has been built with the ROOT thread pool.
+ */
+bool MnParallelLoopIsThreaded(unsigned int nthreads);
+
+  }  // namespace Minuit2
+
+}  // namespace ROOT
+
+#endif  // ROOT_Minuit2_MnParallelLoop
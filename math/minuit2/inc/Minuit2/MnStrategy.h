@@ -22,6 +22,12 @@ namespace ROOT {
              Minos (lowers strategy by 1 for Minos-own minimization),
              Hesse (iterations),
              Numerical2PDerivative (iterations)
+
+    The number of threads (default 0, i.e. serial) is used by the numerical gradient
+    and Hessian calculators (Numerical2PGradientCalculator, HessianGradientCalculator,
+    MnHesse) to evaluate the derivatives with respect to different parameters in
+    parallel, using the ROOT thread pool. The FCN must then be thread safe.
+    The result does not depend on the number of threads.
  */
 
 class MnStrategy {
@@ -49,6 +55,8 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   unsigned int NumberOfThreads() const { return fNThreads; }
+
    bool IsLow() const {return fStrategy == 0;}
    bool IsMedium() const {return fStrategy == 1;}
    bool IsHigh() const {return fStrategy >= 2;}
@@ -69,6 +77,10 @@ public:
    // set storage level of iteration quantities
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
+
+   // set the number of threads used for the numerical derivatives
+   // 0 or 1 = serial evaluation (default)
+   void SetNumberOfThreads(unsigned int n) { fNThreads = n; }
 private:
 
    unsigned int fStrategy;
@@ -81,6 +93,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   unsigned int fNThreads;
 };
 
   }  // namespace Minuit2
@@ -24,6 +24,7 @@
 #include "Minuit2/MnPrint.h"
 #endif
 
+#include "Minuit2/MnParallelLoop.h"
 #include "Minuit2/MPIProcess.h"
 
 namespace ROOT {
@@ -85,13 +86,10 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
    unsigned int n = x.size();
    MnAlgebraicVector dgrd(n);
 
-   MPIProcess mpiproc(n,0);
-   // initial starting values
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
-      double xtf = x(i);
+   // compute the derivative with respect to parameter i, changing only the elements i
+   // of the output vectors. xv is restored to the initial point on return.
+   auto computeElement = [&](unsigned int i, MnAlgebraicVector & xv) {
+      double xtf = xv(i);
       double dmin = 4.*Precision().Eps2()*(xtf + Precision().Eps2());
       double epspri = Precision().Eps2() + fabs(grd(i)*Precision().Eps2());
       double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
@@ -103,11 +101,11 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
       double grdold = 0.;
       double grdnew = 0.;
       for(unsigned int j = 0; j < Ncycle(); j++)  {
-         x(i) = xtf + d;
-         double fs1 = Fcn()(x);
-         x(i) = xtf - d;
-         double fs2 = Fcn()(x);
-         x(i) = xtf;
+         xv(i) = xtf + d;
+         double fs1 = Fcn()(xv);
+         xv(i) = xtf - d;
+         double fs2 = Fcn()(xv);
+         xv(i) = xtf;
          //       double sag = 0.5*(fs1+fs2-2.*fcnmin);
          //LM: should I calculate also here second derivatives ???
 
@@ -135,6 +133,26 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
       std::cout << "HGC Param : " << i << "\t new g1 = " << grd(i) << " gstep = " << d << " dgrd = " << dgrd(i) << std::endl;
 #endif
 
+   };
+
+   // parameters are processed independently, each task with its own copy of x:
+   // the result does not depend on the number of threads
+   const unsigned int nthreads = Strategy().NumberOfThreads();
+   if (MnParallelLoopIsThreaded(nthreads)) {
+      MnParallelLoop(n, nthreads, [&](unsigned int i) {
+         MnAlgebraicVector xi = par.Vec();
+         computeElement(i, xi);
+      });
+      return std::pair<FunctionGradient, MnAlgebraicVector>(FunctionGradient(grd, g2, gstep), dgrd);
+   }
+
+   MPIProcess mpiproc(n,0);
+   // initial starting values
+   unsigned int startElementIndex = mpiproc.StartElementIndex();
+   unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
+      computeElement(i, x);
    }
 
    mpiproc.SyncVector(grd);
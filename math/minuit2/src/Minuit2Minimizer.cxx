@@ -82,6 +82,7 @@ void RestoreGlobalPrintLevel(int value) {
 Minuit2Minimizer::Minuit2Minimizer(ROOT::Minuit2::EMinimizerType type ) :
    Minimizer(),
    fDim(0),
+   fThreadSafeFCN(true),
    fMinimizer(0),
    fMinuitFCN(0),
    fMinimum(0)
@@ -93,6 +94,7 @@ Minuit2Minimizer::Minuit2Minimizer(ROOT::Minuit2::EMinimizerType type ) :
 Minuit2Minimizer::Minuit2Minimizer(const char *  type ) :
    Minimizer(),
    fDim(0),
+   fThreadSafeFCN(true),
    fMinimizer(0),
    fMinuitFCN(0),
    fMinimum(0)
@@ -356,6 +358,7 @@ void Minuit2Minimizer::SetFunction(const  ROOT::Math::IMultiGenFunction & func)
    // set function to be minimized
    if (fMinuitFCN) delete fMinuitFCN;
    fDim = func.NDim();
+   fThreadSafeFCN = !dynamic_cast<const ROOT::Math::FitMethodFunction *>(&func);
    if (!fUseFumili) {
       fMinuitFCN = new ROOT::Minuit2::FCNAdapter<ROOT::Math::IMultiGenFunction> (func, ErrorDef() );
    }
@@ -373,6 +376,7 @@ void Minuit2Minimizer::SetFunction(const  ROOT::Math::IMultiGenFunction & func)
 void Minuit2Minimizer::SetFunction(const  ROOT::Math::IMultiGradFunction & func) {
    // set function to be minimized
    fDim = func.NDim();
+   fThreadSafeFCN = !dynamic_cast<const ROOT::Math::FitMethodGradFunction *>(&func);
    if (fMinuitFCN) delete fMinuitFCN;
    if (!fUseFumili) {
       fMinuitFCN = new ROOT::Minuit2::FCNGradAdapter<ROOT::Math::IMultiGradFunction> (func, ErrorDef() );
@@ -388,6 +392,23 @@ void Minuit2Minimizer::SetFunction(const  ROOT::Math::IMultiGradFunction & func)
    }
 }
 
+unsigned int Minuit2Minimizer::NumberOfThreads() const {
+   // number of threads for the numerical gradient and Hessian, from the "NumberOfThreads"
+   // extra option of the "Minuit2" default options (0 = serial).
+   // The fit method functions of ROOT::Fit (Chi2FCN, LogLikelihoodFCN, ...) set the parameters
+   // of a model function they share and count their calls: they are not thread safe and
+   // are always evaluated serially. Any other function is assumed to be thread safe when the
+   // option is set.
+   ROOT::Math::IOptions * minuit2Opt = ROOT::Math::MinimizerOptions::FindDefault("Minuit2");
+   int nThreads = 0;
+   if (!minuit2Opt || !minuit2Opt->GetValue("NumberOfThreads",nThreads) || nThreads <= 1) return 0;
+   if (!fThreadSafeFCN) {
+      MN_INFO_MSG2("Minuit2Minimizer","NumberOfThreads is ignored: the fit method function is not thread safe");
+      return 0;
+   }
+   return nThreads;
+}
+
 bool Minuit2Minimizer::Minimize() {
    // perform the minimization
    // store a copy of FunctionMinimum
@@ -467,6 +488,9 @@ bool Minuit2Minimizer::Minimize() {
       bool ret = minuit2Opt->GetValue("StorageLevel",storageLevel);
       if (ret) SetStorageLevel(storageLevel);
 
+      // number of threads used for the numerical gradient and Hessian (0 = serial)
+      strategy.SetNumberOfThreads(NumberOfThreads());
+
       if (printLevel > 0) {
          std::cout << "Minuit2Minimizer::Minuit  - Changing default options" << std::endl;
          minuit2Opt->Print();
@@ -1048,7 +1072,10 @@ bool Minuit2Minimizer::Hesse( ) {
    // set the precision if needed
    if (Precision() > 0) fState.SetPrecision(Precision());
 
-   ROOT::Minuit2::MnHesse hesse( strategy );
+   ROOT::Minuit2::MnStrategy mnStrategy( strategy );
+   mnStrategy.SetNumberOfThreads(NumberOfThreads());
+
+   ROOT::Minuit2::MnHesse hesse( mnStrategy );
 
 
    // case when function minimum exists
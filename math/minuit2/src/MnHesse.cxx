@@ -19,6 +19,8 @@
 #include "Minuit2/VariableMetricEDMEstimator.h"
 #include "Minuit2/FunctionMinimum.h"
 
+#include <vector>
+
 //#define DEBUG
 
 #if defined(DEBUG) || defined(WARNINGMSG)
@@ -28,6 +30,7 @@
 #define WARNINGMSG
 #endif
 
+#include "Minuit2/MnParallelLoop.h"
 #include "Minuit2/MPIProcess.h"
 
 namespace ROOT {
@@ -130,9 +133,13 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
 #endif
 
 
-   for(unsigned int i = 0; i < n; i++) {
+   // compute the second derivative with respect to parameter i, changing only the
+   // elements i of the output vectors and counting the function calls in ncalls.
+   // x is restored to the initial point on return. Return false if the second
+   // derivative is zero.
+   auto computeDiagonal = [&](unsigned int i, MnAlgebraicVector & xv, unsigned int & ncalls) {
 
-      double xtf = x(i);
+      double xtf = xv(i);
       double dmin = 8.*prec.Eps2()*(fabs(xtf) + prec.Eps2());
       double d = fabs(gst(i));
       if(d < dmin) d = dmin;
@@ -147,20 +154,21 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
          double fs1 = 0.;
          double fs2 = 0.;
          for(unsigned int multpy = 0; multpy < 5; multpy++) {
-            x(i) = xtf + d;
-            fs1 = mfcn(x);
-            x(i) = xtf - d;
-            fs2 = mfcn(x);
-            x(i) = xtf;
+            xv(i) = xtf + d;
+            fs1 = mfcn(xv);
+            xv(i) = xtf - d;
+            fs2 = mfcn(xv);
+            xv(i) = xtf;
+            ncalls += 2;
             sag = 0.5*(fs1+fs2-2.*amin);
 
 #ifdef DEBUG
             std::cout << "cycle " << icyc << " mul " << multpy << "\t sag = " << sag << " d = " << d << std::endl;
 #endif
             //  Now as F77 Minuit - check taht sag is not zero
-            if (sag != 0) goto L30; // break
+            if (sag != 0) break;
             if(trafo.Parameter(i).HasLimits()) {
-               if(d > 0.5) goto L26;
+               if(d > 0.5) break;
                d *= 10.;
                if(d > 0.5) d = 0.51;
                continue;
@@ -168,27 +176,9 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
             d *= 10.;
          }
 
-L26:
-#ifdef WARNINGMSG
-
-         // get parameter name for i
-         // (need separate scope for avoiding compl error when declaring name)
-         {
-            const char * name = trafo.Name( trafo.ExtOfInt(i));
-            MN_INFO_VAL2("MnHesse: 2nd derivative zero for Parameter ", name);
-            MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
-         }
-#endif
-
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+         if (sag == 0) return false;
 
-L30:
-            double g2bfor = g2(i);
+         double g2bfor = g2(i);
          g2(i) = 2.*sag/(d*d);
          grd(i) = (fs1-fs2)/(2.*d);
          gst(i) = d;
@@ -212,22 +202,58 @@ L30:
          d = std::max(d, 0.1*dlast);
       }
       vhmat(i,i) = g2(i);
-      if(mfcn.NumOfCalls()  > maxcalls) {
+      return true;
+   };
+
+   // With several threads all the parameters are processed at once, each task with its own
+   // copy of x; the failures are then checked in the parameter order, as the serial loop does,
+   // so that the result does not depend on the number of threads.
+   const unsigned int nthreads = fStrategy.NumberOfThreads();
+   const bool threaded = MnParallelLoopIsThreaded(nthreads);
+   const MnAlgebraicVector g2Start = g2;
+   std::vector<char> diagOk(n, 1);
+   std::vector<unsigned int> diagCalls(n, 0);
+   if (threaded) {
+      MnParallelLoop(n, nthreads, [&](unsigned int i) {
+         MnAlgebraicVector xi = x;
+         diagOk[i] = computeDiagonal(i, xi, diagCalls[i]);
+      });
+   }
+
+   unsigned int ncalls = mfcn.NumOfCalls();
+   if (threaded) {
+      for (unsigned int i = 0; i < n; i++) ncalls -= diagCalls[i];
+   }
+
+   for(unsigned int i = 0; i < n; i++) {
+
+      if (!threaded) diagOk[i] = computeDiagonal(i, x, diagCalls[i]);
+      ncalls += diagCalls[i];
+
+      if (diagOk[i] && ncalls <= maxcalls) continue;
 
 #ifdef WARNINGMSG
+      if (!diagOk[i]) {
+         // get parameter name for i
+         const char * name = trafo.Name( trafo.ExtOfInt(i));
+         MN_INFO_VAL2("MnHesse: 2nd derivative zero for Parameter ", name);
+         MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+      }
+      else {
          //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
          MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
          MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+      }
 #endif
 
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+      // parameters after i have not been processed (or are ignored, when computed in parallel)
+      for(unsigned int j = 0; j < n; j++) {
+         double g2j = (j <= i) ? g2(j) : g2Start(j);
+         double tmp = g2j < prec.Eps2() ? 1. : 1./g2j;
+         vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
       }
 
+      return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
    }
 
 #ifdef DEBUG
@@ -245,39 +271,62 @@ L30:
 
    //off-diagonal Elements
    // initial starting values
-   if (n > 0) { 
-      MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
-      unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
-      unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
+   if (n > 0) {
+      // row i of the upper triangle, starting from an exact copy of x
+      auto computeOffDiagonalRow = [&](unsigned int i) {
+         MnAlgebraicVector xi = x;
+         xi(i) += dirin(i);
+         for (unsigned int j = i+1; j < n; j++) {
+            xi(j) = x(j) + dirin(j);
+            double fs1 = mfcn(xi);
+            double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+            vhmat(i,j) = elem;
+            xi(j) = x(j);
+         }
+      };
 
-      unsigned int offsetVect = 0;
-      for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
-         if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
+      if (threaded) {
+         MnParallelLoop(n-1, nthreads, computeOffDiagonalRow);
+      }
+      else {
+         MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
+         if (mpiprocOffDiagonal.GetMPISize() <= 1) {
+            for (unsigned int i = 0; i+1 < n; i++) computeOffDiagonalRow(i);
+         }
+         else {
+            unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
+            unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
 
-      for (unsigned int in = startParIndexOffDiagonal;
-           in<endParIndexOffDiagonal; in++) {
+            unsigned int offsetVect = 0;
+            for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
+               if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
 
-         int i = (in+offsetVect)/(n-1);
-         if ((in+offsetVect)%(n-1)==0) offsetVect += i;
-         int j = (in+offsetVect)%(n-1)+1;
+            for (unsigned int in = startParIndexOffDiagonal;
+                 in<endParIndexOffDiagonal; in++) {
 
-         if ((i+1)==j || in==startParIndexOffDiagonal)
-            x(i) += dirin(i);
+               int i = (in+offsetVect)/(n-1);
+               if ((in+offsetVect)%(n-1)==0) offsetVect += i;
+               int j = (in+offsetVect)%(n-1)+1;
 
-         x(j) += dirin(j);
+               if ((i+1)==j || in==startParIndexOffDiagonal)
+                  x(i) += dirin(i);
 
-         double fs1 = mfcn(x);
-         double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
-         vhmat(i,j) = elem;
+               x(j) += dirin(j);
 
-         x(j) -= dirin(j);
+               double fs1 = mfcn(x);
+               double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+               vhmat(i,j) = elem;
 
-         if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
-            x(i) -= dirin(i);
+               x(j) -= dirin(j);
 
-      }
+               if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
+                  x(i) -= dirin(i);
 
-      mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
+            }
+
+            mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
+         }
+      }
    }
 
    //verify if matrix pos-def (still 2nd derivative)
@@ -0,0 +1,67 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/MnParallelLoop.h"
+
+#ifdef MINUIT2_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include <memory>
+#include <mutex>
+#endif
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+
+#ifdef MINUIT2_IMT
+static std::shared_ptr<ROOT::TThreadExecutor> GetThreadExecutor(unsigned int nthreads) {
+   // the executor is kept between the calls (one per gradient or Hessian) and is
+   // created again only when a different number of threads is requested.
+   // A shared pointer is returned, so that a loop running in another thread keeps
+   // its executor alive
+   static std::mutex mutex;
+   static std::shared_ptr<ROOT::TThreadExecutor> executor;
+   static unsigned int executorThreads = 0;
+   std::lock_guard<std::mutex> lock(mutex);
+   if (!executor || executorThreads != nthreads) {
+      executor = std::make_shared<ROOT::TThreadExecutor>(nthreads);
+      executorThreads = nthreads;
+   }
+   return executor;
+}
+#endif
+
+bool MnParallelLoopIsThreaded(unsigned int nthreads) {
+   // the thread pool is available only when building inside ROOT with imt=ON
+#ifdef MINUIT2_IMT
+   return nthreads > 1;
+#else
+   (void)nthreads;
+   return false;
+#endif
+}
+
+void MnParallelLoop(unsigned int n, unsigned int nthreads, const std::function<void(unsigned int)> & func) {
+   // distribute the n calls of func over the threads of the pool
+#ifdef MINUIT2_IMT
+   if (MnParallelLoopIsThreaded(nthreads) && n > 1) {
+      GetThreadExecutor(nthreads)->Foreach(func, ROOT::TSeqU(n));
+      return;
+   }
+#else
+   (void)nthreads;
+#endif
+   for (unsigned int i = 0; i < n; ++i)
+      func(i);
+}
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
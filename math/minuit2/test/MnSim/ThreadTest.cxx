@@ -0,0 +1,129 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "GaussFcn.h"
+#include "GaussDataGen.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnUserParameters.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnPrint.h"
+
+#include <cmath>
+#include <iostream>
+
+// test that the numerical gradient and Hessian computed with several threads
+// (MnStrategy::SetNumberOfThreads) give exactly the same minimum, errors and
+// Hessian matrix as the serial computation.
+// Without the ROOT thread pool (imt=OFF) both computations are serial.
+
+using namespace ROOT::Minuit2;
+
+struct FitResult {
+   FunctionMinimum fMinimum;
+   MnUserParameterState fHesseState;
+};
+
+FitResult doFit(const GaussFcn & fcn, const MnUserParameters & upar, unsigned int nthreads) {
+
+   MnStrategy strategy(2);
+   strategy.SetNumberOfThreads(nthreads);
+
+   MnMigrad migrad(fcn, MnUserParameterState(upar), strategy);
+   FunctionMinimum min = migrad();
+
+   MnHesse hesse(strategy);
+   MnUserParameterState state = hesse(fcn, min.UserParameters());
+
+   FitResult result = { min, state };
+   return result;
+}
+
+bool compare(const char * what, double serial, double threaded) {
+   if (serial == threaded || (std::isnan(serial) && std::isnan(threaded))) return true;
+   std::cout << "ThreadTest: " << what << " is " << serial << " with 1 thread and "
+             << threaded << " with several threads" << std::endl;
+   return false;
+}
+
+bool compareStates(const MnUserParameterState & s1, const MnUserParameterState & s2, bool hessian) {
+   bool ok = compare("valid state", s1.IsValid(), s2.IsValid());
+   ok &= compare("fval", s1.Fval(), s2.Fval());
+   ok &= compare("edm", s1.Edm(), s2.Edm());
+   for (unsigned int i = 0; i < s1.Params().size(); ++i) {
+      ok &= compare("parameter value", s1.Value(i), s2.Value(i));
+      ok &= compare("parameter error", s1.Error(i), s2.Error(i));
+   }
+   ok &= compare("covariance status", s1.CovarianceStatus(), s2.CovarianceStatus());
+   if (!s1.HasCovariance() || !s2.HasCovariance())
+      return compare("has covariance", s1.HasCovariance(), s2.HasCovariance()) && ok;
+   MnUserCovariance c1 = hessian ? s1.Hessian() : s1.Covariance();
+   MnUserCovariance c2 = hessian ? s2.Hessian() : s2.Covariance();
+   for (unsigned int i = 0; i < c1.Nrow(); ++i) {
+      for (unsigned int j = 0; j <= i; ++j)
+         ok &= compare(hessian ? "Hessian element" : "covariance element", c1(i,j), c2(i,j));
+   }
+   return ok;
+}
+
+int main() {
+
+   // generate the data (100 data points)
+   GaussDataGen gdg(100);
+
+   std::vector<double> pos = gdg.Positions();
+   std::vector<double> meas = gdg.Measurements();
+   std::vector<double> var = gdg.Variances();
+
+   // the Gauss FCN only reads its data: it can be called concurrently
+   GaussFcn fcn(meas, pos, var);
+
+   // starting values for the parameters from the moments of the data
+   double x = 0.;
+   double x2 = 0.;
+   double norm = 0.;
+   double dx = pos[1]-pos[0];
+   double area = 0.;
+   for (unsigned int i = 0; i < meas.size(); i++) {
+      norm += meas[i];
+      x += (meas[i]*pos[i]);
+      x2 += (meas[i]*pos[i]*pos[i]);
+      area += dx*meas[i];
+   }
+   double mean = x/norm;
+   double rms2 = x2/norm - mean*mean;
+   double rms = rms2 > 0. ? std::sqrt(rms2) : 1.;
+
+   MnUserParameters upar;
+   upar.Add("mean", mean, 0.1);
+   upar.Add("sigma", rms, 0.1);
+   upar.Add("area", area, 0.1);
+
+   FitResult serial = doFit(fcn, upar, 1);
+   std::cout << "minimum with 1 thread: " << serial.fMinimum << std::endl;
+
+   bool ok = serial.fMinimum.IsValid();
+   if (!ok) std::cout << "ThreadTest: the serial minimization failed" << std::endl;
+
+   for (unsigned int nthreads = 2; nthreads <= 4; nthreads += 2) {
+      FitResult threaded = doFit(fcn, upar, nthreads);
+      std::cout << "compare with " << nthreads << " threads" << std::endl;
+      ok &= compare("number of calls", serial.fMinimum.NFcn(), threaded.fMinimum.NFcn());
+      ok &= compareStates(serial.fMinimum.UserState(), threaded.fMinimum.UserState(), false);
+      ok &= compareStates(serial.fHesseState, threaded.fHesseState, true);
+   }
+
+   if (!ok) {
+      std::cout << "ThreadTest: FAILED" << std::endl;
+      return 1;
+   }
+   std::cout << "ThreadTest: OK" << std::endl;
+   return 0;
+}
@@ -28,6 +28,9 @@ Exponential p.d.f
 
 #include "RooExponential.h"
 #include "RooRealVar.h"
+#include "RooVectorDataStore.h"
+
+#include <vector>
 
 using namespace std;
 
@@ -57,6 +60,20 @@ Double_t RooExponential::evaluate() const{
   return exp(c*x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate()
+
+Bool_t RooExponential::evaluateBatch(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store) const{
+  std::vector<Double_t> xVals(nEvents), cVals(nEvents);
+  x.arg().getValBatch(&xVals[0],begin,nEvents,store,x.nset());
+  c.arg().getValBatch(&cVals[0],begin,nEvents,store,c.nset());
+
+  for (Int_t i = 0; i < nEvents; ++i) {
+    output[i] = exp(cVals[i]*xVals[i]);
+  }
+  return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
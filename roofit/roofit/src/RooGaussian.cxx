@@ -31,6 +31,9 @@ Plain Gaussian p.d.f
 #include "RooRealVar.h"
 #include "RooRandom.h"
 #include "RooMath.h"
+#include "RooVectorDataStore.h"
+
+#include <vector>
 
 using namespace std;
 
@@ -69,6 +72,24 @@ Double_t RooGaussian::evaluate() const
   return ret ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate()
+
+Bool_t RooGaussian::evaluateBatch(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store) const
+{
+  std::vector<Double_t> xVals(nEvents), meanVals(nEvents), sigmaVals(nEvents) ;
+  x.arg().getValBatch(&xVals[0],begin,nEvents,store,x.nset()) ;
+  mean.arg().getValBatch(&meanVals[0],begin,nEvents,store,mean.nset()) ;
+  sigma.arg().getValBatch(&sigmaVals[0],begin,nEvents,store,sigma.nset()) ;
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    Double_t arg = xVals[i] - meanVals[i] ;
+    Double_t sig = sigmaVals[i] ;
+    output[i] = exp(-0.5*arg*arg/(sig*sig)) ;
+  }
+  return kTRUE ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// calculate and return the negative log-likelihood of the Poisson
 
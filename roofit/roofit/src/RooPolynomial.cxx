@@ -26,11 +26,13 @@ less than polynomial functions due to the normalization condition
 
 #include <cmath>
 #include <cassert>
+#include <algorithm>
 
 #include "RooPolynomial.h"
 #include "RooAbsReal.h"
 #include "RooArgList.h"
 #include "RooMsgService.h"
+#include "RooVectorDataStore.h"
 
 #include "TError.h"
 
@@ -123,6 +125,40 @@ Double_t RooPolynomial::evaluate() const
   return retVal * std::pow(x, lowestOrder) + (lowestOrder ? 1.0 : 0.0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(). The coefficients are calculated once, and must
+/// therefore not depend on the data.
+
+Bool_t RooPolynomial::evaluateBatch(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store) const
+{
+  const unsigned sz = _coefList.getSize();
+  const int lowestOrder = _lowestOrder;
+  if (!sz) {
+    std::fill(output, output + nEvents, lowestOrder ? 1. : 0.);
+    return kTRUE;
+  }
+  _wksp.clear();
+  _wksp.reserve(sz);
+  {
+    const RooArgSet* nset = _coefList.nset();
+    RooFIter it = _coefList.fwdIterator();
+    RooAbsReal* c;
+    while ((c = (RooAbsReal*) it.next())) {
+      if (c->dependsOnValue(*store.get())) return kFALSE;
+      _wksp.push_back(c->getVal(nset));
+    }
+  }
+  std::vector<Double_t> xVals(nEvents);
+  _x.arg().getValBatch(&xVals[0], begin, nEvents, store, _x.nset());
+  for (Int_t i = 0; i < nEvents; ++i) {
+    const Double_t x = xVals[i];
+    Double_t retVal = _wksp[sz - 1];
+    for (unsigned j = sz - 1; j--; ) retVal = _wksp[j] + x * retVal;
+    output[i] = retVal * std::pow(x, lowestOrder) + (lowestOrder ? 1.0 : 0.0);
+  }
+  return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooPolynomial::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
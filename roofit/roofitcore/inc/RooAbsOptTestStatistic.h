@@ -33,7 +33,7 @@ public:
   RooAbsOptTestStatistic(const char *name, const char *title, RooAbsReal& real, RooAbsData& data,
 			 const RooArgSet& projDeps, const char* rangeName=0, const char* addCoefRangeName=0,
 			 Int_t nCPU=1, RooFit::MPSplit interleave=RooFit::BulkPartition, Bool_t verbose=kTRUE, Bool_t splitCutRange=kFALSE,
-			 Bool_t cloneInputData=kTRUE) ;
+			 Bool_t cloneInputData=kTRUE, Int_t nThreads=1) ;
   RooAbsOptTestStatistic(const RooAbsOptTestStatistic& other, const char* name=0);
   virtual ~RooAbsOptTestStatistic();
 
@@ -61,6 +61,7 @@ protected:
   Bool_t setDataSlave(RooAbsData& data, Bool_t cloneData=kTRUE, Bool_t ownNewDataAnyway=kFALSE) ;
   void initSlave(RooAbsReal& real, RooAbsData& indata, const RooArgSet& projDeps, const char* rangeName, 
 		 const char* addCoefRangeName)  ;
+  virtual void dataWeightSums(Double_t& sumW, Double_t& sumW2) const ;
 
   friend class RooAbsReal ;
 
@@ -73,6 +73,9 @@ public:
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
 
+  // Batch evaluation over the events of a vector data store
+  virtual void getValBatch(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store, const RooArgSet* normSet=0) const ;
+
   Double_t getPropagatedError(const RooFitResult &fr, const RooArgSet &nset = RooArgSet());
 
   Bool_t operator==(Double_t value) const ;
@@ -372,6 +375,11 @@ protected:
   }
   virtual Double_t evaluate() const = 0 ;
 
+  // Batch evaluation support
+  virtual Bool_t evaluateBatch(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store) const ;
+  Bool_t getValBatchFromStore(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store, const RooArgSet* normSet) const ;
+  void getValBatchPerEvent(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store, const RooArgSet* normSet) const ;
+
   // Hooks for RooDataSet interface
   friend class RooRealIntegral ;
   friend class RooVectorDataStore ;
@@ -27,6 +27,7 @@ class RooAbsData ;
 class RooAbsReal ;
 class RooSimultaneous ;
 class RooRealMPFE ;
+namespace ROOT { class TThreadExecutor ; }
 
 class RooAbsTestStatistic ;
 typedef RooAbsTestStatistic* pRooAbsTestStatistic ;
@@ -41,7 +42,8 @@ public:
   RooAbsTestStatistic() ;
   RooAbsTestStatistic(const char *name, const char *title, RooAbsReal& real, RooAbsData& data,
 		      const RooArgSet& projDeps, const char* rangeName=0, const char* addCoefRangeName=0, 
-		      Int_t nCPU=1, RooFit::MPSplit interleave=RooFit::BulkPartition, Bool_t verbose=kTRUE, Bool_t splitCutRange=kTRUE) ;
+		      Int_t nCPU=1, RooFit::MPSplit interleave=RooFit::BulkPartition, Bool_t verbose=kTRUE, Bool_t splitCutRange=kTRUE,
+		      Int_t nThreads=1) ;
   RooAbsTestStatistic(const RooAbsTestStatistic& other, const char* name=0);
   virtual ~RooAbsTestStatistic();
   virtual RooAbsTestStatistic* create(const char *name, const char *title, RooAbsReal& real, RooAbsData& data,
@@ -60,6 +62,11 @@ public:
 
   void enableOffsetting(Bool_t flag) ;
   Bool_t isOffsetting() const { return _doOffset ; }
+
+  Int_t numThreads() const { 
+    // Return number of threads used in multi-threaded calculation mode (1 if not active)
+    return _nThreads ; 
+  }
   virtual Double_t offset() const { return _offset ; }
   virtual Double_t offsetCarry() const { return _offsetCarry; }
 
@@ -84,6 +91,11 @@ protected:
     _nEvents = nEvents ; 
   }
 
+  virtual void dataWeightSums(Double_t& sumW, Double_t& sumW2) const { 
+    // Return sum of weights and of squared weights of the data of this instance
+    sumW = 0 ; sumW2 = 0 ; 
+  }
+
   Int_t numSets() const { 
     // Return total number of sets for parallel calculation
     return _numSets ; 
@@ -95,9 +107,9 @@ protected:
   
   RooSetProxy _paramSet ;          // Parameters of the test statistic (=parameters of the input function)
 
-  enum GOFOpMode { SimMaster,MPMaster,Slave } ;
+  enum GOFOpMode { SimMaster,MPMaster,Slave,MTMaster } ;
   GOFOpMode operMode() const { 
-    // Return test statistic operation mode of this instance (SimMaster, MPMaster or Slave)
+    // Return test statistic operation mode of this instance (SimMaster, MPMaster, MTMaster or Slave)
     return _gofOpMode ; 
   }
 
@@ -121,6 +133,9 @@ protected:
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;    
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  RooAbsData* partitionData(RooAbsData& data, Int_t setNum) const ;
+  void setPartitionSums() ;
 
   mutable Bool_t _init ;          //! Is object initialized  
   GOFOpMode   _gofOpMode ;        // Operation mode of test statistic instance 
@@ -139,13 +154,22 @@ protected:
   Int_t          _nCPU ;      //  Number of processors to use in parallel calculation mode
   pRooRealMPFE*  _mpfeArray ; //! Array of parallel execution frond ends
 
+  // Multi-threaded mode data
+  Int_t          _nThreads ;  //  Number of threads to use in multi-threaded calculation mode
+  pRooAbsTestStatistic* _mtGofArray ; //! Array of per-thread test statistics, one per partition
+  ROOT::TThreadExecutor* _threadPool ; //! Thread pool evaluating the partitions or the RooSimultaneous components
+  mutable Bool_t _mtWarm ;    //! Partitions have been evaluated once since the last (re)configuration
+  Bool_t         _splitData ; //! Data of this instance holds only the events of its partition
+  Double_t       _splitSumW ; //! Sum of weights of the data of all partitions (if _splitData)
+  Double_t       _splitSumW2 ; //! Sum of squared weights of the data of all partitions (if _splitData)
+
   RooFit::MPSplit        _mpinterl ; // Use interleaving strategy rather than N-wise split for partioning of dataset for multiprocessor-split
   Bool_t         _doOffset ; // Apply interval value offset to control numeric precision?
   mutable Double_t _offset ; //! Offset
   mutable Double_t _offsetCarry; //! avoids loss of precision
   mutable Double_t _evalCarry; //! carry of Kahan sum in evaluatePartition
 
-  ClassDef(RooAbsTestStatistic,2) // Abstract base class for real-valued test statistics
+  ClassDef(RooAbsTestStatistic,3) // Abstract base class for real-valued test statistics
 
 };
 
@@ -36,12 +36,12 @@ public:
   RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbsData& data,
 	    Bool_t extended, const char* rangeName=0, const char* addCoefRangeName=0, 
 	    Int_t nCPU=1, RooFit::MPSplit interleave=RooFit::BulkPartition, Bool_t verbose=kTRUE, Bool_t splitRange=kFALSE, 
-	    Bool_t cloneData=kTRUE, Bool_t binnedL=kFALSE) ;
+	    Bool_t cloneData=kTRUE, Bool_t binnedL=kFALSE, Int_t nThreads=1, Bool_t batchMode=kFALSE) ;
   
   RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbsData& data,
 	    const RooArgSet& projDeps, Bool_t extended=kFALSE, const char* rangeName=0, 
 	    const char* addCoefRangeName=0, Int_t nCPU=1, RooFit::MPSplit interleave=RooFit::BulkPartition, Bool_t verbose=kTRUE, Bool_t splitRange=kFALSE, 
-	    Bool_t cloneData=kTRUE, Bool_t binnedL=kFALSE) ;
+	    Bool_t cloneData=kTRUE, Bool_t binnedL=kFALSE, Int_t nThreads=1, Bool_t batchMode=kFALSE) ;
 
   RooNLLVar(const RooNLLVar& other, const char* name=0);
   virtual TObject* clone(const char* newname) const { return new RooNLLVar(*this,newname); }
@@ -49,7 +49,7 @@ public:
   virtual RooAbsTestStatistic* create(const char *name, const char *title, RooAbsReal& pdf, RooAbsData& adata,
 				      const RooArgSet& projDeps, const char* rangeName, const char* addCoefRangeName=0, 
 				      Int_t nCPU=1, RooFit::MPSplit interleave=RooFit::BulkPartition, Bool_t verbose=kTRUE, Bool_t splitRange=kFALSE, Bool_t binnedL=kFALSE) {
-    return new RooNLLVar(name,title,(RooAbsPdf&)pdf,adata,projDeps,_extended,rangeName, addCoefRangeName, nCPU, interleave,verbose,splitRange,kFALSE,binnedL) ;
+    return new RooNLLVar(name,title,(RooAbsPdf&)pdf,adata,projDeps,_extended,rangeName, addCoefRangeName, nCPU, interleave,verbose,splitRange,kFALSE,binnedL,1,_batchMode) ;
   }
   
   virtual ~RooNLLVar();
@@ -67,14 +67,16 @@ protected:
   Bool_t _extended ;
   virtual Double_t evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const ;
   Bool_t _weightSq ; // Apply weights squared?
+  Bool_t _batchMode ; // Evaluate the p.d.f in batches of events?
   mutable Bool_t _first ; //!
   Double_t _offsetSaveW2; //!
   Double_t _offsetCarrySaveW2; //!
 
   mutable std::vector<Double_t> _binw ; //!
+  mutable std::vector<Double_t> _batchProbs ; //! P.d.f values of the current batch in batch mode
   mutable RooRealSumPdf* _binnedPdf ; //!
    
-  ClassDef(RooNLLVar,2) // Function representing (extended) -log(L) of p.d.f and dataset
+  ClassDef(RooNLLVar,3) // Function representing (extended) -log(L) of p.d.f and dataset
 };
 
 #endif
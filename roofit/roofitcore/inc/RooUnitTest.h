@@ -27,6 +27,9 @@
 #include <string>
 #include <map>
 
+class RooAbsReal ;
+class RooRealVar ;
+
 /*
  * The tolerance for the curve test is put to 0.4 instead of 0.2 to take into
  * account the small variations in the values of the likelihood which can occur
@@ -51,6 +54,7 @@ public:
   Bool_t runTest() ;
   Bool_t runCompTests() ;
   Bool_t areTHidentical(TH1* htest, TH1* href) ;
+  Bool_t compareValues(RooAbsReal& ref, RooAbsReal& test, RooRealVar& par, Double_t newVal, Double_t relTol, const char* testDesc) ;
 
   virtual Bool_t isTestAvailable() { return kTRUE ; }
   virtual Bool_t testCode() = 0 ;  
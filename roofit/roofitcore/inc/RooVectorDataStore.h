@@ -110,6 +110,9 @@ public:
 
   const RooVectorDataStore* cache() const { return _cache ; }
 
+  // Direct access to the column of values attached to a given object, for batch evaluation
+  const Double_t* realColumn(const RooAbsReal& real) const ;
+
   void loadValues(const RooAbsDataStore *tds, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
   
   void dump() ;
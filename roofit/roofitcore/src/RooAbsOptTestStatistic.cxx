@@ -108,8 +108,9 @@ RooAbsOptTestStatistic:: RooAbsOptTestStatistic()
 
 RooAbsOptTestStatistic::RooAbsOptTestStatistic(const char *name, const char *title, RooAbsReal& real, RooAbsData& indata,
 					       const RooArgSet& projDeps, const char* rangeName, const char* addCoefRangeName,
-					       Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange, Bool_t /*cloneInputData*/) : 
-  RooAbsTestStatistic(name,title,real,indata,projDeps,rangeName, addCoefRangeName, nCPU, interleave, verbose, splitCutRange),
+					       Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange, Bool_t /*cloneInputData*/,
+					       Int_t nThreads) : 
+  RooAbsTestStatistic(name,title,real,indata,projDeps,rangeName, addCoefRangeName, nCPU, interleave, verbose, splitCutRange, nThreads),
   _projDeps(0),
   _sealed(kFALSE), 
   _optimized(kFALSE)
@@ -742,6 +743,28 @@ void RooAbsOptTestStatistic::optimizeConstantTerms(Bool_t activate, Bool_t apply
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the sum of the weights and the sum of the squared weights of the
+/// (range-reduced) data of this test statistic
+
+void RooAbsOptTestStatistic::dataWeightSums(Double_t& sumW, Double_t& sumW2) const
+{
+  sumW = 0 ; sumW2 = 0 ;
+  if (!_dataClone) return ;
+
+  sumW = _dataClone->sumEntries() ;
+  Double_t carry(0) ;
+  for (Int_t i=0 ; i<_dataClone->numEntries() ; i++) {
+    _dataClone->get(i) ;
+    Double_t y = _dataClone->weightSquared() - carry ;
+    Double_t t = sumW2 + y ;
+    carry = (t - sumW2) - y ;
+    sumW2 = t ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 ///   cout << "RAOTS::setDataSlave(" << this << ") START" << endl ;
 /// Change dataset that is used to given one. If cloneData is kTRUE, a clone of
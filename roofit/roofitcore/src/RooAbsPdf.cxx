@@ -157,8 +157,10 @@ the proxy holds a function, and will trigger an assert
 #include "RooMinimizer.h"
 #include "RooRealIntegral.h"
 #include "RooWorkspace.h"
+#include "RooVectorDataStore.h"
 #include "Math/CholeskyDecomp.h"
 #include <string>
+#include <mutex>
 
 using namespace std;
 
@@ -169,6 +171,12 @@ ClassImp(RooAbsPdf::GenSpec);
 
 Int_t RooAbsPdf::_verboseEval = 0;
 Bool_t RooAbsPdf::_evalError = kFALSE ;
+
+namespace {
+  // Guards the evaluation error flag, which may be raised by p.d.f.s evaluated in several threads
+  std::mutex gEvalErrorFlagMutex ;
+}
+
 TString RooAbsPdf::_normRangeOverride ;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -312,6 +320,52 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of getValV(): fill output[i] with the normalized value of this p.d.f for
+/// event begin+i of the given vector data store. The unnormalized values are calculated by
+/// evaluateBatch() and divided by the normalization integral, which is calculated only once.
+/// If the normalization depends on the event (conditional observables) or if evaluateBatch()
+/// is not implemented, the values are calculated event by event. Events with a negative or
+/// Not-a-Number value are recalculated with getVal() to have the error logged.
+
+void RooAbsPdf::getValBatch(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store, const RooArgSet* normSet) const
+{
+  if (getValBatchFromStore(output,begin,nEvents,store,normSet)) {
+    return ;
+  }
+
+  if (!normSet) {
+    getValBatchPerEvent(output,begin,nEvents,store,normSet) ;
+    return ;
+  }
+
+  if (normSet!=_normSet || _norm==0) {
+    syncNormalization(normSet) ;
+  }
+
+  if (_norm->dependsOnValue(*store.get()) || !evaluateBatch(output,begin,nEvents,store)) {
+    getValBatchPerEvent(output,begin,nEvents,store,normSet) ;
+    return ;
+  }
+
+  const Double_t normVal = _norm->getVal() ;
+  if (normVal<=0.) {
+    getValBatchPerEvent(output,begin,nEvents,store,normSet) ;
+    return ;
+  }
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    if (output[i]<0 || TMath::IsNaN(output[i])) {
+      store.get(begin+i) ;
+      output[i] = getVal(normSet) ;
+    } else {
+      output[i] /= normVal ;
+    }
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Analytical integral with normalization (see RooAbsReal::analyticalIntegralWN() for further information)
 ///
@@ -735,6 +789,15 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 ///                                    Strategy 3 = RooFit::Hybrid --> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                                                 30 dataset entries, for which strategy 2 is followed.
 ///
+/// NumThreads(int num)             -- Parallelize NLL calculation over num threads of the ROOT thread pool, in this process.
+///                                    Each partition holds a copy of a contiguous block of the events of an unbinned dataset. The
+///                                    components of a RooSimultaneous are calculated concurrently. Supersedes the multi-process
+///                                    calculation of NumCPU(). Requires ROOT to be built with implicit multi-threading support.
+///
+/// BatchMode(Bool_t flag)          -- Evaluate the p.d.f in batches of events, directly on the columns of the dataset, rather than
+///                                    event by event. Only applies to unweighted data held in a RooVectorDataStore. Components
+///                                    without a batch implementation are still evaluated event by event.
+///
 /// Optimize(Bool_t flag)           -- Activate constant term optimization (on by default)
 /// SplitRange(Bool_t flag)         -- Use separate fit ranges in a simultaneous fit. Actual range name for each
 ///                                    subsample is assumed to by rangeName_{indexState} where indexState
@@ -790,6 +853,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineInt("ext","Extended",0,2) ;
   pc.defineInt("numcpu","NumCPU",0,1) ;
   pc.defineInt("interleave","NumCPU",1,0) ;
+  pc.defineInt("numthreads","NumThreads",0,1) ;
+  pc.defineInt("batchMode","BatchMode",0,0) ;
   pc.defineInt("verbose","Verbose",0,0) ;
   pc.defineInt("optConst","Optimize",0,0) ;
   pc.defineInt("cloneData","CloneData",2,0) ;
@@ -816,6 +881,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   Int_t ext      = pc.getInt("ext") ;
   Int_t numcpu   = pc.getInt("numcpu") ;
   RooFit::MPSplit interl = (RooFit::MPSplit) pc.getInt("interleave") ;
+  Int_t numthreads = pc.getInt("numthreads") ;
+  Bool_t batchMode = pc.getInt("batchMode") ;
 
   Int_t splitr   = pc.getInt("splitRange") ;
   Bool_t verbose = pc.getInt("verbose") ;
@@ -900,7 +967,7 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     // Simple case: default range, or single restricted range
     //cout<<"FK: Data test 1: "<<data.sumEntries()<<endl;
 
-    nll = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+    nll = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData,kFALSE,numthreads,batchMode) ;
 
   } else {
     // Composite case: multiple ranges
@@ -910,7 +977,7 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     strlcpy(buf,rangeName,bufSize) ;
     char* token = strtok(buf,",") ;
     while(token) {
-      RooAbsReal* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+      RooAbsReal* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData,kFALSE,numthreads,batchMode) ;
       nllList.add(*nllComp) ;
       token = strtok(0,",") ;
     }
@@ -1020,6 +1087,15 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 ///                                    Strategy 3 = RooFit::Hybrid --> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                                                 30 dataset entries, for which strategy 2 is followed.
 ///
+/// NumThreads(int num)             -- Parallelize NLL calculation over num threads of the ROOT thread pool, in this process.
+///                                    Each partition holds a copy of a contiguous block of the events of an unbinned dataset. The
+///                                    components of a RooSimultaneous are calculated concurrently. Supersedes the multi-process
+///                                    calculation of NumCPU(). Requires ROOT to be built with implicit multi-threading support.
+///
+/// BatchMode(Bool_t flag)          -- Evaluate the p.d.f in batches of events, directly on the columns of the dataset, rather than
+///                                    event by event. Only applies to unweighted data held in a RooVectorDataStore. Components
+///                                    without a batch implementation are still evaluated event by event.
+///
 /// SplitRange(Bool_t flag)         -- Use separate fit ranges in a simultaneous fit. Actual range name for each
 ///                                    subsample is assumed to by rangeName_{indexState} where indexState
 ///                                    is the state of the master index category of the simultaneous fit
@@ -1106,7 +1182,7 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   RooCmdConfig pc(Form("RooAbsPdf::fitTo(%s)",GetName())) ;
 
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood") ;
+  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,NumThreads,BatchMode,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood") ;
 
   pc.defineString("fitOpt","FitOptions",0,"") ;
   pc.defineInt("optConst","Optimize",0,2) ;
@@ -1478,7 +1554,7 @@ RooFitResult* RooAbsPdf::chi2FitTo(RooDataHist& data, const RooLinkedList& cmdLi
 
   // Pull arguments to be passed to chi2 construction from list
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList chi2CmdList = pc.filterCmdList(fitCmdList,"Range,RangeWithName,NumCPU,Optimize,ProjectedObservables,AddCoefRange,SplitRange,DataError,Extended") ;
+  RooLinkedList chi2CmdList = pc.filterCmdList(fitCmdList,"Range,RangeWithName,NumCPU,NumThreads,Optimize,ProjectedObservables,AddCoefRange,SplitRange,DataError,Extended") ;
 
   RooAbsReal* chi2 = createChi2(data,chi2CmdList) ;
   RooFitResult* ret = chi2FitDriver(*chi2,fitCmdList) ;
@@ -1502,6 +1578,7 @@ RooFitResult* RooAbsPdf::chi2FitTo(RooDataHist& data, const RooLinkedList& cmdLi
 ///  DataError()  -- Choose between Expected error [RooAbsData::Expected] , or Observed error (e.g. Sum-of-weights [RooAbsData:SumW2] or Poisson interval [RooAbsData::Poisson] ) 
 ///                  Default is AUTO : Expected error for unweighted data, Sum-of-weights for weighted data
 ///  NumCPU()     -- Activate parallel processing feature
+///  NumThreads() -- Parallelize the calculation over the given number of threads of the ROOT thread pool
 ///  Range()      -- Fit only selected region
 ///  SumCoefRange() -- Set the range in which to interpret the coefficients of RooAddPdf components 
 ///  SplitRange() -- Fit range is split by index catory of simultaneous PDF
@@ -3172,6 +3249,7 @@ RooArgSet* RooAbsPdf::getAllConstraints(const RooArgSet& observables, RooArgSet&
 
 void RooAbsPdf::clearEvalError() 
 { 
+  std::lock_guard<std::mutex> lock(gEvalErrorFlagMutex) ;
   _evalError = kFALSE ; 
 }
 
@@ -3182,6 +3260,7 @@ void RooAbsPdf::clearEvalError()
 
 Bool_t RooAbsPdf::evalError() 
 { 
+  std::lock_guard<std::mutex> lock(gEvalErrorFlagMutex) ;
   return _evalError ; 
 }
 
@@ -3192,6 +3271,7 @@ Bool_t RooAbsPdf::evalError()
 
 void RooAbsPdf::raiseEvalError() 
 { 
+  std::lock_guard<std::mutex> lock(gEvalErrorFlagMutex) ;
   _evalError = kTRUE ; 
 }
 
@@ -103,6 +103,8 @@
 #include "TVector.h"
 
 #include <sstream>
+#include <algorithm>
+#include <mutex>
 
 using namespace std ;
 
@@ -120,6 +122,12 @@ RooAbsReal::ErrorLoggingMode RooAbsReal::_evalErrorMode = RooAbsReal::PrintError
 Int_t RooAbsReal::_evalErrorCount = 0 ;
 map<const RooAbsArg*,pair<string,list<RooAbsReal::EvalError> > > RooAbsReal::_evalErrorList ;
 
+namespace {
+  // Serializes the logging of evaluation errors by test statistics evaluated in several
+  // threads. Recursive, as printing the error may evaluate the servers of the object
+  std::recursive_mutex gEvalErrorMutex ;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// coverity[UNINIT_CTOR]
@@ -264,10 +272,98 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill output[i] with the value getVal(normSet) would return after loading
+/// event begin+i of the given vector data store, for nEvents events.
+/// Values that are stored in the data (observables and constant-term caches)
+/// are copied from the columns of the store and values that do not depend on
+/// the data are calculated once. Otherwise the values are calculated by
+/// evaluateBatch(), or event by event if this class does not implement it.
+
+void RooAbsReal::getValBatch(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store, const RooArgSet* normSet) const
+{
+  if (getValBatchFromStore(output,begin,nEvents,store,normSet)) {
+    return ;
+  }
+
+  if (normSet && normSet!=_lastNSet) {
+    ((RooAbsReal*) this)->setProxyNormSet(normSet) ;
+    _lastNSet = (RooArgSet*) normSet ;
+  }
+
+  if (!evaluateBatch(output,begin,nEvents,store)) {
+    getValBatchPerEvent(output,begin,nEvents,store,normSet) ;
+    return ;
+  }
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    if (TMath::IsNaN(output[i])) {
+      // Recalculate to have the error logged
+      store.get(begin+i) ;
+      output[i] = getVal(normSet) ;
+    }
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): fill output[i] with the unnormalized value of this
+/// object for event begin+i of the given store. The values of the servers should be
+/// retrieved with their getValBatch() method, using the normalization set of the
+/// corresponding proxy. Return kFALSE if batch evaluation is not supported, in which
+/// case the values are calculated event by event. This default implementation
+/// always returns kFALSE.
+
+Bool_t RooAbsReal::evaluateBatch(Double_t* /*output*/, Int_t /*begin*/, Int_t /*nEvents*/, const RooVectorDataStore& /*store*/) const
+{
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Handle the batch evaluation cases that do not require calculation per event:
+/// copy the column of the store this object is attached to, if any, or fill the
+/// output with getVal(normSet) if this object does not depend on the data.
+/// Return kTRUE if the output was filled.
+
+Bool_t RooAbsReal::getValBatchFromStore(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store, const RooArgSet* normSet) const
+{
+  const Double_t* column = store.realColumn(*this) ;
+  if (column) {
+    std::copy(column+begin,column+begin+nEvents,output) ;
+    return kTRUE ;
+  }
+
+  if (!dependsOnValue(*store.get())) {
+    std::fill(output,output+nEvents,getVal(normSet)) ;
+    return kTRUE ;
+  }
+
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fallback of the batch evaluation: load each event in the store and call getVal(normSet)
+
+void RooAbsReal::getValBatchPerEvent(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store, const RooArgSet* normSet) const
+{
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    store.get(begin+i) ;
+    output[i] = getVal(normSet) ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooAbsReal::numEvalErrorItems()
 {
+  std::lock_guard<std::recursive_mutex> lock(gEvalErrorMutex) ;
   return _evalErrorList.size() ;
 }
 
@@ -3605,12 +3701,15 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     return ;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(gEvalErrorMutex) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
   }
 
-  static Bool_t inLogEvalError = kFALSE ;
+  // Recursion guard, per thread
+  static thread_local Bool_t inLogEvalError = kFALSE ;
 
   if (inLogEvalError) {
     return ;
@@ -3660,12 +3759,15 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     return ;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(gEvalErrorMutex) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
   }
 
-  static Bool_t inLogEvalError = kFALSE ;
+  // Recursion guard, per thread
+  static thread_local Bool_t inLogEvalError = kFALSE ;
 
   if (inLogEvalError) {
     return ;
@@ -3733,6 +3835,7 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
 
 void RooAbsReal::clearEvalErrorLog()
 {
+  std::lock_guard<std::recursive_mutex> lock(gEvalErrorMutex) ;
   if (_evalErrorMode==PrintErrors) {
     return ;
   } else if (_evalErrorMode==CollectErrors) {
@@ -3753,6 +3856,7 @@ void RooAbsReal::clearEvalErrorLog()
 
 void RooAbsReal::printEvalErrors(ostream& os, Int_t maxPerNode)
 {
+  std::lock_guard<std::recursive_mutex> lock(gEvalErrorMutex) ;
   if (_evalErrorMode == CountErrors) {
     os << _evalErrorCount << " errors counted" << endl ;
   }
@@ -3795,6 +3899,7 @@ void RooAbsReal::printEvalErrors(ostream& os, Int_t maxPerNode)
 
 Int_t RooAbsReal::numEvalErrors()
 {
+  std::lock_guard<std::recursive_mutex> lock(gEvalErrorMutex) ;
   if (_evalErrorMode==CountErrors) {
     return _evalErrorCount ;
   }
@@ -4277,6 +4382,7 @@ RooMultiGenFunction* RooAbsReal::iGenFunction(const RooArgSet& observables, cons
 /// Range(Double_t lo, Double_t hi) -- Fit only data inside given range. A range named "fit" is created on the fly on all observables.
 ///                                    Multiple comma separated range names can be specified.
 /// NumCPU(int num)                 -- Parallelize NLL calculation on num CPUs
+/// NumThreads(int num)             -- Parallelize chi^2 calculation over num threads of the ROOT thread pool
 /// Optimize(Bool_t flag)           -- Activate constant term optimization (on by default)
 ///
 /// Options to control flow of fit procedure
@@ -4328,7 +4434,7 @@ RooFitResult* RooAbsReal::chi2FitTo(RooDataHist& data, const RooLinkedList& cmdL
 
   // Pull arguments to be passed to chi2 construction from list
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList chi2CmdList = pc.filterCmdList(fitCmdList,"Range,RangeWithName,NumCPU,Optimize") ;
+  RooLinkedList chi2CmdList = pc.filterCmdList(fitCmdList,"Range,RangeWithName,NumCPU,NumThreads,Optimize") ;
 
   RooAbsReal* chi2 = createChi2(data,chi2CmdList) ;
   RooFitResult* ret = chi2FitDriver(*chi2,fitCmdList) ;
@@ -4350,6 +4456,7 @@ RooFitResult* RooAbsReal::chi2FitTo(RooDataHist& data, const RooLinkedList& cmdL
 ///  ------------------------------------------
 ///  DataError(RooAbsData::ErrorType)  -- Choose between Poisson errors and Sum-of-weights errors
 ///  NumCPU(Int_t)                     -- Activate parallel processing feature on N processes
+///  NumThreads(Int_t)                 -- Parallelize the calculation over N threads of the ROOT thread pool
 ///  Range()                           -- Calculate Chi2 only in selected region
 
 RooAbsReal* RooAbsReal::createChi2(RooDataHist& data, const RooCmdArg& arg1,  const RooCmdArg& arg2,
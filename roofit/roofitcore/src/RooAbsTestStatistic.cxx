@@ -32,6 +32,18 @@ organizes multi-processor parallel calculation of test statistic
 values. For the latter, the test statistic value is calculated in
 partitions in parallel executing processes and a posteriori
 combined in the main thread.
+
+Alternatively, with the NumThreads() option of RooAbsPdf::fitTo() and
+RooAbsPdf::createNLL() (nThreads constructor argument), the partitions are
+calculated by threads of the ROOT thread pool within the same process.
+Each partition uses its own clone of the function, while the parameters
+are shared with the main thread: nothing needs to be sent to the workers
+when a parameter changes. An unbinned dataset is split in contiguous
+blocks of events, and each partition only holds a copy of its own block.
+A binned dataset, which is small, is copied for each partition. For a
+RooSimultaneous, the component test statistics, which already hold their
+own share of the data, are calculated concurrently instead. The components
+of the function must not modify shared state during evaluation.
 **/
 
 
@@ -42,6 +54,7 @@ combined in the main thread.
 #include "RooAbsPdf.h"
 #include "RooSimultaneous.h"
 #include "RooAbsData.h"
+#include "RooDataSet.h"
 #include "RooArgSet.h"
 #include "RooRealVar.h"
 #include "RooNLLVar.h"
@@ -51,7 +64,14 @@ combined in the main thread.
 #include "TTimeStamp.h"
 #include "RooProdPdf.h"
 #include "RooRealSumPdf.h"
+#include "RConfigure.h"
 #include <string>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 using namespace std;
 
@@ -64,6 +84,8 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
   _func(0), _data(0), _projDeps(0), _splitRange(0), _simCount(0),
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
   _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
+  _nThreads(1), _mtGofArray(0), _threadPool(0), _mtWarm(kFALSE),
+  _splitData(kFALSE), _splitSumW(0), _splitSumW2(0),
   _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
   _offsetCarry(0), _evalCarry(0)
 {
@@ -84,10 +106,14 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
 /// i takes all bins for which (ibin % ncpu == i) which is more likely to result in an even workload.
 /// If splitCutRange is true, a different rangeName constructed as rangeName_{catName} will be used
 /// as range definition for each index state of a RooSimultaneous
+/// If nThreads is greater than 1, the partitions are instead calculated concurrently by nThreads
+/// threads of the ROOT thread pool, in this process (nCPU is then ignored). For a RooSimultaneous,
+/// the test statistics of its components are calculated concurrently. Without support for
+/// implicit multi-threading in ROOT, the calculation is sequential.
 
 RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, RooAbsReal& real, RooAbsData& data,
 					 const RooArgSet& projDeps, const char* rangeName, const char* addCoefRangeName,
-					 Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange) :
+					 Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange, Int_t nThreads) :
   RooAbsReal(name,title),
   _paramSet("paramSet","Set of parameters",this),
   _func(&real),
@@ -102,6 +128,13 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
+  _nThreads(1),
+  _mtGofArray(0),
+  _threadPool(0),
+  _mtWarm(kFALSE),
+  _splitData(kFALSE),
+  _splitSumW(0),
+  _splitSumW2(0),
   _mpinterl(interleave),
   _doOffset(kFALSE),
   _offset(0),
@@ -113,7 +146,18 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _paramSet.add(*params) ;
   delete params ;
 
-  if (_nCPU>1 || _nCPU==-1) {
+  if (nThreads>1) {
+
+    if (_nCPU>1) {
+      coutW(InputArguments) << "RooAbsTestStatistic::ctor(" << GetName() << ") WARNING: multi-threaded calculation requested, "
+			    << "ignoring request for " << _nCPU << " processes" << endl ;
+    }
+    _nCPU = 1 ;
+    _nThreads = nThreads ;
+    // The components of a RooSimultaneous, each with its own data, are calculated concurrently
+    _gofOpMode = dynamic_cast<RooSimultaneous*>(&real) ? SimMaster : MTMaster ;
+
+  } else if (_nCPU>1 || _nCPU==-1) {
 
     if (_nCPU==-1) {
       _nCPU=1 ;
@@ -161,6 +205,13 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofSplitMode(other._gofSplitMode),
   _nCPU(other._nCPU),
   _mpfeArray(0),
+  _nThreads(other._nThreads),
+  _mtGofArray(0),
+  _threadPool(0),
+  _mtWarm(kFALSE),
+  _splitData(kFALSE),
+  _splitSumW(0),
+  _splitSumW2(0),
   _mpinterl(other._mpinterl),
   _doOffset(other._doOffset),
   _offset(other._offset),
@@ -170,7 +221,11 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   // Our parameters are those of original
   _paramSet.add(other._paramSet) ;
 
-  if (_nCPU>1 || _nCPU==-1) {
+  if (other._gofOpMode == MTMaster) {
+
+    _gofOpMode = MTMaster ;
+
+  } else if (_nCPU>1 || _nCPU==-1) {
 
     if (_nCPU==-1) {
       _nCPU=1 ;
@@ -216,6 +271,15 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _gofArray ;
   }
 
+  if (MTMaster == _gofOpMode && _init) {
+    for (Int_t i = 0; i < _nThreads; ++i) delete _mtGofArray[i];
+    delete[] _mtGofArray ;
+  }
+
+#ifdef R__USE_IMT
+  delete _threadPool ;
+#endif
+
   delete _projDeps ;
 
 }
@@ -240,6 +304,15 @@ Double_t RooAbsTestStatistic::evaluate() const
     // Evaluate array of owned GOF objects
     Double_t ret = 0.;
 
+#ifdef R__USE_IMT
+    // Calculate the components concurrently, their values are then cached for the combination
+    // below. The first evaluation after a (re)configuration is done sequentially, see MTMaster
+    if (_threadPool && _mtWarm) {
+      _threadPool->Foreach([this](Int_t i) { _gofArray[i]->getVal() ; }, ROOT::TSeqI(_nGof)) ;
+    }
+#endif
+    _mtWarm = kTRUE ;
+
     if (_mpinterl == RooFit::BulkPartition || _mpinterl == RooFit::Interleave ) {
       ret = combinedValue((RooAbsReal**)_gofArray,_nGof);
     } else {
@@ -287,12 +360,49 @@ Double_t RooAbsTestStatistic::evaluate() const
     _evalCarry = carry;
     return ret ;
 
+  } else if (MTMaster == _gofOpMode) {
+
+    // Calculate the partitions concurrently, then combine them in a fixed
+    // order so that the result does not depend on the thread scheduling
+    std::vector<Double_t> vals(_nThreads), carries(_nThreads) ;
+    auto evalPartition = [&](Int_t i) {
+      vals[i] = _mtGofArray[i]->getValV() ;
+      carries[i] = _mtGofArray[i]->getCarry() ;
+    } ;
+
+#ifdef R__USE_IMT
+    // The first evaluation after a (re)configuration creates caches and
+    // integrators, which may touch global registries: do it sequentially
+    if (_threadPool && _mtWarm) {
+      _threadPool->Foreach(evalPartition, ROOT::TSeqI(_nThreads)) ;
+    } else
+#endif
+    {
+      for (Int_t i = 0; i < _nThreads; ++i) evalPartition(i) ;
+    }
+    _mtWarm = kTRUE ;
+
+    Double_t sum(0), carry = 0.;
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      Double_t y = vals[i];
+      carry += carries[i];
+      y -= carry;
+      const Double_t t = sum + y;
+      carry = (t - sum) - y;
+      sum = t;
+    }
+
+    Double_t ret = sum ;
+    _evalCarry = carry;
+    return ret ;
+
   } else {
 
     // Evaluate as straight FUNC
     Int_t nFirst(0), nLast(_nEvents), nStep(1) ;
     
-    switch (_mpinterl) {
+    // The data of a partition of a multi-threaded calculation holds only the events of the partition
+    switch (_splitData ? RooFit::SimComponents : _mpinterl) {
     case RooFit::BulkPartition:
       nFirst = _nEvents * _setNum / _numSets ;
       nLast  = _nEvents * (_setNum+1) / _numSets ;
@@ -344,6 +454,8 @@ Bool_t RooAbsTestStatistic::initialize()
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (MTMaster == _gofOpMode) {
+    initMTMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   }
   _init = kTRUE;
   return kFALSE;
@@ -371,6 +483,13 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
 // 	cout << "redirecting servers on " << _mpfeArray[i]->GetName() << endl;
       }
     }
+  } else if (MTMaster == _gofOpMode && _mtGofArray) {
+    // Forward to per-thread test statistics
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      if (_mtGofArray[i]) {
+	_mtGofArray[i]->recursiveRedirectServers(newServerList,mustReplaceAll,nameChange);
+      }
+    }
   }
   return kFALSE;
 }
@@ -396,6 +515,14 @@ void RooAbsTestStatistic::printCompactTreeHook(ostream& os, const char* indent)
     os << indent << "RooAbsTestStatistic end GOF contents" << endl;
   } else if (MPMaster == _gofOpMode) {
     // WVE implement this
+  } else if (MTMaster == _gofOpMode && _mtGofArray) {
+    os << indent << "RooAbsTestStatistic begin thread partition contents" << endl ;
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      TString indent2(indent);
+      indent2 += Form("[T%d] ",i);
+      _mtGofArray[i]->printCompactTreeHook(os,indent2);
+    }
+    os << indent << "RooAbsTestStatistic end thread partition contents" << endl;
   }
 }
 
@@ -417,10 +544,18 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
 	if (_gofArray[i]) _gofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
       }
     }
+    // Caches have been rebuilt: the next evaluation initializes them again
+    _mtWarm = kFALSE ;
   } else if (MPMaster == _gofOpMode) {
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
     }
+  } else if (MTMaster == _gofOpMode) {
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      _mtGofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
+    // Caches have been rebuilt: the next evaluation initializes them again
+    _mtWarm = kFALSE ;
   }
 }
 
@@ -478,6 +613,81 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create one component test statistic
+/// per partition, each with its own clone of the function and of its share of the data,
+/// but sharing the parameters of this test statistic.
+
+void RooAbsTestStatistic::initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
+{
+  _mtGofArray = new pRooAbsTestStatistic[_nThreads];
+
+  for (Int_t i = 0; i < _nThreads; ++i) {
+    RooAbsData* partData = partitionData(*data,i) ;
+    RooAbsTestStatistic* gof = create(Form("%s_GOF%d",GetName(),i),Form("%s_GOF%d",GetTitle(),i),*real,partData?*partData:*data,*projDeps,
+				      rangeName,addCoefRangeName,1,_mpinterl==RooFit::Interleave?RooFit::Interleave:RooFit::BulkPartition,
+				      _verbose && i==0,_splitRange);
+    gof->recursiveRedirectServers(_paramSet);
+    gof->setMPSet(i,_nThreads);
+    if (partData) {
+      // The component test statistic holds its own copy of the partition
+      gof->_data = data ;
+      gof->_splitData = kTRUE ;
+      delete partData ;
+    }
+    _mtGofArray[i] = gof;
+  }
+  setPartitionSums() ;
+
+#ifdef R__USE_IMT
+  _threadPool = new ROOT::TThreadExecutor(_nThreads);
+#endif
+  _mtWarm = kFALSE;
+  coutI(Eval) << "RooAbsTestStatistic::initMTMode: created " << _nThreads << " partitions evaluated by "
+	      << (_threadPool ? "the thread pool" : "a single thread (no implicit multi-threading support)") << endl;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new dataset with the events of partition setNum of the multi-threaded
+/// calculation mode, a contiguous block of the events of data. A binned dataset is
+/// not split (0 is returned): the partitions then calculate their share of the bins
+/// on their own copy of it.
+
+RooAbsData* RooAbsTestStatistic::partitionData(RooAbsData& data, Int_t setNum) const
+{
+  if (!dynamic_cast<RooDataSet*>(&data)) {
+    return 0 ;
+  }
+  Int_t nEvents = data.numEntries() ;
+  return data.reduce(RooFit::EventRange(nEvents * setNum / _nThreads, nEvents * (setNum+1) / _nThreads)) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Pass the sums of the weights of the data of all partitions of the multi-threaded
+/// calculation mode to each partition, for the terms that depend on the whole data
+/// (e.g. the extended likelihood term)
+
+void RooAbsTestStatistic::setPartitionSums()
+{
+  Double_t sumW(0), sumW2(0) ;
+  for (Int_t i = 0; i < _nThreads; ++i) {
+    Double_t partSumW, partSumW2 ;
+    _mtGofArray[i]->dataWeightSums(partSumW,partSumW2) ;
+    sumW += partSumW ;
+    sumW2 += partSumW2 ;
+  }
+  for (Int_t i = 0; i < _nThreads; ++i) {
+    _mtGofArray[i]->_splitSumW = sumW ;
+    _mtGofArray[i]->_splitSumW2 = sumW2 ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize simultaneous p.d.f processing mode. Strip simultaneous
 /// p.d.f into individual components, split dataset in subset
@@ -600,6 +810,13 @@ void RooAbsTestStatistic::initSimMode(RooSimultaneous* simpdf, RooAbsData* data,
     }
   }
   coutI(Fitting) << "RooAbsTestStatistic::initSimMode: created " << n << " slave calculators." << endl;
+
+#ifdef R__USE_IMT
+  if (_nThreads>1) {
+    _threadPool = new ROOT::TThreadExecutor(_nThreads);
+  }
+#endif
+  _mtWarm = kFALSE;
   
   dsetList->Delete(); // delete the content.
   delete dsetList;
@@ -652,12 +869,26 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
 	}
       }
     }
+    _mtWarm = kFALSE ;
     break;
   case MPMaster:
     // Not supported
     coutF(DataHandling) << "RooAbsTestStatistic::setData(" << GetName() << ") FATAL: setData() is not supported in multi-processor mode" << endl;
     throw string("RooAbsTestStatistic::setData is not supported in MPMaster mode");
     break;
+  case MTMaster:
+    // Each partition needs its own copy of its share of the data
+    initialize();
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      RooAbsData* partData = partitionData(indata,i) ;
+      _mtGofArray[i]->setData(partData?*partData:indata, kTRUE);
+      _mtGofArray[i]->_splitData = partData ? kTRUE : kFALSE ;
+      delete partData ;
+    }
+    setPartitionSums() ;
+    _mtWarm = kFALSE ;
+    setValueDirty() ;
+    break;
   }
 
   return kTRUE;
@@ -694,6 +925,13 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
       _mpfeArray[i]->enableOffsetting(flag);
     }
     break;
+  case MTMaster:
+    _doOffset = flag;
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      _mtGofArray[i]->enableOffsetting(flag);
+    }
+    setValueDirty() ;
+    break;
   }
 }
 
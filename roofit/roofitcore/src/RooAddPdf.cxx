@@ -75,6 +75,7 @@ of each coefficient_i.
 #include "RooGlobalFunc.h"
 #include "RooRealIntegral.h"
 #include "RooTrace.h"
+#include "RooVectorDataStore.h"
 
 #include "Riostream.h"
 #include <algorithm>
@@ -860,6 +861,51 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(). The coefficients are calculated once and the
+/// component p.d.f.s are evaluated in batch. Coefficients that depend on the data
+/// and supplemental normalization terms are not supported.
+
+Bool_t RooAddPdf::evaluateBatch(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store) const
+{
+  RooFIter ci = _coefList.fwdIterator() ;
+  RooAbsReal* coef ;
+  while((coef = (RooAbsReal*)ci.next())) {
+    if (coef->dependsOnValue(*store.get())) return kFALSE ;
+  }
+
+  const RooArgSet* nset = _normSet ; 
+  if (nset==0 || nset->getSize()==0) {
+    if (_refCoefNorm.getSize()!=0) {
+      nset = &_refCoefNorm ;
+    }
+  }
+
+  CacheElem* cache = getProjCache(nset) ;
+  if (cache->_needSupNorm) return kFALSE ;
+  updateCoefficients(*cache,nset) ;
+
+  std::fill(output,output+nEvents,0.) ;
+  std::vector<Double_t> pdfVals(nEvents) ;
+
+  RooAbsPdf* pdf ;
+  Int_t i(0) ;
+  RooFIter pi = _pdfList.fwdIterator() ;
+  while((pdf = (RooAbsPdf*)pi.next())) {
+    if (pdf->isSelectedComp()) {
+      pdf->getValBatch(&pdfVals[0],begin,nEvents,store,nset) ;
+      for (Int_t j=0 ; j<nEvents ; j++) {
+	output[j] += pdfVals[j]*_coefCache[i] ;
+      }
+    }
+    i++ ;
+  }
+
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset error counter to given value, limiting the number
 /// of future error messages for this pdf to 'resetValue'
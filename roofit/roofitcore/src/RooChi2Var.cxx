@@ -62,11 +62,14 @@ RooChi2Var::RooChi2Var(const char *name, const char* title, RooAbsReal& func, Ro
 			 RooCmdConfig::decodeIntOnTheFly("RooChi2Var::RooChi2Var","NumCPU",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
 			 RooFit::Interleave,
 			 RooCmdConfig::decodeIntOnTheFly("RooChi2Var::RooChi2Var","Verbose",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
-			 0)
+			 0,
+			 kTRUE,
+			 RooCmdConfig::decodeIntOnTheFly("RooChi2Var::RooChi2Var","NumThreads",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9))
   //  RooChi2Var constructor. Optional arguments taken
   //
   //  DataError()  -- Choose between Poisson errors and Sum-of-weights errors
   //  NumCPU()     -- Activate parallel processing feature
+  //  NumThreads() -- Parallelize the calculation over the given number of threads
   //  Range()      -- Fit only selected region
   //  Verbose()    -- Verbose output of GOF framework
 {
@@ -108,12 +111,15 @@ RooChi2Var::RooChi2Var(const char *name, const char* title, RooAbsPdf& pdf, RooD
 			 RooCmdConfig::decodeIntOnTheFly("RooChi2Var::RooChi2Var","NumCPU",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
 			 RooFit::Interleave,
 			 RooCmdConfig::decodeIntOnTheFly("RooChi2Var::RooChi2Var","Verbose",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
-			 RooCmdConfig::decodeIntOnTheFly("RooChi2Var::RooChi2Var","SplitRange",0,0,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9))             
+			 RooCmdConfig::decodeIntOnTheFly("RooChi2Var::RooChi2Var","SplitRange",0,0,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
+			 kTRUE,
+			 RooCmdConfig::decodeIntOnTheFly("RooChi2Var::RooChi2Var","NumThreads",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9))
   //  RooChi2Var constructor. Optional arguments taken
   //
   //  Extended()   -- Include extended term in calculation
   //  DataError()  -- Choose between Poisson errors and Sum-of-weights errors
   //  NumCPU()     -- Activate parallel processing feature
+  //  NumThreads() -- Parallelize the calculation over the given number of threads
   //  Range()      -- Fit only selected region
   //  SumCoefRange() -- Set the range in which to interpret the coefficients of RooAddPdf components 
   //  SplitRange() -- Fit range is split by index catory of simultaneous PDF
@@ -152,12 +158,13 @@ RooChi2Var::RooChi2Var(const char *name, const char* title, RooAbsPdf& pdf, RooD
 /// in binned datasets with many (adjacent) zero bins. If
 /// splitCutRange is true the cutRange is used to construct an
 /// individual cutRange for each RooSimultaneous index category state
-/// name cutRange_{indexStateName}.
+/// name cutRange_{indexStateName}. If nThreads is greater than one
+/// the bins are instead partitioned over nThreads threads of this process.
 
 RooChi2Var::RooChi2Var(const char *name, const char *title, RooAbsPdf& pdf, RooDataHist& hdata,
 		       Bool_t extended, const char* cutRange, const char* addCoefRange,
-		       Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange, RooDataHist::ErrorType etype) : 
-  RooAbsOptTestStatistic(name,title,pdf,hdata,RooArgSet(),cutRange,addCoefRange,nCPU,interleave,verbose,splitCutRange),
+		       Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange, RooDataHist::ErrorType etype, Int_t nThreads) : 
+  RooAbsOptTestStatistic(name,title,pdf,hdata,RooArgSet(),cutRange,addCoefRange,nCPU,interleave,verbose,splitCutRange,kTRUE,nThreads),
    _etype(etype), _funcMode(extended?ExtendedPdf:Pdf)
 {
 }
@@ -179,12 +186,13 @@ RooChi2Var::RooChi2Var(const char *name, const char *title, RooAbsPdf& pdf, RooD
 /// in binned datasets with many (adjacent) zero bins. If
 /// splitCutRange is true the cutRange is used to construct an
 /// individual cutRange for each RooSimultaneous index category state
-/// name cutRange_{indexStateName}.
+/// name cutRange_{indexStateName}. If nThreads is greater than one
+/// the bins are instead partitioned over nThreads threads of this process.
 
 RooChi2Var::RooChi2Var(const char *name, const char *title, RooAbsReal& func, RooDataHist& hdata,
 		       const RooArgSet& projDeps, RooChi2Var::FuncMode fmode, const char* cutRange, const char* addCoefRange, 
-		       Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange, RooDataHist::ErrorType etype) : 
-  RooAbsOptTestStatistic(name,title,func,hdata,projDeps,cutRange,addCoefRange,nCPU,interleave,verbose,splitCutRange),
+		       Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange, RooDataHist::ErrorType etype, Int_t nThreads) : 
+  RooAbsOptTestStatistic(name,title,func,hdata,projDeps,cutRange,addCoefRange,nCPU,interleave,verbose,splitCutRange,kTRUE,nThreads),
   _etype(etype), _funcMode(fmode)
 {
 }
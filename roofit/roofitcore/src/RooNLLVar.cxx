@@ -43,6 +43,7 @@ In extended mode, a (Nexpect - Nobserved*log(NExpected) term is added
 #include "RooRealSumPdf.h"
 #include "RooRealVar.h"
 #include "RooProdPdf.h"
+#include "RooVectorDataStore.h"
 
 ClassImp(RooNLLVar);
 ;
@@ -63,6 +64,8 @@ RooArgSet RooNLLVar::_emptySet ;
 ///  ConditionalObservables() | Define conditional observables
 ///  Verbose()                | Verbose output of GOF framework classes
 ///  CloneData()              | Clone input dataset for internal use (default is kTRUE)
+///  NumThreads()             | Parallelize NLL calculation over given number of threads
+///  BatchMode()              | Evaluate the p.d.f in batches of events (unweighted data in a vector store only)
 
 RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& indata,
 		     const RooCmdArg& arg1, const RooCmdArg& arg2,const RooCmdArg& arg3,
@@ -77,17 +80,20 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
 			 RooFit::BulkPartition,
 			 RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","Verbose",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
 			 RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","SplitRange",0,0,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
-			 RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","CloneData",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9))
+			 RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","CloneData",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
+			 RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","NumThreads",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9))
 {
   RooCmdConfig pc("RooNLLVar::RooNLLVar") ;
   pc.allowUndefined() ;
   pc.defineInt("extended","Extended",0,kFALSE) ;
+  pc.defineInt("batchMode","BatchMode",0,kFALSE) ;
 
   pc.process(arg1) ;  pc.process(arg2) ;  pc.process(arg3) ;
   pc.process(arg4) ;  pc.process(arg5) ;  pc.process(arg6) ;
   pc.process(arg7) ;  pc.process(arg8) ;  pc.process(arg9) ;
 
   _extended = pc.getInt("extended") ;
+  _batchMode = pc.getInt("batchMode") ;
   _weightSq = kFALSE ;
   _first = kTRUE ;
   _offset = 0.;
@@ -106,10 +112,11 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
 
 RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbsData& indata,
 		     Bool_t extended, const char* rangeName, const char* addCoefRangeName,
-		     Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitRange, Bool_t cloneData, Bool_t binnedL) :
-  RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
+		     Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitRange, Bool_t cloneData, Bool_t binnedL, Int_t nThreads, Bool_t batchMode) :
+  RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData,nThreads),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchMode(batchMode),
   _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
@@ -151,10 +158,11 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
 
 RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbsData& indata,
 		     const RooArgSet& projDeps, Bool_t extended, const char* rangeName,const char* addCoefRangeName,
-		     Int_t nCPU,RooFit::MPSplit interleave,Bool_t verbose, Bool_t splitRange, Bool_t cloneData, Bool_t binnedL) :
-  RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
+		     Int_t nCPU,RooFit::MPSplit interleave,Bool_t verbose, Bool_t splitRange, Bool_t cloneData, Bool_t binnedL, Int_t nThreads, Bool_t batchMode) :
+  RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData,nThreads),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchMode(batchMode),
   _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
@@ -194,6 +202,7 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   RooAbsOptTestStatistic(other,name),
   _extended(other._extended),
   _weightSq(other._weightSq),
+  _batchMode(other._batchMode),
   _first(kTRUE), _offsetSaveW2(other._offsetSaveW2),
   _offsetCarrySaveW2(other._offsetCarrySaveW2),
   _binw(other._binw) {
@@ -230,6 +239,9 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
   } else if ( _gofOpMode==SimMaster) {
     for (Int_t i=0 ; i<_nGof ; i++)
       ((RooNLLVar*)_gofArray[i])->applyWeightSquared(flag);
+  } else if ( _gofOpMode==MTMaster) {
+    for (Int_t i=0 ; i<_nCPU ; i++)
+      ((RooNLLVar*)_mtGofArray[i])->applyWeightSquared(flag);
   }
 }
 
@@ -304,6 +316,54 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
     }
 
 
+  } else if (_batchMode && stepSize==1 && !_weightSq && !_dataClone->isWeighted() && dynamic_cast<RooVectorDataStore*>(_dataClone->store())) {
+
+    // Evaluate the p.d.f in batches of events directly on the columns of the store,
+    // rather than loading each event and propagating it through the expression tree
+    const RooVectorDataStore& vstore = *static_cast<RooVectorDataStore*>(_dataClone->store()) ;
+    const Int_t batchSize = 1024 ;
+    _batchProbs.resize(batchSize) ;
+
+    for (Int_t first=firstEvent ; first<lastEvent ; first+=batchSize) {
+
+      const Int_t nEvents = std::min(batchSize,lastEvent-first) ;
+      pdfClone->getValBatch(&_batchProbs[0],first,nEvents,vstore,_normSet) ;
+
+      for (i=0 ; i<nEvents ; i++) {
+
+	Double_t logProb ;
+	if (_batchProbs[i]>0 && _batchProbs[i]<=1e6) {
+	  logProb = log(_batchProbs[i]) ;
+	} else {
+	  // Let getLogVal() handle and report the problematic values
+	  _dataClone->get(first+i) ;
+	  logProb = pdfClone->getLogVal(_normSet) ;
+	}
+	Double_t term = -logProb ;
+
+	// Unweighted data: all event weights are one
+	Double_t y = 1. - sumWeightCarry;
+	Double_t t = sumWeight + y;
+	sumWeightCarry = (t - sumWeight) - y;
+	sumWeight = t;
+
+	y = term - carry;
+	t = result + y;
+	carry = (t - result) - y;
+	result = t;
+      }
+    }
+
+    // include the extended maximum likelihood term, if requested
+    if(_extended && _setNum==_extSet) {
+      // The data of a partition of a multi-threaded calculation holds only part of the events
+      const Double_t sumEntries = _splitData ? _splitSumW : _dataClone->sumEntries() ;
+      Double_t y = pdfClone->extendedTerm(sumEntries, _dataClone->get()) - carry;
+      Double_t t = result + y;
+      carry = (t - result) - y;
+      result = t;
+    }
+
   } else {
 
     for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
@@ -332,16 +392,22 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
     // include the extended maximum likelihood term, if requested
     if(_extended && _setNum==_extSet) {
+      // The data of a partition of a multi-threaded calculation holds only part of the events
+      const Double_t sumEntries = _splitData ? _splitSumW : _dataClone->sumEntries() ;
       if (_weightSq) {
 
 	// Calculate sum of weights-squared here for extended term
 	Double_t sumW2(0), sumW2carry(0);
-	for (i=0 ; i<_dataClone->numEntries() ; i++) {
-	  _dataClone->get(i);
-	  Double_t y = _dataClone->weightSquared() - sumW2carry;
-	  Double_t t = sumW2 + y;
-	  sumW2carry = (t - sumW2) - y;
-	  sumW2 = t;
+	if (_splitData) {
+	  sumW2 = _splitSumW2 ;
+	} else {
+	  for (i=0 ; i<_dataClone->numEntries() ; i++) {
+	    _dataClone->get(i);
+	    Double_t y = _dataClone->weightSquared() - sumW2carry;
+	    Double_t t = sumW2 + y;
+	    sumW2carry = (t - sumW2) - y;
+	    sumW2 = t;
+	  }
 	}
 
 	Double_t expected= pdfClone->expectedEvents(_dataClone->get());
@@ -362,7 +428,7 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
         //  sum[w^2] / sum[w] * expected - sum[w^2] * log (expectedW)
         //  and since the weights are constants in the likelihood we can use log(expected) instead of log(expectedW)
 
-	Double_t expectedW2 = expected * sumW2 / _dataClone->sumEntries() ;
+	Double_t expectedW2 = expected * sumW2 / sumEntries ;
 	Double_t extra= expectedW2 - sumW2*log(expected );
 
 	// Double_t y = pdfClone->extendedTerm(sumW2, _dataClone->get()) - carry;
@@ -373,7 +439,7 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 	carry = (t - result) - y;
 	result = t;
       } else {
-	Double_t y = pdfClone->extendedTerm(_dataClone->sumEntries(), _dataClone->get()) - carry;
+	Double_t y = pdfClone->extendedTerm(sumEntries, _dataClone->get()) - carry;
 	Double_t t = result + y;
 	carry = (t - result) - y;
 	result = t;
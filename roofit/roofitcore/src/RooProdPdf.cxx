@@ -57,6 +57,7 @@ have to appear in any specific place in the list.
 #include "RooCustomizer.h"
 #include "RooRealIntegral.h"
 #include "RooTrace.h"
+#include "RooVectorDataStore.h"
 
 #include <cstring>
 #include <sstream>
@@ -495,6 +496,59 @@ Double_t RooProdPdf::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Overload getValBatch to track the normalization set used
+
+void RooProdPdf::getValBatch(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store, const RooArgSet* normSet) const
+{
+  _curNormSet = (RooArgSet*)normSet ;
+  RooAbsPdf::getValBatch(output,begin,nEvents,store,normSet) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): running product of the batch values of the
+/// terms. Rearranged products are evaluated event by event.
+
+Bool_t RooProdPdf::evaluateBatch(Double_t* output, Int_t begin, Int_t nEvents, const RooVectorDataStore& store) const
+{
+  Int_t code ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+
+  // If cache doesn't have our configuration, recalculate here
+  if (!cache) {
+    RooArgList *plist(0) ;
+    RooLinkedList *nlist(0) ;
+    getPartIntList(_curNormSet,0,plist,nlist,code) ;
+    cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  }
+
+  if (cache->_isRearranged) return kFALSE ;
+
+  std::fill(output,output+nEvents,1.0) ;
+  std::vector<Double_t> piVals(nEvents) ;
+
+  RooAbsReal* partInt;
+  RooArgSet* normSet;
+  RooFIter plIter = cache->_partList.fwdIterator();
+  RooFIter nlIter = cache->_normList.fwdIterator();
+  for (partInt = (RooAbsReal*) plIter.next(),
+	 normSet = (RooArgSet*) nlIter.next(); partInt && normSet;
+       partInt = (RooAbsReal*) plIter.next(),
+	 normSet = (RooArgSet*) nlIter.next()) {
+    partInt->getValBatch(&piVals[0],begin,nEvents,store,normSet->getSize() > 0 ? normSet : 0) ;
+    for (Int_t i=0 ; i<nEvents ; i++) {
+      // Events that fell below the cut-off keep their value, as in calculate()
+      if (output[i] > _cutOff) output[i] *= piVals[i] ;
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate running product of pdfs terms, using the supplied
 /// normalization set in 'normSetList' for each component
@@ -44,6 +44,7 @@ Object          | function
 #include "RooDouble.h"
 #include "RooTrace.h"
 #include "RooRandom.h"
+#include "RooRealVar.h"
 #include <math.h>
 
 ClassImp(RooUnitTest);
@@ -208,6 +209,34 @@ Bool_t RooUnitTest::areTHidentical(TH1* htest, TH1* href)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compare the values of two calculations ref and test of the same quantity,
+/// e.g. a likelihood evaluated without and with an evaluation option, at the
+/// current value of par and at newVal. The values must agree within the relative
+/// tolerance relTol. The value of par is restored afterwards. Returns kTRUE
+/// if the values agree, otherwise prints both values with testDesc describing
+/// how test was calculated.
+
+Bool_t RooUnitTest::compareValues(RooAbsReal& ref, RooAbsReal& test, RooRealVar& par, Double_t newVal, Double_t relTol, const char* testDesc)
+{
+  Bool_t ok(kTRUE) ;
+  Double_t oldVal = par.getVal() ;
+  for (Int_t i=0 ; i<2 ; i++) {
+    if (i==1) par.setVal(newVal) ;
+    Double_t val = ref.getVal() ;
+    Double_t valTest = test.getVal() ;
+    if (val!=valTest && !(fabs(valTest-val)<=relTol*fabs(val))) {
+      cout << "RooUnitTest(" << GetName() << "): " << ref.GetName() << " at " << par.GetName() << "=" << par.getVal()
+	   << " is " << val << " but " << valTest << " " << testDesc << endl ;
+      ok = kFALSE ;
+    }
+  }
+  par.setVal(oldVal) ;
+  return ok ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Bool_t RooUnitTest::runCompTests()
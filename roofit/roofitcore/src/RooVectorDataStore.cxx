@@ -620,6 +620,25 @@ const RooArgSet* RooVectorDataStore::getNative(Int_t index) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the first element of the column holding the values that
+/// are loaded into the given object by get(), or a null pointer if the object is not
+/// attached to this store. Columns of the optimization cache are also searched, so
+/// that cached nodes of a function attached to the store are found as well.
+
+const Double_t* RooVectorDataStore::realColumn(const RooAbsReal& real) const
+{
+  for (Int_t i=0 ; i<_nReal ; i++) {
+    if ((*(_firstReal+i))->_real==&real) return (*(_firstReal+i))->_vec0 ;
+  }
+  for (Int_t i=0 ; i<_nRealF ; i++) {
+    if ((*(_firstRealF+i))->_real==&real) return (*(_firstRealF+i))->_vec0 ;
+  }
+  return _cache ? _cache->realColumn(real) : 0 ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the weight of the n-th data point (n='index') in memory
 
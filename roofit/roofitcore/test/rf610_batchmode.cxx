@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////
+//
+// 'LIKELIHOOD AND MINIMIZATION' RooFit tutorial macro #610
+//
+// Evaluation of the likelihood in batches of events with BatchMode()
+//
+//
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooPolynomial.h"
+#include "RooPolyVar.h"
+#include "RooAddPdf.h"
+#include "RooProdPdf.h"
+#include "RooConstVar.h"
+#include "TMath.h"
+using namespace RooFit ;
+
+
+class TestBasic610 : public RooFitTestUnit
+{
+public:
+  TestBasic610(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooFitTestUnit("Likelihood evaluation in batches",refFile,writeRef,verbose) {} ;
+
+  // Compare the likelihood of pdf evaluated event by event and in batches,
+  // before and after changing the value of parameter par
+  Bool_t compareNLL(RooAbsPdf& pdf, RooDataSet& data, RooRealVar& par, Double_t newVal,
+		    const RooCmdArg& arg=RooCmdArg::none()) {
+
+    RooAbsReal* nll = pdf.createNLL(data,arg) ;
+    RooAbsReal* nllBatch = pdf.createNLL(data,arg,BatchMode()) ;
+
+    Bool_t ok = compareValues(*nll,*nllBatch,par,newVal,1e-12,"in batch mode") ;
+
+    delete nll ;
+    delete nllBatch ;
+    return ok ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l   a n d   d a t a
+  // ------------------------------------------
+
+  RooRealVar x("x","x",0,10) ;
+  RooRealVar y("y","y",0,5) ;
+
+  RooRealVar mean("mean","mean",4,0,10) ;
+  RooRealVar sigma("sigma","sigma",1.5,0.1,10) ;
+  RooGaussian gauss("gauss","gauss",x,mean,sigma) ;
+
+  RooRealVar c("c","c",-0.3,-10.,0.) ;
+  RooExponential expo("expo","expo",x,c) ;
+
+  RooRealVar a1("a1","a1",-0.05,-1,1) ;
+  RooRealVar a2("a2","a2",0.004,-1,1) ;
+  RooPolynomial poly("poly","poly",x,RooArgList(a1,a2)) ;
+
+  RooRealVar frac("frac","frac",0.3,0,1) ;
+  RooAddPdf sum("sum","sum",RooArgList(gauss,expo),frac) ;
+
+  RooRealVar meany("meany","meany",2,0,5) ;
+  RooRealVar sigmay("sigmay","sigmay",1) ;
+  RooGaussian gaussy("gaussy","gaussy",y,meany,sigmay) ;
+  RooProdPdf prod("prod","prod",RooArgList(sum,gaussy)) ;
+
+  // Several batches of events, the last one partially filled
+  RooDataSet* data = prod.generate(RooArgSet(x,y),5000) ;
+
+
+  // P . d . f . s   e v a l u a t e d   i n   b a t c h e s
+  // --------------------------------------------------------
+
+  Bool_t ok(kTRUE) ;
+  ok &= compareNLL(gauss,*data,mean,5) ;
+  ok &= compareNLL(expo,*data,c,-0.5) ;
+  ok &= compareNLL(poly,*data,a2,0.006) ;
+  ok &= compareNLL(sum,*data,frac,0.6) ;
+  ok &= compareNLL(prod,*data,meany,2.5) ;
+
+
+  // F a l l b a c k s   t o   e v a l u a t i o n   p e r   e v e n t
+  // -----------------------------------------------------------------
+
+  // Coefficient of the sum depending on the data
+  RooRealVar b("b","b",0.1,0,0.16) ;
+  RooPolyVar fy("fy","fy",y,RooArgList(RooConst(0.2),b)) ;
+  RooAddPdf sumy("sumy","sumy",RooArgList(gauss,expo),fy) ;
+  ok &= compareNLL(sumy,*data,b,0.15,ConditionalObservables(y)) ;
+
+  // Normalization depending on the data: conditional p.d.f with a mean depending on y
+  RooRealVar slope("slope","slope",1,0,2) ;
+  RooPolyVar meanxy("meanxy","meanxy",y,RooArgList(RooConst(2),slope)) ;
+  RooGaussian gaussxy("gaussxy","gaussxy",x,meanxy,sigma) ;
+  ok &= compareNLL(gaussxy,*data,slope,1.2,ConditionalObservables(y)) ;
+
+  // Negative values of the polynomial for x>5.7 and NaN values of the Gaussian.
+  // The evaluation errors are counted rather than printed.
+  RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::CountErrors) ;
+  ok &= compareNLL(poly,*data,a1,-0.2) ;
+  ok &= compareNLL(gauss,*data,sigma,TMath::QuietNaN()) ;
+  RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
+  RooAbsReal::clearEvalErrorLog() ;
+
+  delete data ;
+
+  return ok ;
+  }
+} ;
@@ -155,6 +155,8 @@ Int_t stressRooFit(const char* refFile, Bool_t writeRef, Int_t doVerbose, Int_t
   testList.push_back(new TestBasic606(fref,writeRef,doVerbose)) ;
   testList.push_back(new TestBasic607(fref,writeRef,doVerbose)) ;
   testList.push_back(new TestBasic609(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic610(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic611(fref,writeRef,doVerbose)) ;
   testList.push_back(new TestBasic701(fref,writeRef,doVerbose)) ;
   testList.push_back(new TestBasic702(fref,writeRef,doVerbose)) ;
   testList.push_back(new TestBasic703(fref,writeRef,doVerbose)) ;
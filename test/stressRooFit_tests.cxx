@@ -4961,7 +4961,310 @@ public:
 
 
 
-//////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// 'LIKELIHOOD AND MINIMIZATION' RooFit tutorial macro #610
+//
+// Evaluation of the likelihood in batches of events with BatchMode()
+//
+//
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooPolynomial.h"
+#include "RooPolyVar.h"
+#include "RooAddPdf.h"
+#include "RooProdPdf.h"
+#include "RooConstVar.h"
+#include "TMath.h"
+using namespace RooFit ;
+
+
+class TestBasic610 : public RooUnitTest
+{
+public:
+  TestBasic610(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Likelihood evaluation in batches",refFile,writeRef,verbose) {} ;
+
+  // Compare the likelihood of pdf evaluated event by event and in batches,
+  // before and after changing the value of parameter par
+  Bool_t compareNLL(RooAbsPdf& pdf, RooDataSet& data, RooRealVar& par, Double_t newVal,
+		    const RooCmdArg& arg=RooCmdArg::none()) {
+
+    RooAbsReal* nll = pdf.createNLL(data,arg) ;
+    RooAbsReal* nllBatch = pdf.createNLL(data,arg,BatchMode()) ;
+
+    Bool_t ok = compareValues(*nll,*nllBatch,par,newVal,1e-12,"in batch mode") ;
+
+    delete nll ;
+    delete nllBatch ;
+    return ok ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l   a n d   d a t a
+  // ------------------------------------------
+
+  RooRealVar x("x","x",0,10) ;
+  RooRealVar y("y","y",0,5) ;
+
+  RooRealVar mean("mean","mean",4,0,10) ;
+  RooRealVar sigma("sigma","sigma",1.5,0.1,10) ;
+  RooGaussian gauss("gauss","gauss",x,mean,sigma) ;
+
+  RooRealVar c("c","c",-0.3,-10.,0.) ;
+  RooExponential expo("expo","expo",x,c) ;
+
+  RooRealVar a1("a1","a1",-0.05,-1,1) ;
+  RooRealVar a2("a2","a2",0.004,-1,1) ;
+  RooPolynomial poly("poly","poly",x,RooArgList(a1,a2)) ;
+
+  RooRealVar frac("frac","frac",0.3,0,1) ;
+  RooAddPdf sum("sum","sum",RooArgList(gauss,expo),frac) ;
+
+  RooRealVar meany("meany","meany",2,0,5) ;
+  RooRealVar sigmay("sigmay","sigmay",1) ;
+  RooGaussian gaussy("gaussy","gaussy",y,meany,sigmay) ;
+  RooProdPdf prod("prod","prod",RooArgList(sum,gaussy)) ;
+
+  // Several batches of events, the last one partially filled
+  RooDataSet* data = prod.generate(RooArgSet(x,y),5000) ;
+
+
+  // P . d . f . s   e v a l u a t e d   i n   b a t c h e s
+  // --------------------------------------------------------
+
+  Bool_t ok(kTRUE) ;
+  ok &= compareNLL(gauss,*data,mean,5) ;
+  ok &= compareNLL(expo,*data,c,-0.5) ;
+  ok &= compareNLL(poly,*data,a2,0.006) ;
+  ok &= compareNLL(sum,*data,frac,0.6) ;
+  ok &= compareNLL(prod,*data,meany,2.5) ;
+
+
+  // F a l l b a c k s   t o   e v a l u a t i o n   p e r   e v e n t
+  // -----------------------------------------------------------------
+
+  // Coefficient of the sum depending on the data
+  RooRealVar b("b","b",0.1,0,0.16) ;
+  RooPolyVar fy("fy","fy",y,RooArgList(RooConst(0.2),b)) ;
+  RooAddPdf sumy("sumy","sumy",RooArgList(gauss,expo),fy) ;
+  ok &= compareNLL(sumy,*data,b,0.15,ConditionalObservables(y)) ;
+
+  // Normalization depending on the data: conditional p.d.f with a mean depending on y
+  RooRealVar slope("slope","slope",1,0,2) ;
+  RooPolyVar meanxy("meanxy","meanxy",y,RooArgList(RooConst(2),slope)) ;
+  RooGaussian gaussxy("gaussxy","gaussxy",x,meanxy,sigma) ;
+  ok &= compareNLL(gaussxy,*data,slope,1.2,ConditionalObservables(y)) ;
+
+  // Negative values of the polynomial for x>5.7 and NaN values of the Gaussian.
+  // The evaluation errors are counted rather than printed.
+  RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::CountErrors) ;
+  ok &= compareNLL(poly,*data,a1,-0.2) ;
+  ok &= compareNLL(gauss,*data,sigma,TMath::QuietNaN()) ;
+  RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
+  RooAbsReal::clearEvalErrorLog() ;
+
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// 'LIKELIHOOD AND MINIMIZATION' RooFit tutorial macro #611
+//
+// Multi-threaded calculation of the likelihood with NumThreads()
+//
+//
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooDataHist.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooAddPdf.h"
+#include "RooFormulaVar.h"
+#include "RooCategory.h"
+#include "RooSimultaneous.h"
+#include "RooFitResult.h"
+using namespace RooFit ;
+
+
+class TestBasic611 : public RooUnitTest
+{
+public:
+  TestBasic611(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Multi-threaded likelihood evaluation",refFile,writeRef,verbose) {} ;
+
+  // Compare the likelihood of pdf calculated by a single thread and by several threads,
+  // before and after changing the value of parameter par
+  Bool_t compareNLL(RooAbsPdf& pdf, RooAbsData& data, RooRealVar& par, Double_t newVal,
+		    const RooCmdArg& arg1=RooCmdArg::none(), const RooCmdArg& arg2=RooCmdArg::none()) {
+
+    RooAbsReal* nll = pdf.createNLL(data,arg1,arg2) ;
+    RooAbsReal* nllMT = pdf.createNLL(data,arg1,arg2,NumThreads(4)) ;
+
+    // The partitions are summed in a different order
+    Bool_t ok = compareValues(*nll,*nllMT,par,newVal,1e-10,"with 4 threads") ;
+
+    delete nll ;
+    delete nllMT ;
+    return ok ;
+  }
+
+  // Compare the chi^2 of pdf calculated by a single thread and by several threads,
+  // before and after changing the value of parameter par
+  Bool_t compareChi2(RooAbsPdf& pdf, RooDataHist& data, RooRealVar& par, Double_t newVal,
+		     const RooCmdArg& arg=RooCmdArg::none()) {
+
+    RooAbsReal* chi2 = pdf.createChi2(data,arg) ;
+    RooAbsReal* chi2MT = pdf.createChi2(data,arg,NumThreads(4)) ;
+
+    Bool_t ok = compareValues(*chi2,*chi2MT,par,newVal,1e-10,"with 4 threads") ;
+
+    delete chi2 ;
+    delete chi2MT ;
+    return ok ;
+  }
+
+  // Compare the result of the fit of pdf calculated by a single thread and by several threads
+  Bool_t compareFit(RooAbsPdf& pdf, RooAbsData& data, const RooCmdArg& arg=RooCmdArg::none()) {
+
+    RooArgSet* params = pdf.getParameters(data) ;
+    RooArgSet* initParams = (RooArgSet*) params->snapshot() ;
+
+    RooFitResult* r = pdf.fitTo(data,arg,Save(),PrintLevel(-1)) ;
+    *params = *initParams ;
+    RooFitResult* rMT = pdf.fitTo(data,arg,NumThreads(4),Save(),PrintLevel(-1)) ;
+    *params = *initParams ;
+
+    Bool_t ok = (r->status()==0 && rMT->status()==0) ;
+    if (!ok) {
+      cout << "TestBasic611: fit of " << pdf.GetName() << " has status " << r->status()
+	   << " but " << rMT->status() << " with 4 threads" << endl ;
+    }
+    for (Int_t i=0 ; ok && i<r->floatParsFinal().getSize() ; i++) {
+      RooRealVar* par = (RooRealVar*) r->floatParsFinal().at(i) ;
+      RooRealVar* parMT = (RooRealVar*) rMT->floatParsFinal().find(par->GetName()) ;
+      if (!parMT || fabs(parMT->getVal()-par->getVal())>1e-3*par->getError()
+	  || fabs(parMT->getError()-par->getError())>1e-3*par->getError()) {
+	cout << "TestBasic611: fit of " << pdf.GetName() << " gives " << par->GetName() << " = "
+	     << par->getVal() << " +/- " << par->getError() << " but " << (parMT ? parMT->getVal() : 0.)
+	     << " +/- " << (parMT ? parMT->getError() : 0.) << " with 4 threads" << endl ;
+	ok = kFALSE ;
+      }
+    }
+
+    delete r ;
+    delete rMT ;
+    delete initParams ;
+    delete params ;
+    return ok ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l   a n d   d a t a
+  // ------------------------------------------
+
+  RooRealVar x("x","x",0,10) ;
+  x.setRange("signal",2,6) ;
+
+  RooRealVar mean("mean","mean",4,0,10) ;
+  RooRealVar sigma("sigma","sigma",1.5,0.1,10) ;
+  RooGaussian gauss("gauss","gauss",x,mean,sigma) ;
+
+  RooRealVar c("c","c",-0.3,-10.,0.) ;
+  RooExponential expo("expo","expo",x,c) ;
+
+  RooRealVar frac("frac","frac",0.3,0,1) ;
+  RooAddPdf sum("sum","sum",RooArgList(gauss,expo),frac) ;
+
+  RooRealVar nsig("nsig","nsig",600,0,5000) ;
+  RooRealVar nbkg("nbkg","nbkg",1400,0,5000) ;
+  RooAddPdf esum("esum","esum",RooArgList(gauss,expo),RooArgList(nsig,nbkg)) ;
+
+  // A number of events that does not divide evenly among the threads
+  RooDataSet* data = sum.generate(x,2003) ;
+
+  // Weighted copy of the data
+  RooDataSet* wdata0 = (RooDataSet*) data->Clone("wdata0") ;
+  RooFormulaVar wFunc("w","event weight","(x*x+10)/50",x) ;
+  RooRealVar* w = (RooRealVar*) wdata0->addColumn(wFunc) ;
+  RooDataSet* wdata = new RooDataSet("wdata","weighted data",wdata0,RooArgSet(x,*w),0,w->GetName()) ;
+
+  // Simultaneous p.d.f. of a signal and a control sample sharing the mean
+  RooRealVar sigmaCtl("sigmaCtl","sigmaCtl",2,0.1,10) ;
+  RooGaussian gaussCtl("gaussCtl","gaussCtl",x,mean,sigmaCtl) ;
+  RooDataSet* dataCtl = gaussCtl.generate(x,1001) ;
+
+  RooCategory sample("sample","sample") ;
+  sample.defineType("physics") ;
+  sample.defineType("control") ;
+  RooDataSet combData("combData","combined data",x,Index(sample),Import("physics",*data),Import("control",*dataCtl)) ;
+
+  RooSimultaneous simPdf("simPdf","simultaneous pdf",sample) ;
+  simPdf.addPdf(sum,"physics") ;
+  simPdf.addPdf(gaussCtl,"control") ;
+
+
+  // L i k e l i h o o d   v a l u e s
+  // ----------------------------------
+
+  Bool_t ok(kTRUE) ;
+  ok &= compareNLL(gauss,*data,mean,5) ;
+  ok &= compareNLL(sum,*data,frac,0.6) ;
+  ok &= compareNLL(esum,*data,nsig,800,Extended()) ;
+  ok &= compareNLL(esum,*wdata,nbkg,1200,Extended()) ;
+  ok &= compareNLL(sum,*data,mean,5,Range("signal")) ;
+  ok &= compareNLL(simPdf,combData,mean,5) ;
+
+
+  // C h i 2   v a l u e s
+  // ----------------------
+
+  // The bins of a binned dataset are partitioned over the threads
+  RooDataHist* hdata = data->binnedClone() ;
+  ok &= compareChi2(sum,*hdata,frac,0.6) ;
+  ok &= compareChi2(esum,*hdata,nsig,800,Extended()) ;
+
+
+  // F i t   r e s u l t s
+  // ---------------------
+
+  ok &= compareFit(sum,*data) ;
+  ok &= compareFit(esum,*data,Extended()) ;
+  ok &= compareFit(esum,*wdata,SumW2Error(kTRUE)) ;
+  ok &= compareFit(simPdf,combData) ;
+
+  delete hdata ;
+  delete dataCtl ;
+  delete wdata ;
+  delete wdata0 ;
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+
+////////////////////////////////////////////////////////////
 //
 // 'SPECIAL PDFS' RooFit tutorial macro #701
 //
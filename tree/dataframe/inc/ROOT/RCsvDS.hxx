@@ -33,6 +33,7 @@ private:
    static const std::map<ColType_t, std::string> fgColTypeMap;
 
    unsigned int fNSlots = 0U;
+   const std::string fFileName;
    std::ifstream fStream;
    const char fDelimiter;
    const Long64_t fLinesChunkSize;
@@ -69,6 +70,7 @@ public:
    const std::vector<std::string> &GetColumnNames() const;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges();
    std::string GetTypeName(std::string_view colName) const;
+   std::string GetDatasetIdentity() const;
    bool HasColumn(std::string_view colName) const;
    bool SetEntry(unsigned int slot, ULong64_t entry);
    void SetNSlots(unsigned int nSlots);
@@ -12,6 +12,7 @@
 #define ROOT_RDFOPERATIONS
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <memory>
 #include <stack>
@@ -37,6 +38,10 @@
 #include "TDirectory.h"
 #include "TFile.h" // for SnapshotHelper
 #include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
 #include "TGraph.h"
 #include "TLeaf.h"
 #include "TObjArray.h"
@@ -205,6 +210,26 @@ public:
       }
    }
 
+   /// Bulk mode: values of a block of entries that passed the filters.
+   /// The block is appended to the buffer in one go, the buffers are filled into the histogram with TH1::FillN.
+   template <typename T>
+   void ExecBulk(unsigned int slot, const RVec<T> &vs)
+   {
+      for (auto v : vs)
+         UpdateMinMax(slot, v);
+      auto &thisBuf = fBuffers[slot];
+      thisBuf.insert(thisBuf.end(), vs.begin(), vs.end());
+   }
+
+   /// Bulk mode: values and weights of a block of entries that passed the filters
+   template <typename T, typename W>
+   void ExecBulk(unsigned int slot, const RVec<T> &vs, const RVec<W> &ws)
+   {
+      ExecBulk(slot, vs);
+      auto &thisWBuf = fWBuffers[slot];
+      thisWBuf.insert(thisWBuf.end(), ws.begin(), ws.end());
+   }
+
    Hist_t &PartialUpdate(unsigned int);
 
    void Initialize() { /* noop */}
@@ -227,12 +252,64 @@ FillHelper::Exec(unsigned int, const std::vector<unsigned int> &, const std::vec
 template <typename HIST = Hist_t>
 class FillTOHelper : public RActionImpl<FillTOHelper<HIST>> {
    std::unique_ptr<TThreadedObject<HIST>> fTo;
+   /// Per-slot copies as double of the columns of a block, for the columns of other types (bulk mode)
+   std::vector<std::array<std::vector<double>, 4>> fBulkBuffers;
+
+   /// Number of coordinates of HIST filled by TH1::FillN, 0 for TProfile2D which has no FillN of its own
+   static constexpr unsigned int fgFillNDim =
+      std::is_base_of<TProfile2D, HIST>::value
+         ? 0
+         : std::is_base_of<TH3, HIST>::value
+              ? 3
+              : (std::is_base_of<TH2, HIST>::value || std::is_base_of<TProfile, HIST>::value ? 2 : 1);
+
+   static const double *AsDoubles(const RVec<double> &v, std::vector<double> &) { return v.data(); }
+
+   template <typename T>
+   static const double *AsDoubles(const RVec<T> &v, std::vector<double> &buf)
+   {
+      buf.assign(v.begin(), v.end());
+      return buf.data();
+   }
+
+   void FillN(HIST &h, Int_t n, const double *const *xs, const double *w, std::integral_constant<unsigned int, 1>)
+   {
+      h.FillN(n, xs[0], w);
+   }
+
+   void FillN(HIST &h, Int_t n, const double *const *xs, const double *w, std::integral_constant<unsigned int, 2>)
+   {
+      h.FillN(n, xs[0], xs[1], w);
+   }
+
+   void FillN(HIST &h, Int_t n, const double *const *xs, const double *w, std::integral_constant<unsigned int, 3>)
+   {
+      h.FillN(n, xs[0], xs[1], xs[2], w);
+   }
+
+   template <typename... Xs>
+   void FillBlock(unsigned int slot, std::false_type, const RVec<Xs> &... xs)
+   {
+      Exec(slot, xs...);
+   }
+
+   template <typename... Xs>
+   void FillBlock(unsigned int slot, std::true_type, const RVec<Xs> &... xs)
+   {
+      const std::size_t sizes[] = {xs.size()...};
+      auto &buffers = fBulkBuffers[slot];
+      std::size_t i = 0;
+      const double *cols[4] = {AsDoubles(xs, buffers[i++])...};
+      const double *w = sizeof...(Xs) > fgFillNDim ? cols[fgFillNDim] : nullptr;
+      FillN(*fTo->GetAtSlotRaw(slot), sizes[0], cols, w, std::integral_constant<unsigned int, fgFillNDim>());
+   }
 
 public:
    FillTOHelper(FillTOHelper &&) = default;
    FillTOHelper(const FillTOHelper &) = delete;
 
-   FillTOHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots) : fTo(new TThreadedObject<HIST>(*h))
+   FillTOHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots)
+      : fTo(new TThreadedObject<HIST>(*h)), fBulkBuffers(nSlots)
    {
       fTo->SetAtSlot(0, h);
       // Initialise all other slots
@@ -325,6 +402,16 @@ public:
       }
    }
 
+   /// Bulk mode: coordinates (and weights) of a block of entries that passed the filters.
+   /// The block is filled with a single TH1::FillN call, or entry by entry for a TProfile2D.
+   template <typename... Xs>
+   void ExecBulk(unsigned int slot, const RVec<Xs> &... xs)
+   {
+      constexpr auto nCols = sizeof...(Xs);
+      using UseFillN_t = std::integral_constant<bool, fgFillNDim != 0 && (nCols == fgFillNDim || nCols == fgFillNDim + 1)>;
+      FillBlock(slot, UseFillN_t(), xs...);
+   }
+
    void Initialize() { /* noop */}
 
    void Finalize() { fTo->Merge(); }
@@ -579,6 +666,15 @@ public:
          fMins[slot] = std::min(v, fMins[slot]);
    }
 
+   /// Bulk mode: values of a block of entries that passed the filters
+   template <typename T>
+   void ExecBulk(unsigned int slot, const RVec<T> &vs)
+   {
+      auto &m = fMins[slot];
+      for (auto v : vs)
+         m = std::min(static_cast<ResultType>(v), m);
+   }
+
    void Initialize() { /* noop */}
 
    void Finalize()
@@ -621,6 +717,15 @@ public:
          fMaxs[slot] = std::max((ResultType)v, fMaxs[slot]);
    }
 
+   /// Bulk mode: values of a block of entries that passed the filters
+   template <typename T>
+   void ExecBulk(unsigned int slot, const RVec<T> &vs)
+   {
+      auto &m = fMaxs[slot];
+      for (auto v : vs)
+         m = std::max(static_cast<ResultType>(v), m);
+   }
+
    void Initialize() { /* noop */}
 
    void Finalize()
@@ -664,6 +769,17 @@ public:
          fSums[slot] += static_cast<ResultType>(v);
    }
 
+   /// Bulk mode: values of a block of entries that passed the filters. The partial sum is kept in a local variable
+   /// so that the loop does not go through memory shared with the other slots.
+   template <typename T>
+   void ExecBulk(unsigned int slot, const RVec<T> &vs)
+   {
+      auto sum = fSums[slot];
+      for (auto v : vs)
+         sum += static_cast<ResultType>(v);
+      fSums[slot] = sum;
+   }
+
    void Initialize() { /* noop */}
 
    void Finalize()
@@ -697,6 +813,17 @@ public:
       }
    }
 
+   /// Bulk mode: values of a block of entries that passed the filters
+   template <typename T>
+   void ExecBulk(unsigned int slot, const RVec<T> &vs)
+   {
+      auto sum = fSums[slot];
+      for (auto v : vs)
+         sum += v;
+      fSums[slot] = sum;
+      fCounts[slot] += vs.size();
+   }
+
    void Initialize() { /* noop */}
 
    void Finalize();
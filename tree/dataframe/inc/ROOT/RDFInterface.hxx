@@ -34,6 +34,7 @@
 #include "ROOT/RDFNodesUtils.hxx"
 #include "ROOT/RDFUtils.hxx"
 #include "ROOT/RDataSource.hxx"
+#include "ROOT/RDiskCacheOptions.hxx"
 #include "ROOT/RLazyDSImpl.hxx"
 #include "ROOT/RResultPtr.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
@@ -208,7 +209,7 @@ public:
       RInterface<typename decltype(upcastNode)::element_type> upcastInterface(upcastNode, fImplWeakPtr,
                                                                               fValidCustomColumns, fBranchNames, fDataSource);
       const auto prevNodeTypeName = upcastInterface.GetNodeTypeName();
-      const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(df.get(), name);
+      const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(df.get(), name, expression);
       RDFInternal::BookFilterJit(jittedFilter.get(), upcastNode.get(), prevNodeTypeName, name, expression, aliasMap,
                                  branches, customColumns, tree, fDataSource, df->GetID());
 
@@ -545,6 +546,56 @@ public:
       return Cache(selectedColumns);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns on disk
+   /// \param[in] columnList columns to be cached on disk
+   /// \param[in] options directory, key and compression settings of the cache
+   ///
+   /// The content of the selected columns is written, column by column and with a light compression, to a file in
+   /// `options.fDirectory` whose name is a hash of the computation graph: the input dataset (including modification
+   /// time and size of the input files, or the identity reported by RDataSource::GetDatasetIdentity), the filters
+   /// and ranges with the expressions of jitted filters, the custom columns with the expressions of jitted ones, the
+   /// names and types of the cached columns and the user-provided `options.fKey`. If a complete cache file with the same name already exists, e.g.
+   /// written by a previous session or by another process, it is reused and no event loop is run. Otherwise the
+   /// event loop runs immediately and the cache file is written. The returned RDataFrame reads the cache file,
+   /// memory-mapping it if `options.fMemoryMap` is set.
+   /// As opposed to the in-memory Cache, datasets larger than the available memory can be cached.
+   /// The bodies of the C++ functions passed to Define and Filter are not part of the hash: `options.fKey` must be
+   /// changed when they change. The same holds for the content of data sources that cannot identify their dataset,
+   /// e.g. in-memory Arrow tables.
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RDiskCacheOptions &options)
+   {
+      if (columnList.empty())
+         throw std::runtime_error("Cache: the list of columns to be cached on disk is empty.");
+
+      auto lm = GetLoopManager();
+      // the expressions of the jitted filters are part of the hash
+      lm->BuildJittedNodes();
+      const auto fileName = RDFInternal::GetDiskCacheFileName(*lm, fDataSource, columnList, fValidCustomColumns,
+                                                              RDFInternal::GetGraphSignature(fProxiedPtr), options);
+      if (options.fOverwrite || !RDFInternal::IsValidDiskCache(fileName, columnList)) {
+         // write to a temporary file first, so that other processes never see an incomplete cache
+         const auto tmpFileName = RDFInternal::GetDiskCacheTmpFileName(fileName);
+         RSnapshotOptions snapshotOptions;
+         snapshotOptions.fCompressionAlgorithm = options.fCompressionAlgorithm;
+         snapshotOptions.fCompressionLevel = options.fCompressionLevel;
+         try {
+            Snapshot(RDFInternal::kDiskCacheTreeName, tmpFileName, columnList, snapshotOptions);
+         } catch (...) {
+            RDFInternal::DiscardDiskCache(tmpFileName);
+            throw;
+         }
+         RDFInternal::CommitDiskCache(tmpFileName, fileName);
+      }
+
+      auto chain = std::make_shared<TChain>(RDFInternal::kDiskCacheTreeName);
+      chain->Add((options.fMemoryMap ? fileName + "?mmap=1" : fileName).c_str());
+      auto cachedLm = std::make_shared<RLoopManager>(nullptr, columnList);
+      cachedLm->SetTree(chain);
+      RInterface<RLoopManager> cachedRDF(cachedLm);
+      return cachedRDF;
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates a node that filters entries based on range: [begin, end)
@@ -553,17 +604,21 @@ public:
    /// \param[in] stride Process one entry of the [begin, end) range every `stride` entries. Must be strictly greater than 0.
    ///
    /// Note that in case of previous Ranges and Filters the selected range refers to the transformed dataset.
-   /// Ranges are only available if EnableImplicitMT has _not_ been called. Multi-thread ranges are not supported.
+   /// If the RDataFrame was constructed with ImplicitMT enabled, ranges refer to the entry numbers of the dataset
+   /// and can only be applied directly to it (possibly after Defines), not after Filters or other Ranges.
+   /// In that case only the clusters of entries that overlap with the ranges are read.
    // clang-format on
    RInterface<RDFDetail::RRange<Proxied>, DS_t> Range(unsigned int begin, unsigned int end, unsigned int stride = 1)
    {
       // check invariants
       if (stride == 0 || (end != 0 && end < begin))
          throw std::runtime_error("Range: stride must be strictly greater than 0 and end must be greater than begin.");
-      if (ROOT::IsImplicitMTEnabled())
-         throw std::runtime_error("Range was called with ImplicitMT enabled. Multi-thread ranges are not supported.");
 
       auto df = GetLoopManager();
+      if (df->IsMultiThread() && !std::is_same<Proxied, RLoopManager>::value)
+         throw std::runtime_error("Range was called with ImplicitMT enabled after a Filter or a Range. Multi-thread "
+                                  "ranges can only be applied directly to the dataset.");
+
       using Range_t = RDFDetail::RRange<Proxied>;
       auto RangePtr = std::make_shared<Range_t>(begin, end, stride, *fProxiedPtr);
       df->Book(RangePtr);
@@ -581,6 +636,37 @@ public:
    // clang-format on
    RInterface<RDFDetail::RRange<Proxied>, DS_t> Range(unsigned int end) { return Range(0, end, 1); }
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Creates a node that only lets through the first `n` entries
+   /// \param[in] n Number of entries to process.
+   ///
+   /// Equivalent to `Range(0, n)`. See Range for a detailed description.
+   // clang-format on
+   RInterface<RDFDetail::RRange<Proxied>, DS_t> Head(unsigned int n) { return Range(0, n, 1); }
+
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Creates a node that skips the first `n` entries
+   /// \param[in] n Number of entries to skip.
+   ///
+   /// Equivalent to `Range(n, 0)`. See Range for a detailed description.
+   // clang-format on
+   RInterface<RDFDetail::RRange<Proxied>, DS_t> Skip(unsigned int n) { return Range(n, 0, 1); }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Let actions process the selected entries in blocks
+   /// \param[in] bulkSize Number of entries per block, 0 disables the bulk mode.
+   ///
+   /// This setting applies to all the event loops of the computation graph this node belongs to.
+   /// In bulk mode, the actions that support it (Histo1D, Histo2D, Histo3D, Profile1D, Profile2D, Min, Max, Sum
+   /// and Mean of columns of arithmetic types) copy the column values of the entries that passed the filters into
+   /// contiguous per-thread buffers, and process them one block of `bulkSize` entries at a time instead of one entry
+   /// at a time. Other actions are not affected. Filters and Defines are still evaluated one entry at a time,
+   /// lazily, since entries are read one at a time from the dataset.
+   /// Typical block sizes are between 256 and 4096 entries.
+   void SetBulkSize(unsigned int bulkSize) { GetLoopManager()->SetBulkSize(bulkSize); }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Execute a user-defined function on each entry (*instant action*)
@@ -17,6 +17,7 @@
 #include <ROOT/RDFActionHelpers.hxx> // for BuildAction
 #include <ROOT/RDFNodes.hxx>
 #include <ROOT/RDFUtils.hxx>
+#include <ROOT/RDiskCacheOptions.hxx>
 #include <ROOT/TypeTraits.hxx>
 #include <ROOT/TSeq.hxx>
 #include <algorithm>
@@ -425,6 +426,26 @@ bool IsInternalColumn(std::string_view colName);
 /// Returns the list of Filters defined in the whole graph
 std::vector<std::string> GetFilterNames(const std::shared_ptr<RLoopManager> &loopManager);
 
+/// Name of the TTree in which RInterface::Cache stores columns on disk
+constexpr const char *kDiskCacheTreeName = "RDFCache";
+
+/// Return the name of the file where the given columns are cached on disk, based on a hash of the computation graph
+std::string GetDiskCacheFileName(RLoopManager &lm, RDataSource *ds, const ColumnNames_t &columns,
+                                 const ColumnNames_t &customColumns, const std::string &graphSignature,
+                                 const RDiskCacheOptions &options);
+
+/// Check whether the file contains a complete disk cache of the given columns
+bool IsValidDiskCache(const std::string &fileName, const ColumnNames_t &columns);
+
+/// Return the name of a temporary file, unique to this process, to write a disk cache to
+std::string GetDiskCacheTmpFileName(const std::string &fileName);
+
+/// Atomically move a completely written disk cache to its final location, throw on failure
+void CommitDiskCache(const std::string &tmpFileName, const std::string &fileName);
+
+/// Remove an incompletely written disk cache
+void DiscardDiskCache(const std::string &tmpFileName);
+
 /// Returns the list of Filters defined in the branch
 template <typename NodeType>
 std::vector<std::string> GetFilterNames(const std::shared_ptr<NodeType> &node)
@@ -434,6 +455,16 @@ std::vector<std::string> GetFilterNames(const std::shared_ptr<NodeType> &node)
    return filterNames;
 }
 
+/// Returns a description of the Filters and Ranges of the branch, including the expressions of jitted Filters.
+/// The jitted nodes must have been built.
+template <typename NodeType>
+std::string GetGraphSignature(const std::shared_ptr<NodeType> &node)
+{
+   std::string signature;
+   node->AddSignature(signature);
+   return signature;
+}
+
 // Check if a condition is true for all types
 template <bool...>
 struct TBoolPack;
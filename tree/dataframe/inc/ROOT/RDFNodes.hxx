@@ -135,6 +135,7 @@ class RLoopManager {
    const ColumnNames_t fDefaultColumns;
    const ULong64_t fNEmptyEntries{0};
    const unsigned int fNSlots{1};
+   unsigned int fBulkSize{0}; ///< Size of the blocks of entries processed at once by actions in bulk mode, 0 if disabled
    bool fMustRunNamedFilters{true};
    unsigned int fNChildren{0};      ///< Number of nodes of the functional graph hanging from this object
    unsigned int fNStopsReceived{0}; ///< Number of times that a children node signaled to stop processing entries.
@@ -161,6 +162,7 @@ class RLoopManager {
    void CleanUpNodes();
    void CleanUpTask(unsigned int slot);
    void EvalChildrenCounts();
+   std::pair<ULong64_t, ULong64_t> EvalEntryRange() const;
    unsigned int GetNextID() const;
 
 public:
@@ -187,6 +189,9 @@ public:
    void Book(const RangeBasePtr_t &rangePtr);
    bool CheckFilters(int, unsigned int);
    unsigned int GetNSlots() const { return fNSlots; }
+   bool IsMultiThread() const;
+   unsigned int GetBulkSize() const { return fBulkSize; }
+   void SetBulkSize(unsigned int bulkSize) { fBulkSize = bulkSize; }
    bool MustRunNamedFilters() const { return fMustRunNamedFilters; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const;
    /// End of recursive chain of calls, does nothing
@@ -204,6 +209,8 @@ public:
    unsigned int GetID() const { return fID; }
    /// End of recursive chain of calls, does nothing
    void AddFilterName(std::vector<std::string> &) {}
+   /// End of recursive chain of calls, does nothing
+   void AddSignature(std::string &) {}
    /// For each booked filter, returns either the name or "Unnamed Filter"
    std::vector<std::string> GetFiltersNames();
 };
@@ -396,14 +403,55 @@ public:
    void *PartialUpdate(unsigned int slot) final;
 };
 
+/// Whether values of these column types can be buffered in contiguous arrays by actions in bulk mode
+template <typename... ColumnTypes>
+struct AreBulkBufferable : std::true_type {
+};
+
+template <typename T, typename... ColumnTypes>
+struct AreBulkBufferable<T, ColumnTypes...>
+   : std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+                                     AreBulkBufferable<ColumnTypes...>::value> {
+};
+
+/// The per-slot buffers in which actions in bulk mode accumulate the values of the entries that passed the filters,
+/// one RVec per column
+template <typename TypeList>
+struct RBulkBuffers;
+
+template <typename... ColumnTypes>
+struct RBulkBuffers<TypeList<ColumnTypes...>> {
+   using Tuple_t = std::tuple<ROOT::VecOps::RVec<ColumnTypes>...>;
+   static constexpr bool fgIsBufferable = AreBulkBufferable<ColumnTypes...>::value;
+};
+
+/// Whether Helper provides an ExecBulk method that accepts the buffers of a block of entries
+template <typename Helper, typename Buffers, typename Seq, typename = void>
+struct HasExecBulk : std::false_type {
+};
+
+template <typename Helper, typename Buffers, std::size_t... S>
+struct HasExecBulk<Helper, Buffers, std::index_sequence<S...>,
+                   decltype(std::declval<Helper &>().ExecBulk(0u, std::get<S>(std::declval<Buffers &>())...), void())>
+   : std::true_type {
+};
+
 template <typename Helper, typename PrevDataFrame, typename ColumnTypes_t = typename Helper::ColumnTypes_t>
 class RAction final : public RActionBase {
    using TypeInd_t = std::make_index_sequence<ColumnTypes_t::list_size>;
+   using BulkBuffersTuple_t = typename RBulkBuffers<ColumnTypes_t>::Tuple_t;
+   /// True if this action can run in bulk mode: the helper processes blocks of entries through ExecBulk
+   static constexpr bool fgSupportsBulk = RBulkBuffers<ColumnTypes_t>::fgIsBufferable &&
+                                          HasExecBulk<Helper, BulkBuffersTuple_t, TypeInd_t>::value;
+   using BulkBuffers_t = typename std::conditional<fgSupportsBulk, BulkBuffersTuple_t, std::tuple<>>::type;
+   using SupportsBulk_t = std::integral_constant<bool, fgSupportsBulk>;
 
    Helper fHelper;
    const ColumnNames_t fBranches;
    PrevDataFrame &fPrevData;
    std::vector<RDFValueTuple_t<ColumnTypes_t>> fValues;
+   std::vector<BulkBuffers_t> fBulkBuffers; ///< Per-slot values of the selected entries, only used in bulk mode
+   unsigned int fBulkSize{0}; ///< Number of selected entries processed at once by the helper, 0 if not in bulk mode
 
 public:
    RAction(Helper &&h, const ColumnNames_t &bl, PrevDataFrame &pd)
@@ -416,7 +464,13 @@ public:
    RAction &operator=(const RAction &) = delete;
    ~RAction() { fHelper.Finalize(); }
 
-   void Initialize() final { fHelper.Initialize(); }
+   void Initialize() final
+   {
+      fBulkSize = fgSupportsBulk ? fLoopManager->GetBulkSize() : 0u;
+      if (fBulkSize > 0)
+         fBulkBuffers.resize(fNSlots);
+      fHelper.Initialize();
+   }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
@@ -428,8 +482,12 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
-         Exec(slot, entry, TypeInd_t());
+      if (fPrevData.CheckFilters(slot, entry)) {
+         if (fBulkSize > 0)
+            BufferValues(slot, entry, SupportsBulk_t(), TypeInd_t());
+         else
+            Exec(slot, entry, TypeInd_t());
+      }
    }
 
    template <std::size_t... S>
@@ -443,6 +501,8 @@ public:
 
    void FinalizeSlot(unsigned int slot) final
    {
+      if (fBulkSize > 0)
+         ExecBulk(slot, SupportsBulk_t(), TypeInd_t());
       ClearValueReaders(slot);
       fHelper.CallFinalizeTask(slot);
    }
@@ -451,9 +511,48 @@ public:
 
    /// This method is invoked to update a partial result during the event loop, right before passing the result to a
    /// user-defined callback registered via RResultPtr::RegisterCallback
-   void *PartialUpdate(unsigned int slot) final { return PartialUpdateImpl(slot); }
+   void *PartialUpdate(unsigned int slot) final
+   {
+      // the partial result must include the entries that are still buffered
+      if (fBulkSize > 0)
+         ExecBulk(slot, SupportsBulk_t(), TypeInd_t());
+      return PartialUpdateImpl(slot);
+   }
 
 private:
+   /// Bulk mode: append the values of a selected entry to the buffers, pass them to the helper when a block is full
+   template <std::size_t... S>
+   void BufferValues(unsigned int slot, Long64_t entry, std::true_type, std::index_sequence<S...> s)
+   {
+      auto &buffers = fBulkBuffers[slot];
+      int expander[] = {0, (std::get<S>(buffers).emplace_back(std::get<S>(fValues[slot]).Get(entry)), 0)...};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+      if (std::get<0>(buffers).size() >= fBulkSize)
+         ExecBulk(slot, std::true_type(), s);
+   }
+
+   template <std::size_t... S>
+   void BufferValues(unsigned int, Long64_t, std::false_type, std::index_sequence<S...>)
+   {
+   }
+
+   /// Bulk mode: let the helper process the buffered block of entries, then empty the buffers (keeping their capacity)
+   template <std::size_t... S>
+   void ExecBulk(unsigned int slot, std::true_type, std::index_sequence<S...>)
+   {
+      auto &buffers = fBulkBuffers[slot];
+      if (std::get<0>(buffers).empty())
+         return;
+      fHelper.ExecBulk(slot, std::get<S>(buffers)...);
+      int expander[] = {0, (std::get<S>(buffers).clear(), 0)...};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+   }
+
+   template <std::size_t... S>
+   void ExecBulk(unsigned int, std::false_type, std::index_sequence<S...>)
+   {
+   }
+
    // this overload is SFINAE'd out if Helper does not implement `PartialUpdate`
    // the template parameter is required to defer instantiation of the method to SFINAE time
    template <typename H = Helper>
@@ -501,12 +600,14 @@ public:
 class RJittedCustomColumn : public RCustomColumnBase
 {
    std::unique_ptr<RCustomColumnBase> fConcreteCustomColumn = nullptr;
+   const std::string fExpression; ///< The expression passed to Define
 
 public:
-   RJittedCustomColumn(RLoopManager &lm, std::string_view name)
-      : RCustomColumnBase(&lm, name, lm.GetNSlots(), /*isDSColumn=*/false) {}
+   RJittedCustomColumn(RLoopManager &lm, std::string_view name, std::string_view expression)
+      : RCustomColumnBase(&lm, name, lm.GetNSlots(), /*isDSColumn=*/false), fExpression(expression) {}
 
    void SetCustomColumn(std::unique_ptr<RCustomColumnBase> c) { fConcreteCustomColumn = std::move(c); }
+   const std::string &GetExpression() const { return fExpression; }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void *GetValuePtr(unsigned int slot) final;
@@ -654,6 +755,8 @@ public:
    virtual void ClearValueReaders(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   /// Append a description of this filter and of the upstream nodes, see RInterface::Cache
+   virtual void AddSignature(std::string &signature) = 0;
 };
 
 /// A wrapper around a concrete RFilter, which forwards all calls to it
@@ -661,9 +764,13 @@ public:
 /// at a later time, from jitted code.
 class RJittedFilter final : public RFilterBase {
    std::unique_ptr<RFilterBase> fConcreteFilter = nullptr;
+   const std::string fExpression; ///< The expression passed to Filter
 
 public:
-   RJittedFilter(RLoopManager *lm, std::string_view name) : RFilterBase(lm, name, lm->GetNSlots()) {}
+   RJittedFilter(RLoopManager *lm, std::string_view name, std::string_view expression)
+      : RFilterBase(lm, name, lm->GetNSlots()), fExpression(expression)
+   {
+   }
 
    void SetFilter(std::unique_ptr<RFilterBase> f);
 
@@ -680,6 +787,7 @@ public:
    void ClearValueReaders(unsigned int slot) final;
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
+   void AddSignature(std::string &signature) final;
 };
 
 template <typename FilterF, typename PrevDataFrame>
@@ -769,6 +877,15 @@ public:
       RDFInternal::ResetRDFValueTuple(fValues[slot], TypeInd_t());
    }
 
+   void AddSignature(std::string &signature)
+   {
+      fPrevData.AddSignature(signature);
+      signature += "filter:" + fName + "(";
+      for (const auto &column : fBranches)
+         signature += column + ",";
+      signature += ");";
+   }
+
    void AddFilterName(std::vector<std::string> &filters)
    {
       fPrevData.AddFilterName(filters);
@@ -791,8 +908,17 @@ protected:
    unsigned int fNStopsReceived{0}; ///< Number of times that a children node signaled to stop processing entries.
    bool fHasStopped{false};         ///< True if the end of the range has been reached
    const unsigned int fNSlots;      ///< Number of thread slots used by this node, inherited from parent node.
+   /// True in multi-thread event loops, where the range is applied to the entry numbers of the dataset
+   bool fUseEntryNumbers{false};
 
    void ResetCounters();
+   /// Whether the entry with number `entry` of the dataset is selected by this range
+   bool IsInRange(Long64_t entry) const
+   {
+      // same selection that single-thread event loops apply to the number of processed entries
+      const auto n = static_cast<ULong64_t>(entry) + 1;
+      return n > fStart && (fStop == 0 || n <= fStop) && (fStride == 1 || n % fStride == 0);
+   }
 
 public:
    RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int stop, unsigned int stride,
@@ -807,12 +933,23 @@ public:
    virtual void IncrChildrenCount() = 0;
    virtual void StopProcessing() = 0;
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   /// Append a description of this range and of the upstream nodes, see RInterface::Cache
+   virtual void AddSignature(std::string &signature) = 0;
+   /// Whether this range hangs directly from the RLoopManager, i.e. it selects entries of the dataset itself
+   virtual bool ActsOnDataset() const = 0;
+   unsigned int GetStart() const { return fStart; }
+   unsigned int GetStop() const { return fStop; }
+   bool HasChildren() const { return fNChildren > 0; }
    void ResetChildrenCount()
    {
       fNChildren = 0;
       fNStopsReceived = 0;
    }
-   void InitNode() { ResetCounters(); }
+   void InitNode()
+   {
+      ResetCounters();
+      fUseEntryNumbers = fLoopManager->IsMultiThread();
+   }
 };
 
 template <typename PrevData>
@@ -832,6 +969,11 @@ public:
    /// Ranges act as filters when it comes to selecting entries that downstream nodes should process
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
+      // In multi-thread event loops entries are not processed in order: the selection is stateless and relies
+      // on the entry numbers of the dataset, which is why only ranges that act directly on it are allowed there.
+      if (fUseEntryNumbers)
+         return fPrevData.CheckFilters(slot, entry) && IsInRange(entry);
+
       if (entry != fLastCheckedEntry) {
          if (fHasStopped)
             return false;
@@ -879,6 +1021,14 @@ public:
 
    /// This function must be defined by all nodes, but only the filters will add their name
    void AddFilterName(std::vector<std::string> &filters) { fPrevData.AddFilterName(filters); }
+
+   void AddSignature(std::string &signature)
+   {
+      fPrevData.AddSignature(signature);
+      signature += "range:" + std::to_string(fStart) + "," + std::to_string(fStop) + "," + std::to_string(fStride) + ";";
+   }
+
+   bool ActsOnDataset() const final { return std::is_same<PrevData, RLoopManager>::value; }
 };
 
 } // namespace RDF
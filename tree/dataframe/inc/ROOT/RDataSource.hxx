@@ -14,6 +14,7 @@
 #include "ROOT/RStringView.hxx"
 #include "RtypesCore.h" // ULong64_t
 #include <algorithm>    // std::transform
+#include <string>
 #include <vector>
 #include <typeinfo>
 
@@ -118,6 +119,13 @@ public:
    // clang-format on
    virtual std::string GetTypeName(std::string_view) const = 0;
 
+   // clang-format off
+   /// \brief A string identifying the dataset, e.g. the names, modification times and sizes of the input files.
+   /// RInterface::Cache uses it to tell on-disk caches of different datasets apart. The default, an empty string,
+   /// means that the data source cannot identify its dataset.
+   // clang-format on
+   virtual std::string GetDatasetIdentity() const { return ""; }
+
    // clang-format off
    /// Called at most once per column by RDF. Return vector of pointers to pointers to column values - one per slot.
    /// \tparam T The type of the data stored in the column
@@ -0,0 +1,36 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDISKCACHEOPTIONS
+#define ROOT_RDISKCACHEOPTIONS
+
+#include <Compression.h>
+#include <ROOT/RStringView.hxx>
+#include <string>
+
+namespace ROOT {
+
+namespace RDF {
+/// A collection of options to steer the caching of columns on disk
+struct RDiskCacheOptions {
+   using ECAlgo = ::ROOT::ECompressionAlgorithm;
+   RDiskCacheOptions() = default;
+   RDiskCacheOptions(const RDiskCacheOptions &) = default;
+   RDiskCacheOptions(RDiskCacheOptions &&) = default;
+   RDiskCacheOptions(std::string_view directory, std::string_view key) : fDirectory(directory), fKey(key) {}
+   std::string fDirectory = ".";              ///< Directory where the cache files are stored
+   std::string fKey;                          ///< User tag identifying the computation, e.g. a version string
+   ECAlgo fCompressionAlgorithm = ROOT::kLZ4; ///< Compression algorithm of the cache file
+   int fCompressionLevel = 1;                 ///< Compression level of the cache file
+   bool fMemoryMap = true;                    ///< Memory-map the cache file when reading it back
+   bool fOverwrite = false;                   ///< Rebuild the cache file even if a valid one is found
+};
+} // ns RDF
+} // ns ROOT
+
+#endif
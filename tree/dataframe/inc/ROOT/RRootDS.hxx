@@ -39,6 +39,7 @@ public:
    RRootDS(std::string_view treeName, std::string_view fileNameGlob);
    ~RRootDS();
    std::string GetTypeName(std::string_view colName) const;
+   std::string GetDatasetIdentity() const;
    const std::vector<std::string> &GetColumnNames() const;
    bool HasColumn(std::string_view colName) const;
    void InitSlot(unsigned int slot, ULong64_t firstEntry);
@@ -35,6 +35,7 @@ public:
    const std::vector<std::string> &GetColumnNames() const;
    bool HasColumn(std::string_view colName) const;
    std::string GetTypeName(std::string_view) const;
+   std::string GetDatasetIdentity() const;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges();
    bool SetEntry(unsigned int slot, ULong64_t entry);
    void SetNSlots(unsigned int nSlots);
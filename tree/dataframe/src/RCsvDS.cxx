@@ -76,6 +76,7 @@ important to check both how much memory is available and the size of the CSV fil
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/RMakeUnique.hxx>
 #include <TError.h>
+#include <TSystem.h>
 
 #include <algorithm>
 #include <iostream>
@@ -250,7 +251,8 @@ size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
 ///                        (default `true`).
 /// \param[in] delimiter Delimiter character (default ',').
 RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long64_t linesChunkSize) // TODO: Let users specify types?
-   : fStream(std::string(fileName)),
+   : fFileName(fileName),
+     fStream(fFileName),
      fDelimiter(delimiter),
      fLinesChunkSize(linesChunkSize)
 {
@@ -320,6 +322,16 @@ RCsvDS::~RCsvDS()
    FreeRecords();
 }
 
+/// The name, modification time and size of the CSV file, and the delimiter
+std::string RCsvDS::GetDatasetIdentity() const
+{
+   std::string identity = "csv:" + fFileName;
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(fFileName.c_str(), stat) == 0)
+      identity += "," + std::to_string(stat.fMtime) + "," + std::to_string(stat.fSize);
+   return identity + ",delimiter:" + fDelimiter;
+}
+
 const std::vector<std::string> &RCsvDS::GetColumnNames() const
 {
    return fHeaders;
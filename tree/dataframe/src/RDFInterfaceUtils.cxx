@@ -19,8 +19,13 @@
 #include <TString.h>
 #include <TTree.h>
 #include <TBranchElement.h>
+#include <TChain.h>
+#include <TFile.h>
+#include <TMD5.h>
+#include <TSystem.h>
 
 #include <iosfwd>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <typeinfo>
@@ -601,7 +606,7 @@ void BookDefineJit(std::string_view name, std::string_view expression, RLoopMana
 
    TryToJitExpression(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
 
-   const auto jittedCustomColumn = std::make_shared<RJittedCustomColumn>(lm, name);
+   const auto jittedCustomColumn = std::make_shared<RJittedCustomColumn>(lm, name, expression);
 
    const auto definelambda = BuildLambdaString(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
    const auto lambdaName = "eval_" + std::string(name);
@@ -783,6 +788,101 @@ std::vector<bool> FindUndefinedDSColumns(const ColumnNames_t &requestedCols, con
    return mustBeDefined;
 }
 
+/// The MD5 hash covers the user-provided key, the input dataset (including the modification times and sizes of the
+/// input files, or the identity reported by the data source), the filters and ranges of the graph (see
+/// RFilterBase::AddSignature), the names of the custom columns with the expressions of the jitted ones, and the names
+/// and types of the cached columns. The bodies of the user-defined functions cannot be inspected: the key must change
+/// when they change.
+std::string GetDiskCacheFileName(RLoopManager &lm, RDataSource *ds, const ColumnNames_t &columns,
+                                 const ColumnNames_t &customColumns, const std::string &graphSignature,
+                                 const RDiskCacheOptions &options)
+{
+   std::string signature = "key:" + options.fKey + ";";
+
+   auto tree = lm.GetTree();
+   if (tree) {
+      signature += std::string("tree:") + tree->GetName() + ";";
+      std::vector<std::string> fileNames;
+      if (tree->IsA() == TChain::Class()) {
+         for (auto f : *static_cast<TChain *>(tree)->GetListOfFiles())
+            fileNames.emplace_back(f->GetTitle());
+      } else if (tree->GetCurrentFile()) {
+         fileNames.emplace_back(tree->GetCurrentFile()->GetName());
+      }
+      for (const auto &fileName : fileNames) {
+         signature += "file:" + fileName;
+         FileStat_t stat;
+         if (gSystem->GetPathInfo(fileName.c_str(), stat) == 0)
+            signature += "," + std::to_string(stat.fMtime) + "," + std::to_string(stat.fSize);
+         signature += ";";
+      }
+   } else if (ds) {
+      signature += std::string("datasource:") + typeid(*ds).name() + "," + ds->GetDatasetIdentity() + ";";
+   } else {
+      signature += "entries:" + std::to_string(lm.GetNEmptyEntries()) + ";";
+   }
+
+   signature += graphSignature;
+   const auto &bookedColumns = lm.GetBookedColumns();
+   for (const auto &name : customColumns) {
+      signature += "define:" + name;
+      const auto bookedColumn = bookedColumns.find(name);
+      if (bookedColumn != bookedColumns.end()) {
+         if (auto jittedColumn = dynamic_cast<RJittedCustomColumn *>(bookedColumn->second.get()))
+            signature += "," + jittedColumn->GetExpression();
+      }
+      signature += ";";
+   }
+   const auto &definedColumns = lm.GetCustomColumnNames();
+   for (const auto &column : columns) {
+      const auto isCustom = std::find(definedColumns.begin(), definedColumns.end(), column) != definedColumns.end();
+      signature += "column:" + column + "," +
+                   ColumnName2ColumnTypeName(column, lm.GetID(), tree, ds, isCustom, /*extraConversions=*/false) + ";";
+   }
+
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(signature.data()), signature.size());
+   md5.Final();
+   return options.fDirectory + "/rdfcache_" + md5.AsString() + ".root";
+}
+
+bool IsValidDiskCache(const std::string &fileName, const ColumnNames_t &columns)
+{
+   // AccessPathName returns true if the file does _not_ exist
+   if (gSystem->AccessPathName(fileName.c_str()))
+      return false;
+   std::unique_ptr<TFile> f(TFile::Open(fileName.c_str(), "READ"));
+   if (!f || f->IsZombie())
+      return false;
+   auto tree = dynamic_cast<TTree *>(f->Get(kDiskCacheTreeName));
+   if (!tree)
+      return false;
+   for (const auto &column : columns) {
+      if (!tree->GetBranch(column.c_str()))
+         return false;
+   }
+   return true;
+}
+
+std::string GetDiskCacheTmpFileName(const std::string &fileName)
+{
+   return fileName + ".tmp" + std::to_string(gSystem->GetPid());
+}
+
+void CommitDiskCache(const std::string &tmpFileName, const std::string &fileName)
+{
+   // rename is atomic: concurrent readers either see the previous file or the complete new one
+   if (gSystem->Rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+      gSystem->Unlink(tmpFileName.c_str());
+      throw std::runtime_error("Cache: could not move the cache file to " + fileName);
+   }
+}
+
+void DiscardDiskCache(const std::string &tmpFileName)
+{
+   gSystem->Unlink(tmpFileName.c_str());
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
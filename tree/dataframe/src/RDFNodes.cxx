@@ -15,12 +15,15 @@
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/RStringView.hxx"
+#include "TChain.h"
 #include "TTree.h"
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
 #endif
 #include <limits.h>
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -288,6 +291,13 @@ void RJittedFilter::AddFilterName(std::vector<std::string> &filters)
    fConcreteFilter->AddFilterName(filters);
 }
 
+void RJittedFilter::AddSignature(std::string &signature)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   fConcreteFilter->AddSignature(signature);
+   signature += "expression:" + fExpression + ";";
+}
+
 unsigned int &TSlotStack::GetCount()
 {
    const auto tid = std::this_thread::get_id();
@@ -378,12 +388,17 @@ void RLoopManager::RunEmptySourceMT()
 #ifdef R__USE_IMT
    TSlotStack slotStack(fNSlots);
    // Working with an empty tree.
+   // Only the entries selected by the booked ranges, if any, need to be generated.
+   const auto entryRange = EvalEntryRange();
+   const auto firstEntry = std::min(entryRange.first, fNEmptyEntries);
+   const auto lastEntry = entryRange.second == 0 ? fNEmptyEntries : std::min(entryRange.second, fNEmptyEntries);
+   const auto nEntries = lastEntry - firstEntry;
    // Evenly partition the entries according to fNSlots. Produce around 2 tasks per slot.
-   const auto nEntriesPerSlot = fNEmptyEntries / (fNSlots * 2);
-   auto remainder = fNEmptyEntries % (fNSlots * 2);
+   const auto nEntriesPerSlot = nEntries / (fNSlots * 2);
+   auto remainder = nEntries % (fNSlots * 2);
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   ULong64_t start = 0;
-   while (start < fNEmptyEntries) {
+   ULong64_t start = firstEntry;
+   while (start < lastEntry) {
       ULong64_t end = start + nEntriesPerSlot;
       if (remainder > 0) {
          ++end;
@@ -417,6 +432,7 @@ void RLoopManager::RunEmptySource()
    for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
       RunAndCheckFilters(0, currEntry);
    }
+   CleanUpTask(0u);
 }
 
 /// Run event loop over one or multiple ROOT files, in parallel.
@@ -427,6 +443,23 @@ void RLoopManager::RunTreeProcessorMT()
    using ttpmt_t = ROOT::TTreeProcessorMT;
    std::unique_ptr<ttpmt_t> tp;
    tp.reset(new ttpmt_t(*fTree));
+   // Ranges select entries by their global entry number, and only the clusters they overlap with need to be read.
+   // Restricting the entries requires to open all files up front: only do it if the ranges bound the event loop,
+   // or if active ranges need global entry numbers, which differ from the local ones for a chain of several files.
+   if (!fBookedRanges.empty()) {
+      const auto entryRange = EvalEntryRange();
+      if (entryRange.first > 0 || entryRange.second > 0) {
+         tp->SetEntriesRange(entryRange.first, entryRange.second == 0 ? -1 : entryRange.second);
+      } else {
+         const auto chain = dynamic_cast<TChain *>(fTree.get());
+         const bool isMultiFile = chain && chain->GetListOfFiles()->GetEntries() > 1;
+         const bool hasActiveRanges = std::any_of(fBookedRanges.begin(), fBookedRanges.end(), [](const RangeBasePtr_t &range) {
+            return range->ActsOnDataset() && range->HasChildren();
+         });
+         if (isMultiFile && hasActiveRanges)
+            tp->SetEntriesRange(0);
+      }
+   }
 
    tp->Process([this, &slotStack](TTreeReader &r) -> void {
       auto slot = slotStack.GetSlot();
@@ -454,6 +487,7 @@ void RLoopManager::RunTreeReader()
    while (r.Next() && fNStopsReceived < fNChildren) {
       RunAndCheckFilters(0, r.GetCurrentEntry());
    }
+   CleanUpTask(0u);
    fTree->GetEntry(0);
 }
 
@@ -474,6 +508,7 @@ void RLoopManager::RunDataSource()
             }
          }
       }
+      CleanUpTask(0u);
       fDataSource->FinaliseSlot(0u);
       ranges = fDataSource->GetEntryRanges();
    }
@@ -504,9 +539,25 @@ void RLoopManager::RunDataSourceMT()
       slotStack.ReturnSlot(slot);
    };
 
+   // Entry ranges that do not overlap with the booked ranges, if any, are not processed
+   const auto entryRange = EvalEntryRange();
+   auto clipRanges = [&entryRange](std::vector<std::pair<ULong64_t, ULong64_t>> &ranges) {
+      if (entryRange.first == 0 && entryRange.second == 0)
+         return;
+      std::vector<std::pair<ULong64_t, ULong64_t>> clipped;
+      for (const auto &range : ranges) {
+         const auto begin = std::max(range.first, entryRange.first);
+         const auto end = entryRange.second == 0 ? range.second : std::min(range.second, entryRange.second);
+         if (begin < end)
+            clipped.emplace_back(begin, end);
+      }
+      ranges.swap(clipped);
+   };
+
    fDataSource->Initialise();
    auto ranges = fDataSource->GetEntryRanges();
    while (!ranges.empty()) {
+      clipRanges(ranges);
       pool.Foreach(runOnRange, ranges);
       ranges = fDataSource->GetEntryRanges();
    }
@@ -587,7 +638,8 @@ void RLoopManager::CleanUpNodes()
    fCallbacksOnce.clear();
 }
 
-/// Perform clean-up operations. To be called at the end of each task execution.
+/// Perform clean-up operations. To be called at the end of each task execution, and at the end of a sequential
+/// event loop: in bulk mode, the actions then process the entries that are still buffered.
 void RLoopManager::CleanUpTask(unsigned int slot)
 {
    for (auto &ptr : fBookedActions)
@@ -601,6 +653,8 @@ void RLoopManager::CleanUpTask(unsigned int slot)
 /// Jit all actions that required runtime column type inference, and clean the `fToJit` member variable.
 void RLoopManager::BuildJittedNodes()
 {
+   if (fToJit.empty())
+      return;
    auto error = TInterpreter::EErrorCode::kNoError;
    gInterpreter->Calc(fToJit.c_str(), &error);
    if (TInterpreter::EErrorCode::kNoError != error) {
@@ -625,6 +679,42 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
+/// Evaluate the window of entries [begin, end) that the event loop needs to process.
+/// If all the active nodes that hang directly from this object are ranges, the entries outside of the union of these
+/// ranges are not selected by any node and do not need to be processed at all. An end of 0 means that the window goes
+/// until the end of the dataset. Must be called after EvalChildrenCounts.
+std::pair<ULong64_t, ULong64_t> RLoopManager::EvalEntryRange() const
+{
+   unsigned int nActiveRanges = 0;
+   ULong64_t begin = std::numeric_limits<ULong64_t>::max();
+   ULong64_t end = 0;
+   bool isUnbounded = false;
+   for (const auto &range : fBookedRanges) {
+      if (!range->ActsOnDataset() || !range->HasChildren())
+         continue;
+      ++nActiveRanges;
+      begin = std::min<ULong64_t>(begin, range->GetStart());
+      if (range->GetStop() == 0)
+         isUnbounded = true;
+      end = std::max<ULong64_t>(end, range->GetStop());
+   }
+
+   if (nActiveRanges == 0 || nActiveRanges != fNChildren)
+      return {0ull, 0ull};
+   return {begin, isUnbounded ? 0ull : end};
+}
+
+/// Whether the event loop is run in parallel, i.e. ImplicitMT was enabled when this object was constructed
+bool RLoopManager::IsMultiThread() const
+{
+   switch (fLoopType) {
+   case ELoopType::kROOTFilesMT:
+   case ELoopType::kNoFilesMT:
+   case ELoopType::kDataSourceMT: return true;
+   default: return false;
+   }
+}
+
 unsigned int RLoopManager::GetNextID() const
 {
    static unsigned int id = 0;
@@ -65,6 +65,8 @@ Transformations are a way to manipulated the data.
 | [DefineSlotEntry](classROOT_1_1RDF_1_1RInterface.html#a4f17074d5771916e3df18f8458186de7) | Same as `DefineSlot`, but the entry number is passed in addition to the slot number. This is meant as a helper in case some dependency on the entry number needs to be honoured. |
 | [Filter](classROOT_1_1RDF_1_1RInterface.html#a70284a3bedc72b19610aaa91b5007ebd) | Filter the rows of the dataset. |
 | [Range](classROOT_1_1RDF_1_1RInterface.html#a1b36b7868831de2375e061bb06cfc225) | Creates a node that filters entries based on range of entries |
+| [Head](classROOT_1_1RDF_1_1RInterface.html) | Shorthand for `Range(0, n)`: only the first `n` entries are processed. |
+| [Skip](classROOT_1_1RDF_1_1RInterface.html) | Shorthand for `Range(n, 0)`: the first `n` entries are skipped. |
 
 ### Actions
 Actions are a way to produce a result out of the data. Each one is described in more detail in the reference guide.
@@ -80,7 +82,7 @@ produce several different results in one event loop. Instant actions trigger the
 |------------------|-----------------|
 | [Aggregate](classROOT_1_1RDF_1_1RInterface.html#ae540b00addc441f9b504cbae0ef0a24d) | Execute a user-defined accumulation operation on the processed column values. |
 | [Book](classROOT_1_1RDF_1_1RInterface.html#a9b2f61f3333d1669e57055b9ae8be9d9) | Book execution of a custom action using a user-defined helper object. |
-| [Cache](classROOT_1_1RDF_1_1RInterface.html#aaaa0a7bb8eb21315d8daa08c3e25f6c9) | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). |
+| [Cache](classROOT_1_1RDF_1_1RInterface.html#aaaa0a7bb8eb21315d8daa08c3e25f6c9) | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). Passing RDiskCacheOptions caches the columns in a file on disk instead, which is reused across sessions as long as the computation graph does not change. |
 | [Count](classROOT_1_1RDF_1_1RInterface.html#a37f9e00c2ece7f53fae50b740adc1456) | Return the number of events processed. |
 | [Fill](classROOT_1_1RDF_1_1RInterface.html#a0cac4d08297c23d16de81ff25545440a) | Fill a user-defined object with the values of the specified branches, as if by calling `Obj.Fill(branch1, branch2, ...). |
 | [Histo{1D,2D,3D}](classROOT_1_1RDF_1_1RInterface.html#a247ca3aeb7ce5b95015b7fae72983055) | Fill a {one,two,three}-dimensional histogram with the processed branch values. |
@@ -349,8 +351,8 @@ auto d15on = d.Range(15, 0);
 // We can specify a stride too, in this case we pick an event every 3
 auto d15each3 = d.Range(0, 15, 3);
 ~~~
-Note that ranges are not available when multi-threading is enabled. More information on ranges is available
-[here](#ranges).
+`Head(n)` and `Skip(n)` are shorthands for `Range(0, n)` and `Range(n, 0)`. When multi-threading is enabled, ranges
+can only be applied directly to the dataset. More information on ranges is available [here](#ranges).
 
 ### Executing multiple actions in the same event loop
 As a final example let us apply two different cuts on branch "MET" and fill two different histograms with the "pt\_v" of
@@ -604,9 +606,8 @@ Stats are stored in the same order as named filters have been added to the graph
 that has been run using the relevant `RDataFrame`.
 
 ### <a name="ranges"></a>Ranges
-When `RDataFrame` is not being used in a multi-thread environment (i.e. no call to `EnableImplicitMT` was made),
-`Range` transformations are available. These act very much like filters but instead of basing their decision on
-a filter expression, they rely on `begin`,`end` and `stride` parameters.
+`Range` transformations act very much like filters but instead of basing their decision on a filter expression, they
+rely on `begin`,`end` and `stride` parameters.
 
 - `begin`: initial entry number considered for this range.
 - `end`: final entry number (excluded) considered for this range. 0 means that the range goes until the end of the dataset.
@@ -623,6 +624,13 @@ preceding filter*.
 Ranges allow "early quitting": if all branches of execution of a functional graph reached their `end` value of
 processed entries, the event-loop is immediately interrupted. This is useful for debugging and quick data explorations.
 
+`Head(n)` is equivalent to `Range(0, n)` and `Skip(n)` is equivalent to `Range(n, 0)`.
+
+In a multi-thread environment (i.e. `EnableImplicitMT` was called before constructing the `RDataFrame`) entries are
+not processed in order, so ranges act on the global entry numbers of the dataset and must be applied directly to it:
+calling `Range` after a `Filter` or another `Range` throws an exception. If all the actions of the event loop hang
+from ranges, only the clusters of entries that overlap with these ranges are scheduled for processing.
+
 ### <a name="custom-columns"></a> Custom columns
 Custom columns are created by invoking `Define(name, f, columnList)`. As usual, `f` can be any callable object
 (function, lambda expression, functor class...); it takes the values of the columns listed in `columnList` (a list of
@@ -4,6 +4,7 @@
 #include <TClass.h>
 #include <TError.h>
 #include <TROOT.h>         // For the gROOTMutex
+#include <TSystem.h>
 #include <TVirtualMutex.h> // For the R__LOCKGUARD
 #include <ROOT/RMakeUnique.hxx>
 
@@ -72,6 +73,20 @@ std::string RRootDS::GetTypeName(std::string_view colName) const
    return typeName;
 }
 
+/// The tree name and the names, modification times and sizes of the files matching the glob
+std::string RRootDS::GetDatasetIdentity() const
+{
+   std::string identity = "tree:" + fTreeName + ";";
+   for (auto file : *fModelChain.GetListOfFiles()) {
+      identity += std::string("file:") + file->GetTitle();
+      FileStat_t stat;
+      if (gSystem->GetPathInfo(file->GetTitle(), stat) == 0)
+         identity += "," + std::to_string(stat.fMtime) + "," + std::to_string(stat.fSize);
+      identity += ";";
+   }
+   return identity;
+}
+
 const std::vector<std::string> &RRootDS::GetColumnNames() const
 {
    return fListOfBranches;
@@ -30,6 +30,11 @@ RTrivialDS::~RTrivialDS()
 {
 }
 
+std::string RTrivialDS::GetDatasetIdentity() const
+{
+   return "size:" + std::to_string(fSize) + (fSkipEvenEntries ? ",skipEvenEntries" : "");
+}
+
 const std::vector<std::string> &RTrivialDS::GetColumnNames() const
 {
    return fColNames;
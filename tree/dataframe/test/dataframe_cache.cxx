@@ -8,6 +8,7 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <cstring>
 
 using namespace ROOT::RDF;
 using namespace ROOT::VecOps;
@@ -268,3 +269,56 @@ TEST(Cache, Carrays)
 }
 
 #endif // R__B64
+
+TEST(Cache, OnDisk)
+{
+   const auto cacheDir = "dataframe_cache_ondisk";
+   gSystem->mkdir(cacheDir);
+   RDiskCacheOptions opts(cacheDir, "v1");
+
+   ROOT::RDataFrame tdf(10);
+   int nCalls = 0;
+   auto d = tdf.Define("c0", [&nCalls](ULong64_t e) { ++nCalls; return int(e); }, {"tdfentry_"})
+               .Define("c1", [](int c0) { return c0 * 0.5; }, {"c0"});
+
+   // the first call runs the event loop and writes the cache file
+   auto cached = d.Cache({"c0", "c1"}, opts);
+   EXPECT_EQ(10, nCalls);
+   auto v0 = cached.Take<int>("c0");
+   auto v1 = cached.Take<double>("c1");
+   for (auto i : ROOT::TSeqI(10)) {
+      EXPECT_EQ(i, (*v0)[i]);
+      EXPECT_DOUBLE_EQ(i * 0.5, (*v1)[i]);
+   }
+
+   // the same computation graph reuses the cache file
+   auto cachedAgain = d.Cache({"c0", "c1"}, opts);
+   EXPECT_EQ(10, nCalls);
+   EXPECT_EQ(45, *cachedAgain.Sum<int>("c0"));
+
+   // a different key triggers a new event loop
+   opts.fKey = "v2";
+   auto cachedNewKey = d.Cache({"c0"}, opts);
+   EXPECT_EQ(20, nCalls);
+   EXPECT_EQ(10ULL, *cachedNewKey.Count());
+
+   // ranges and the expressions of jitted filters and defines are part of the hash
+   EXPECT_EQ(5ULL, *d.Range(5).Cache({"c0"}, opts).Count());
+   EXPECT_EQ(6ULL, *d.Range(6).Cache({"c0"}, opts).Count());
+   EXPECT_EQ(7ULL, *d.Filter("c1 > 1").Cache({"c0"}, opts).Count());
+   EXPECT_EQ(5ULL, *d.Filter("c1 > 2").Cache({"c0"}, opts).Count());
+   EXPECT_EQ(90ULL, *ROOT::RDataFrame(10).Define("x", "tdfentry_ * 2").Cache({"x"}, opts).Sum<ULong64_t>("x"));
+   EXPECT_EQ(135ULL, *ROOT::RDataFrame(10).Define("x", "tdfentry_ * 3").Cache({"x"}, opts).Sum<ULong64_t>("x"));
+
+   // so is the dataset of a data source
+   EXPECT_EQ(4ULL, *MakeTrivialDataFrame(4).Cache({"col0"}, opts).Count());
+   EXPECT_EQ(6ULL, *MakeTrivialDataFrame(6).Cache({"col0"}, opts).Count());
+
+   auto dir = gSystem->OpenDirectory(cacheDir);
+   while (auto entry = gSystem->GetDirEntry(dir)) {
+      if (strcmp(entry, ".") != 0 && strcmp(entry, "..") != 0)
+         gSystem->Unlink((std::string(cacheDir) + "/" + entry).c_str());
+   }
+   gSystem->FreeDirectory(dir);
+   gSystem->Unlink(cacheDir);
+}
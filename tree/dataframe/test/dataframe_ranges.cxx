@@ -1,6 +1,12 @@
 #include "ROOT/RDataFrame.hxx"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <atomic>
+
 using namespace ROOT;
 
 class RDFRanges : public ::testing::Test {
@@ -88,19 +94,118 @@ TEST_F(RDFRanges, NoEarlyStopping)
    auto b4 = f.Count();
 }
 
+TEST_F(RDFRanges, HeadSkip)
+{
+   auto &d = GetRDF();
+   auto h = d.Head(10).Take<ULong64_t>("tdfentry_");
+   auto s = d.Skip(95).Take<ULong64_t>("tdfentry_");
+   EXPECT_EQ(*h, std::vector<ULong64_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+   EXPECT_EQ(*s, std::vector<ULong64_t>({95, 96, 97, 98, 99}));
+}
+
 #ifdef R__USE_IMT
-TEST(RDFRangesMT, ThrowIfIMT)
+TEST(RDFRangesMT, ThrowIfNotOnDataset)
 {
-   bool hasThrown = false;
    ROOT::EnableImplicitMT();
-   RDataFrame d(0);
+   RDataFrame d(10);
+   bool hasThrown = false;
    try {
-      d.Range(0);
+      d.Filter([] { return true; }).Range(0);
    } catch (const std::exception &e) {
       hasThrown = true;
-      EXPECT_STREQ(e.what(), "Range was called with ImplicitMT enabled. Multi-thread ranges are not supported.");
+      EXPECT_STREQ(e.what(), "Range was called with ImplicitMT enabled after a Filter or a Range. Multi-thread ranges "
+                             "can only be applied directly to the dataset.");
    }
    EXPECT_TRUE(hasThrown);
+   EXPECT_ANY_THROW(d.Range(10).Range(5));
+   EXPECT_NO_THROW(d.Define("x", [] { return 42; }).Range(5));
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, EmptySource)
+{
+   ROOT::EnableImplicitMT();
+   RDataFrame d(1000);
+   auto c = d.Range(100, 200).Count();
+   auto m = d.Range(100, 200).Max<ULong64_t>("tdfentry_");
+   auto t = d.Range(5, 10, 3).Take<ULong64_t>("tdfentry_");
+   auto h = d.Head(10).Count();
+   auto s = d.Skip(990).Min<ULong64_t>("tdfentry_");
+   EXPECT_EQ(*c, 100u);
+   EXPECT_EQ(*m, 199u);
+   // entries are not processed in order in multi-thread event loops
+   auto tv = *t;
+   std::sort(tv.begin(), tv.end());
+   EXPECT_EQ(tv, std::vector<ULong64_t>({5, 8}));
+   EXPECT_EQ(*h, 10u);
+   EXPECT_EQ(*s, 990u);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, TreeWithManyClusters)
+{
+   const auto fileName = "dataframe_ranges_mt.root";
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(100); // many clusters
+      int x = 0;
+      t.Branch("x", &x);
+      for (x = 0; x < 1000; ++x)
+         t.Fill();
+      t.Write();
+   }
+
+   ROOT::EnableImplicitMT();
+   {
+      RDataFrame d("t", fileName);
+      auto r = d.Range(250, 430);
+      auto sum = r.Sum<int>("x");
+      auto min = r.Min<int>("x");
+      auto cnt = d.Skip(900).Count();
+      EXPECT_EQ(*sum, (250 + 429) * 180 / 2);
+      EXPECT_EQ(*min, 250);
+      EXPECT_EQ(*cnt, 100u);
+   }
+   {
+      // only the entries that overlap with the range are read
+      RDataFrame d("t", fileName);
+      std::atomic<unsigned int> nProcessed{0u};
+      auto c = d.Range(250, 430).Count();
+      c.OnPartialResultSlot(1, [&nProcessed](unsigned int, ULong64_t &) { ++nProcessed; });
+      EXPECT_EQ(*c, 180u);
+      EXPECT_EQ(nProcessed, 180u);
+   }
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDFRangesMT, UnboundedRangesOnChain)
+{
+   const std::vector<std::string> fileNames = {"dataframe_ranges_mt_0.root", "dataframe_ranges_mt_1.root"};
+   int x = 0;
+   for (const auto &fileName : fileNames) {
+      TFile f(fileName.c_str(), "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(100);
+      t.Branch("x", &x);
+      for (auto i = 0; i < 300; ++i, ++x)
+         t.Fill();
+      t.Write();
+   }
+
+   ROOT::EnableImplicitMT();
+   {
+      // the count does not let the range bound the event loop, the range still needs global entry numbers
+      RDataFrame d("t", fileNames);
+      auto sum = d.Range(250, 350).Sum<int>("x");
+      auto cnt = d.Count();
+      EXPECT_EQ(*sum, (250 + 349) * 100 / 2);
+      EXPECT_EQ(*cnt, 600u);
+   }
+   ROOT::DisableImplicitMT();
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
 }
 #endif
 
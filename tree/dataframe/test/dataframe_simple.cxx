@@ -660,6 +660,76 @@ TEST_P(RDFSimpleTests, StandardDeviationEmpty)
    EXPECT_DOUBLE_EQ(*stdDev, 0);
 }
 
+TEST_P(RDFSimpleTests, BulkMode)
+{
+   RDataFrame d(1000);
+   d.SetBulkSize(64); // not a divisor of the number of selected entries: the last block is partially filled
+   auto f = d.Define("x", [](ULong64_t e) { return double(e); }, {"tdfentry_"})
+               .Define("w", [](ULong64_t e) { return float(e % 3); }, {"tdfentry_"})
+               .Filter([](double x) { return int(x) % 2 == 0; }, {"x"});
+   auto sum = f.Sum<double>("x");
+   auto mean = f.Mean<double>("x");
+   auto min = f.Min<double>("x");
+   auto max = f.Max<double>("x");
+   auto h = f.Histo1D<double>("x");
+   auto hw = f.Histo1D<double, float>({"hw", "hw", 100, 0, 1000}, "x", "w");
+   auto count = f.Count(); // not bulk-capable, runs entry by entry
+
+   EXPECT_DOUBLE_EQ(*sum, 249500.);
+   EXPECT_DOUBLE_EQ(*mean, 499.);
+   EXPECT_DOUBLE_EQ(*min, 0.);
+   EXPECT_DOUBLE_EQ(*max, 998.);
+   EXPECT_EQ(h->GetEntries(), 500);
+   EXPECT_DOUBLE_EQ(h->GetMean(), 499.);
+   EXPECT_EQ(hw->GetEntries(), 500);
+   EXPECT_EQ(*count, 500ull);
+
+   // same results entry by entry
+   d.SetBulkSize(0);
+   auto hw2 = f.Histo1D<double, float>({"hw2", "hw2", 100, 0, 1000}, "x", "w");
+   for (auto i : ROOT::TSeqI(1, 101))
+      EXPECT_DOUBLE_EQ(hw->GetBinContent(i), hw2->GetBinContent(i));
+}
+
+TEST_P(RDFSimpleTests, BulkModeFillN)
+{
+   RDataFrame d(1000);
+   auto f = d.Define("x", [](ULong64_t e) { return double(e % 100); }, {"tdfentry_"})
+               .Define("y", [](ULong64_t e) { return float(e % 7); }, {"tdfentry_"})
+               .Define("z", [](ULong64_t e) { return int(e % 13); }, {"tdfentry_"})
+               .Define("w", [](ULong64_t e) { return 0.5 + e % 3; }, {"tdfentry_"})
+               .Filter([](double x) { return int(x) % 3 != 0; }, {"x"});
+   // Column types other than double are converted for TH1::FillN, TProfile2D is filled entry by entry
+   auto run = [&f]() {
+      auto h2 = f.Histo2D<double, float>({"h2", "h2", 10, 0, 100, 7, 0, 7}, "x", "y");
+      auto h2w = f.Histo2D<double, float, double>({"h2w", "h2w", 10, 0, 100, 7, 0, 7}, "x", "y", "w");
+      auto h3w = f.Histo3D<double, float, int, double>({"h3w", "h3w", 10, 0, 100, 7, 0, 7, 13, 0, 13}, "x", "y",
+                                                       "z", "w");
+      auto p1w = f.Profile1D<double, float, double>({"p1w", "p1w", 10, 0, 100}, "x", "y", "w");
+      auto p2 = f.Profile2D<double, float, int>({"p2", "p2", 10, 0, 100, 7, 0, 7}, "x", "y", "z");
+      std::vector<std::unique_ptr<TH1>> hists;
+      for (TH1 *h : {(TH1 *)h2.GetPtr(), (TH1 *)h2w.GetPtr(), (TH1 *)h3w.GetPtr(), (TH1 *)p1w.GetPtr(),
+                     (TH1 *)p2.GetPtr()})
+         hists.emplace_back(static_cast<TH1 *>(h->Clone()));
+      return hists;
+   };
+
+   d.SetBulkSize(64);
+   const auto bulk = run();
+   d.SetBulkSize(0);
+   const auto entryByEntry = run();
+
+   for (auto i : ROOT::TSeqI(bulk.size())) {
+      const auto &hb = *bulk[i];
+      const auto &he = *entryByEntry[i];
+      EXPECT_EQ(hb.GetEntries(), he.GetEntries()) << hb.GetName();
+      for (auto bin : ROOT::TSeqI(hb.GetNcells())) {
+         EXPECT_DOUBLE_EQ(hb.GetBinContent(bin), he.GetBinContent(bin)) << hb.GetName();
+         EXPECT_DOUBLE_EQ(hb.GetBinError(bin), he.GetBinError(bin)) << hb.GetName();
+      }
+   }
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_CASE_P(Seq, RDFSimpleTests, ::testing::Values(false));
 
@@ -200,7 +200,11 @@ void test_snapshot_options(RInterface<RLoopManager> &tdf)
    opts.fCompressionLevel = 6;
 
    const auto outfile = "snapshot_test_opts.root";
-   for (auto algorithm : {ROOT::kZLIB, ROOT::kLZMA, ROOT::kLZ4}) {
+   std::vector<ROOT::ECompressionAlgorithm> algorithms{ROOT::kZLIB, ROOT::kLZMA, ROOT::kLZ4};
+#ifdef R__HAS_ZSTD
+   algorithms.push_back(ROOT::kZSTD);
+#endif
+   for (auto algorithm : algorithms) {
       opts.fCompressionAlgorithm = algorithm;
 
       auto s = tdf.Snapshot<int>("t", outfile, {"ans"}, opts);
@@ -68,6 +68,7 @@ protected:
    TBranch    *fBranch{nullptr};              ///<Pointer to the basket support branch
    TBuffer    *fCompressedBufferRef{nullptr}; ///<! Compressed buffer.
    Int_t       fLastWriteBufferSize{0};       ///<! Size of the buffer last time we wrote it to disk
+   Bool_t      fAsyncWrite{kFALSE};           ///<! True if the basket is written by a task while its branch keeps filling
 
 public:
    // The IO bits flag is to provide improved forward-compatibility detection.
@@ -83,11 +84,12 @@ public:
    // in the fIOBits -- then the zombie flag will be set for this object.
    //
    enum class EIOBits : Char_t {
-      // The following to bits are reserved for now; when supported, set
-      // kSupported = kGenerateOffsetMap | kBasketClassMap
+      // The following bit is reserved for now; when supported, set
+      // kSupported = kGenerateOffsetMap | kGenerateZoneMap | kBasketClassMap
       kGenerateOffsetMap = BIT(0),
-      // kBasketClassMap = BIT(1),
-      kSupported = kGenerateOffsetMap
+      kGenerateZoneMap = BIT(1),
+      // kBasketClassMap = BIT(2),
+      kSupported = kGenerateOffsetMap | kGenerateZoneMap
    };
    // This enum covers IOBits that are known to this ROOT release but
    // not supported; provides a mechanism for us to have experimental
@@ -96,7 +98,7 @@ public:
    // (kUnsupported | kSupported) should result in the '|' of all IOBits.
    enum class EUnsupportedIOBits : Char_t { kUnsupported = 0 };
    // The number of known, defined IOBits.
-   static constexpr int kIOBitCount = 1;
+   static constexpr int kIOBitCount = 2;
 
    TBasket();
    TBasket(TDirectory *motherDir);
@@ -119,6 +121,8 @@ public:
            Int_t   GetLast() const {return fLast;}
    virtual void    MoveEntries(Int_t dentries);
    virtual void    PrepareBasket(Long64_t /* entry */) {};
+           void    PrepareAsyncWrite();
+           Int_t   RecompressBuffer(Int_t compress);
            Int_t   ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file);
            Int_t   ReadBasketBytes(Long64_t pos, TFile *file);
    virtual void    Reset();
@@ -106,6 +106,8 @@ protected:
    Int_t      *fBasketBytes;      ///<[fMaxBaskets] Length of baskets on file
    Long64_t   *fBasketEntry;      ///<[fMaxBaskets] Table of first entry in each basket
    Long64_t   *fBasketSeek;       ///<[fMaxBaskets] Addresses of baskets on file
+   Double_t   *fBasketMin;        ///<[fMaxBaskets] Smallest value stored in each basket (zone map, see GetValueRange)
+   Double_t   *fBasketMax;        ///<[fMaxBaskets] Largest value stored in each basket (zone map, see GetValueRange)
    TTree      *fTree;             ///<! Pointer to Tree header
    TBranch    *fMother;           ///<! Pointer to top-level parent branch in the tree.
    TBranch    *fParent;           ///<! Pointer to parent branch.
@@ -142,7 +144,10 @@ protected:
 
 private:
    Int_t FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
+   Int_t    PrepareBulkRead(Long64_t entry, char *&data, Int_t &entrySize);
    Int_t    WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *);
+   void     FinishAsyncWriteBasket(TBasket* basket, Int_t where, Int_t nout);
+   void     UpdateZoneMap(TBasket* basket);
    TBranch(const TBranch&) = delete;             // not implemented
    TBranch& operator=(const TBranch&) = delete;  // not implemented
 
@@ -172,6 +177,7 @@ public:
            Long64_t *GetBasketEntry() const {return fBasketEntry;}
    virtual Long64_t  GetBasketSeek(Int_t basket) const;
    virtual Int_t     GetBasketSize() const {return fBasketSize;}
+           Int_t     GetBulkEntries(Long64_t entry, TBuffer &user_buf);
    virtual TList    *GetBrowsables();
    virtual const char* GetClassName() const;
            Int_t     GetCompressionAlgorithm() const;
@@ -180,6 +186,7 @@ public:
    TDirectory       *GetDirectory() const {return fDirectory;}
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall = 0);
    virtual Int_t     GetEntryExport(Long64_t entry, Int_t getall, TClonesArray *list, Int_t n);
+           Int_t     GetEntriesSerialized(Long64_t entry, TBuffer &user_buf);
            Int_t     GetEntryOffsetLen() const { return fEntryOffsetLen; }
            Int_t     GetEvent(Long64_t entry=0) {return GetEntry(entry);}
    const char       *GetIconName() const;
@@ -204,6 +211,7 @@ public:
            Int_t     GetNleaves()     const {return fNleaves;}
            Int_t     GetSplitLevel()  const {return fSplitLevel;}
            Long64_t  GetEntries()     const {return fEntries;}
+           Bool_t    GetValueRange(Long64_t first, Long64_t last, Double_t &min, Double_t &max) const;
            TTree    *GetTree()        const {return fTree;}
    virtual Int_t     GetRow(Int_t row);
    virtual Bool_t    GetMakeClass() const;
@@ -246,7 +254,7 @@ public:
 
    static  void      ResetCount();
 
-   ClassDef(TBranch, 13); // Branch descriptor
+   ClassDef(TBranch, 14); // Branch descriptor
 };
 
 //______________________________________________________________________________
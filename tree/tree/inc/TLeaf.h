@@ -53,6 +53,9 @@ protected:
                                                                   // polymorphism!), this will generate an appropriate
                                                                   // offset array.
 
+   Bool_t ReadBasketFastImpl(TBuffer &b, Long64_t n); // Byteswap n fixed-size entries in place.
+   static void ByteSwapInPlace(char *data, Long64_t n, Int_t size);
+
 public:
    enum EStatusBits {
       kIndirectAddress = BIT(11), ///< Data member is a pointer to an array of basic types.
@@ -101,6 +104,7 @@ public:
    virtual void     PrintValue(Int_t i = 0) const;
    virtual void     ReadBasket(TBuffer &) {}
    virtual void     ReadBasketExport(TBuffer &, TClonesArray *, Int_t) {}
+   virtual Bool_t   ReadBasketFast(TBuffer &, Long64_t) { return kFALSE; } // overload for fixed-size leaves supporting bulk reads
    virtual void     ReadValue(std::istream & /*s*/, Char_t /*delim*/ = ' ') {
       Error("ReadValue", "Not implemented!");
    }
@@ -139,7 +139,10 @@ private:
    mutable Bool_t fIMTFlush{false};               ///<! True if we are doing a multithreaded flush.
    mutable std::atomic<Long64_t> fIMTTotBytes;    ///<! Total bytes for the IMT flush baskets
    mutable std::atomic<Long64_t> fIMTZipBytes;    ///<! Zip bytes for the IMT flush baskets.
+   Bool_t fAsyncBasketWrite{kFALSE};              ///<! True if full baskets are written asynchronously by TTree::Fill.
+   mutable ROOT::Internal::TBranchIMTHelper *fAsyncWriteHelper{nullptr}; ///<! Tasks writing full baskets, if fAsyncBasketWrite.
 
+   void             CollectAsyncBasketWrites() const;
    void             InitializeBranchLists(bool checkLeafCount);
    void             SortBranchesByTime();
 
@@ -365,6 +368,7 @@ public:
    virtual const char     *GetAlias(const char* aliasName) const;
    virtual Long64_t        GetAutoFlush() const {return fAutoFlush;}
    virtual Long64_t        GetAutoSave()  const {return fAutoSave;}
+   Bool_t                  GetAsyncBasketWrite() const { return fAsyncBasketWrite; }
    virtual TBranch        *GetBranch(const char* name);
    virtual TBranchRef     *GetBranchRef() const { return fBranchRef; };
    virtual Bool_t          GetBranchStatus(const char* branchname) const;
@@ -499,6 +503,7 @@ public:
    virtual Long64_t        Scan(const char* varexp = "", const char* selection = "", Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0); // *MENU*
    virtual Bool_t          SetAlias(const char* aliasName, const char* aliasFormula);
    virtual void            SetAutoSave(Long64_t autos = -300000000);
+   void                    SetAsyncBasketWrite(Bool_t enable = kTRUE);
    virtual void            SetAutoFlush(Long64_t autof = -30000000);
    virtual void            SetBasketSize(const char* bname, Int_t buffsize = 16000);
 #if !defined(__CINT__)
@@ -571,6 +576,7 @@ public:
    virtual Int_t           StopCacheLearningPhase();
    virtual Int_t           UnbinnedFit(const char* funcname, const char* varexp, const char* selection = "", Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0);
    void                    UseCurrentStyle();
+   void                    WaitAsyncBasketWrite() const;
    virtual Int_t           Write(const char *name=0, Int_t option=0, Int_t bufsize=0);
    virtual Int_t           Write(const char *name=0, Int_t option=0, Int_t bufsize=0) const;
 
@@ -67,6 +67,9 @@ protected:
    EPrefillType fPrefillType;         ///<  Whether a pre-filling is enabled (and if applicable which type)
    static Int_t fgLearnEntries;       ///<  number of entries used for learning mode
    Bool_t       fAutoCreated{kFALSE}; ///<! true if cache was automatically created
+   Int_t        fReadAheadClusters{0};  ///<! Number of clusters read in advance in a background thread
+   Long64_t     fReadAheadFirst{-1};    ///<! First entry of the clusters scheduled for read-ahead
+   Long64_t     fReadAheadEntry{-1};    ///<! First entry of the clusters not yet scheduled for read-ahead
 
    // These members hold cached data for missed branches when miss optimization
    // is enabled.  Pointers are only initialized if the miss cache is enabled.
@@ -125,6 +128,8 @@ private:
    TBranch *CalculateMissEntries(Long64_t, int, bool);    ///< Given an file read, try to determine the corresponding branch.
    Bool_t   ProcessMiss(Long64_t pos, int len); ///<! Given a file read not in the miss cache, handle (possibly) loading the data.
 
+   void     ScheduleReadAhead(TTree *tree);     ///< Submit the baskets of the clusters following the cache content for read-ahead.
+
 public:
 
    TTreeCache();
@@ -143,6 +148,7 @@ public:
    Double_t             GetEfficiencyRel() const;
    virtual Int_t        GetEntryMin() const {return fEntryMin;}
    virtual Int_t        GetEntryMax() const {return fEntryMax;}
+   Int_t                GetReadAheadClusters() const {return fReadAheadClusters;}
    static Int_t         GetLearnEntries();
    virtual EPrefillType GetLearnPrefill() const {return fPrefillType;}
    Double_t             GetMissEfficiency() const;
@@ -167,6 +173,7 @@ public:
    virtual void         SetFile(TFile *file, TFile::ECacheAction action=TFile::kDisconnect);
    virtual void         SetLearnPrefill(EPrefillType type = kNoPrefill);
    static void          SetLearnEntries(Int_t n = 10);
+   void                 SetReadAheadClusters(Int_t n);
    void                 SetOptimizeMisses(Bool_t opt);
    void                 StartLearningPhase();
    virtual void         StopLearningPhase();
@@ -75,9 +75,10 @@ protected:
       void   SetUntouched(Int_t index);
       void   SetProgress(Int_t index);
       void   SetFinished(Int_t index);
-      void   SetMissed(Int_t index);
+      Int_t  SetMissed(Int_t index);
       void   SetUnzipped(Int_t index, char* buf, Int_t len);
       Bool_t TryUnzipping(Int_t index);
+      Int_t  Discard(Int_t index);
    };
 
    typedef struct UnzipState UnzipState_t;
@@ -102,6 +103,14 @@ protected:
    Int_t       fNseekMax;         ///<!  fNseek can change so we need to know its max size
    Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
    Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
+   std::atomic<Long64_t> fUnzipPendingBytes; ///<! Size of the unzipped blocks not yet picked up by the baskets
+   std::atomic<Bool_t>   fUnzipThrottled;    ///<! True if the tasks stopped because fUnzipBufferSize was reached
+   Bool_t                fUnzipScheduled;    ///<! True if unzipping tasks were created for the current cache content
+   std::vector<Long64_t> fSeekEntry;         ///<! [fNseek] First entry of each prefetched basket, gives the reading order
+   std::vector<Long64_t> fSeekEntryEnd;      ///<! [fNseek] Entry after the last one of each prefetched basket
+   std::vector<Int_t>    fDiscardOrder;      ///<! Prefetched baskets sorted by fSeekEntryEnd
+   Int_t                 fDiscardNext;       ///<! First basket of fDiscardOrder that the reader may still need
+   std::vector<Int_t>    fDiscardLater;      ///<! Baskets the reader moved past while they were being unzipped
 
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
@@ -110,6 +119,7 @@ protected:
    Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
    Int_t       fNStalls;          ///<! number of hits which caused a stall
    Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   Int_t       fNThrottled;       ///<! number of times the unzipping tasks were paused by a full unzip buffer
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &);            //this class cannot be copied
@@ -120,6 +130,8 @@ private:
 
    // Private methods
    void  Init();
+   void  ReleaseUnzipped(Long64_t len);
+   void  DiscardUnzipped(Long64_t entry);
 
 public:
    TTreeCacheUnzip();
@@ -158,6 +170,8 @@ public:
    Int_t  GetNUnzip() { return fNUnzip; }
    Int_t  GetNMissed(){ return fNMissed; }
    Int_t  GetNFound() { return fNFound; }
+   Int_t  GetNThrottled() { return fNThrottled; }
+   Long64_t GetUnzipPendingBytes() const { return fUnzipPendingBytes; }
 
    void Print(Option_t* option = "") const;
 
@@ -59,6 +59,7 @@ class TTreeCloner {
 
    UInt_t     fCloneMethod;      ///< Indicates which cloning method was selected.
    Long64_t   fToStartEntries;   ///< Number of entries in the target tree before any addition.
+   Bool_t     fRecompress;       ///< True if the baskets are recompressed when the input and output branch compression settings differ.
 
    Int_t           fCacheSize;   ///< Requested size of the file cache
    TFileCacheRead *fFileCache;   ///< File Cache used to reduce the number of individual reads
@@ -92,6 +93,7 @@ class TTreeCloner {
    void CreateCache();
    UInt_t FillCache(UInt_t from);
    void RestoreCache();
+   void WriteRecompressedBaskets();
 
 private:
    TTreeCloner(const TTreeCloner&) = delete;
@@ -26,6 +26,7 @@
 #include "RZip.h"
 
 #include <bitset>
+#include <memory>
 
 const UInt_t kDisplacementMask = 0xFF000000;  // In the streamer the two highest bytes of
                                               // the fEntryOffset are used to stored displacement.
@@ -61,6 +62,9 @@ TBasket::TBasket(const char *name, const char *title, TBranch *branch)
    : TKey(branch->GetDirectory()), fBufferSize(branch->GetBasketSize()), fNevBufSize(branch->GetEntryOffsetLen()),
      fHeaderOnly(kTRUE), fIOBits(branch->GetIOFeatures().GetFeatures())
 {
+   // The zone map is kept by the branch and does not change the basket
+   // layout: do not flag it, so that older releases can still read the basket.
+   fIOBits &= ~static_cast<UChar_t>(EIOBits::kGenerateZoneMap);
    SetName(name);
    SetTitle(title);
    fClassName   = "TBasket";
@@ -293,6 +297,88 @@ Int_t TBasket::LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tr
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Recompress the content of a basket loaded by LoadBasketBuffers with the
+/// compression settings `compress`, without unstreaming it.
+/// The payload (data and entry offsets) is uncompressed and compressed again
+/// as an opaque block; the key header is updated by CopyTo when the basket
+/// is written. This function does not access any file, so several baskets
+/// can be recompressed concurrently.
+/// This function is called by TTreeCloner.
+/// The function returns 0 in case of success, 1 in case of error, in which
+/// case the basket is left unchanged.
+
+Int_t TBasket::RecompressBuffer(Int_t compress)
+{
+   if (!fBufferRef || fObjlen <= 0 || fKeylen <= 0 || fNbytes <= fKeylen) {
+      return 1;
+   }
+   const Int_t nraw = fNbytes - fKeylen;
+
+   // Uncompress the payload, unless it was stored as is.
+   std::unique_ptr<char[]> objbuf;
+   char *obj = fBufferRef->Buffer() + fKeylen;
+   if (fObjlen > nraw) {
+      objbuf.reset(new char[fObjlen]);
+      UChar_t *src = (UChar_t *)obj;
+      UChar_t *tgt = (UChar_t *)objbuf.get();
+      Int_t nin, nbuf, nout = 0, noutot = 0, nintot = 0;
+      while (noutot < fObjlen && nintot < nraw) {
+         if (R__unzip_header(&nin, src, &nbuf) != 0 || nintot + nin > nraw || noutot + nbuf > fObjlen) {
+            break;
+         }
+         R__unzip(&nin, src, &nbuf, tgt, &nout);
+         if (!nout) break;
+         noutot += nout;
+         nintot += nin;
+         src += nin;
+         tgt += nout;
+      }
+      if (noutot != fObjlen) {
+         return 1;
+      }
+      obj = objbuf.get();
+   }
+
+   // Compress it with the new settings. As in WriteBuffer, the payload is
+   // stored as is when it does not compress.
+   Int_t cxlevel = compress < 0 ? 0 : compress % 100;
+   ROOT::ECompressionAlgorithm cxAlgorithm = static_cast<ROOT::ECompressionAlgorithm>(compress < 0 ? 0 : compress / 100);
+   std::unique_ptr<char[]> zipbuf;
+   Int_t noutot = 0;
+   if (cxlevel > 0) {
+      Int_t nbuffers = 1 + (fObjlen - 1) / kMAXZIPBUF;
+      zipbuf.reset(new char[fObjlen + 9 * nbuffers + 28]);
+      char *objcur = obj;
+      char *bufcur = zipbuf.get();
+      for (Int_t i = 0; i < nbuffers; ++i) {
+         Int_t bufmax = (i == nbuffers - 1) ? fObjlen - i * kMAXZIPBUF : kMAXZIPBUF;
+         Int_t nout = 0;
+         R__zipMultipleAlgorithm(cxlevel, &bufmax, objcur, &bufmax, bufcur, &nout, cxAlgorithm);
+         if (nout == 0 || noutot + nout >= fObjlen) {
+            noutot = 0;
+            break;
+         }
+         objcur += kMAXZIPBUF;
+         bufcur += nout;
+         noutot += nout;
+      }
+   }
+
+   const char *payload = noutot ? zipbuf.get() : obj;
+   const Int_t npayload = noutot ? noutot : fObjlen;
+   if (payload == fBufferRef->Buffer() + fKeylen) {
+      // Stored uncompressed before and after.
+      return 0;
+   }
+   if (fBufferRef->BufferSize() < fKeylen + npayload) {
+      fBufferRef->Expand(fKeylen + npayload);
+   }
+   memcpy(fBufferRef->Buffer() + fKeylen, payload, npayload);
+   fNbytes = fKeylen + npayload;
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove the first dentries of this basket, moving entries at
 /// dentries to the start of the buffer.
@@ -460,6 +546,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    Bool_t oldCase;
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
+   const char *mappedBuffer = nullptr;
 
    // See if the cache has already unzipped the buffer for us.
    TFileCacheRead *pf = nullptr;
@@ -494,14 +581,30 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    // and we will re-add the new size later on.
    fBranch->GetTree()->IncrementTotalBuffers(-fBufferSize);
 
-   // Initialize the buffer to hold the compressed data.
-   readBufferRef = R__InitializeReadBasketBuffer(readBufferRef, len, file);
-   if (!readBufferRef) {
-      Error("ReadBasketBuffers", "Unable to allocate buffer.");
-      return 1;
+   // If the file is memory-mapped, decompress straight from the mapped pages
+   // rather than copying the compressed basket first.
+   if (R__likely(fBranch->GetCompressionLevel() != 0) && file->IsMapped()) {
+      R__LOCKGUARD_IMT(gROOTMutex); // Lock for parallel TTree I/O
+      mappedBuffer = file->GetMappedBuffer(pos, len);
    }
 
-   if (pf) {
+   if (!mappedBuffer) {
+      // Initialize the buffer to hold the compressed data.
+      readBufferRef = R__InitializeReadBasketBuffer(readBufferRef, len, file);
+      if (!readBufferRef) {
+         Error("ReadBasketBuffers", "Unable to allocate buffer.");
+         return 1;
+      }
+   }
+
+   if (mappedBuffer) {
+      // The buffer does not own the (read-only) mapped memory; one wrapper per
+      // thread is pointed at each mapped basket in turn.
+      static thread_local TBufferFile mappedBufferRef(TBuffer::kRead, 0);
+      mappedBufferRef.SetBuffer(const_cast<char *>(mappedBuffer), len, kFALSE);
+      mappedBufferRef.SetParent(file);
+      readBufferRef = &mappedBufferRef;
+   } else if (pf) {
       TVirtualPerfStats* temp = gPerfStats;
       if (fBranch->GetTree()->GetPerfStats() != 0) gPerfStats = fBranch->GetTree()->GetPerfStats();
       Int_t st = 0;
@@ -979,6 +1082,22 @@ void TBasket::Update(Int_t offset, Int_t skipped)
    fNevBuf++;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the basket to be written by a task while its branch keeps filling
+/// (see TTree::SetAsyncBasketWrite).
+///
+/// The key cycle is fixed now, as the branch's write basket number moves on,
+/// and the basket stops sharing the branch's transient compression buffer,
+/// since several baskets of the same branch may be compressed concurrently.
+
+void TBasket::PrepareAsyncWrite()
+{
+   fAsyncWrite = kTRUE;
+   fCycle = fBranch->GetWriteBasket();
+   if (!fOwnsCompressedBuffer)
+      fCompressedBufferRef = nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write buffer of this basket on the current file.
 ///
@@ -1067,7 +1186,7 @@ Int_t TBasket::WriteBuffer()
    fObjlen    = lbuf - fKeylen;
 
    fHeaderOnly = kTRUE;
-   fCycle = fBranch->GetWriteBasket();
+   if (!fAsyncWrite) fCycle = fBranch->GetWriteBasket();
    Int_t cxlevel = fBranch->GetCompressionLevel();
    ROOT::ECompressionAlgorithm cxAlgorithm = static_cast<ROOT::ECompressionAlgorithm>(fBranch->GetCompressionAlgorithm());
    if (cxlevel > 0) {
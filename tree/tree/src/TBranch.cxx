@@ -106,6 +106,8 @@ TBranch::TBranch()
 , fBasketBytes(0)
 , fBasketEntry(0)
 , fBasketSeek(0)
+, fBasketMin(0)
+, fBasketMax(0)
 , fTree(0)
 , fMother(0)
 , fParent(0)
@@ -210,6 +212,8 @@ TBranch::TBranch(TTree *tree, const char *name, void *address, const char *leafl
 , fBasketBytes(0)
 , fBasketEntry(0)
 , fBasketSeek(0)
+, fBasketMin(0)
+, fBasketMax(0)
 , fTree(tree)
 , fMother(0)
 , fParent(0)
@@ -262,6 +266,8 @@ TBranch::TBranch(TBranch *parent, const char *name, void *address, const char *l
 , fBasketBytes(0)
 , fBasketEntry(0)
 , fBasketSeek(0)
+, fBasketMin(0)
+, fBasketMax(0)
 , fTree(parent ? parent->GetTree() : 0)
 , fMother(parent ? parent->GetMother() : 0)
 , fParent(parent)
@@ -439,6 +445,12 @@ TBranch::~TBranch()
    delete [] fBasketBytes;
    fBasketBytes = 0;
 
+   delete [] fBasketMin;
+   fBasketMin = 0;
+
+   delete [] fBasketMax;
+   fBasketMax = 0;
+
    fBaskets.Delete();
    fNBaskets = 0;
    fCurrentBasket = 0;
@@ -552,10 +564,19 @@ void TBranch::AddBasket(TBasket& b, Bool_t ondisk, Long64_t startEntry)
             fBasketEntry[j] = fBasketEntry[j-1];
             fBasketBytes[j] = fBasketBytes[j-1];
             fBasketSeek[j]  = fBasketSeek[j-1];
+            if (fBasketMin) {
+               fBasketMin[j] = fBasketMin[j-1];
+               fBasketMax[j] = fBasketMax[j-1];
+            }
          }
       }
    }
    fBasketEntry[where] = startEntry;
+   if (fBasketMin) {
+      // The range of the values of a basket coming from elsewhere is unknown.
+      fBasketMin[where] = -TMath::Infinity();
+      fBasketMax[where] = TMath::Infinity();
+   }
 
    if (ondisk) {
       fBasketBytes[where] = basket->GetNbytes();  // not for in mem
@@ -792,6 +813,12 @@ void TBranch::ExpandBasketArrays()
                                                 newsize*sizeof(Long64_t),fMaxBaskets*sizeof(Long64_t));
    fBasketSeek   = (Long64_t*)TStorage::ReAlloc(fBasketSeek,
                                                 newsize*sizeof(Long64_t),fMaxBaskets*sizeof(Long64_t));
+   if (fBasketMin) {
+      fBasketMin = (Double_t*)TStorage::ReAlloc(fBasketMin,
+                                                newsize*sizeof(Double_t),fMaxBaskets*sizeof(Double_t));
+      fBasketMax = (Double_t*)TStorage::ReAlloc(fBasketMax,
+                                                newsize*sizeof(Double_t),fMaxBaskets*sizeof(Double_t));
+   }
 
    fMaxBaskets   = newsize;
 
@@ -801,6 +828,10 @@ void TBranch::ExpandBasketArrays()
       fBasketBytes[i] = 0;
       fBasketEntry[i] = 0;
       fBasketSeek[i]  = 0;
+      if (fBasketMin) {
+         fBasketMin[i] = -TMath::Infinity();
+         fBasketMax[i] = TMath::Infinity();
+      }
    }
 }
 
@@ -853,6 +884,9 @@ Int_t TBranch::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
       ++fEntries;
       ++fEntryNumber;
       (this->*fFillLeaves)(*buf);
+      if (fIOFeatures.Test(ROOT::Experimental::EIOFeatures::kGenerateZoneMap)) {
+         UpdateZoneMap(basket);
+      }
       if (buf->GetMapCount()) {
          // The map is used.
          ResetBit(TBranch::kDoNotUseBufferMap);
@@ -1404,6 +1438,135 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
    return buf->Length() - bufbegin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Locate and load the basket holding entry for a bulk read.
+///
+/// On success, data points to the on-file representation of entry inside the
+/// basket buffer, entrySize is the number of bytes per entry and the number
+/// of entries from entry to the end of the basket is returned.
+/// Returns -1 if the branch does not support bulk reads (it must be a plain
+/// TBranch with a single, fixed-size leaf) or on I/O errors.
+
+Int_t TBranch::PrepareBulkRead(Long64_t entry, char *&data, Int_t &entrySize)
+{
+   if (IsA() != TBranch::Class() || fNleaves != 1) {
+      return -1;
+   }
+   TLeaf *leaf = static_cast<TLeaf *>(fLeaves.UncheckedAt(0));
+   if (leaf->GetLeafCount()) {
+      return -1;
+   }
+   if ((entry < fFirstEntry) || (entry >= fEntryNumber)) {
+      return -1;
+   }
+
+   TBasket *basket;
+   Long64_t first;
+   if (fFirstBasketEntry <= entry && entry < fNextBasketEntry && fCurrentBasket) {
+      basket = fCurrentBasket;
+      first = fFirstBasketEntry;
+   } else {
+      fReadBasket = TMath::BinarySearch(fWriteBasket + 1, fBasketEntry, entry);
+      if (fReadBasket < 0) {
+         fNextBasketEntry = -1;
+         Error("PrepareBulkRead", "In the branch %s, no basket contains the entry %lld\n", GetName(), entry);
+         return -1;
+      }
+      if (fReadBasket == fWriteBasket) {
+         fNextBasketEntry = fEntryNumber;
+      } else {
+         fNextBasketEntry = fBasketEntry[fReadBasket + 1];
+      }
+      first = fFirstBasketEntry = fBasketEntry[fReadBasket];
+      basket = GetBasket(fReadBasket);
+      if (!basket) {
+         fCurrentBasket = 0;
+         fFirstBasketEntry = -1;
+         fNextBasketEntry = -1;
+         return -1;
+      }
+      fCurrentBasket = basket;
+   }
+
+   TBuffer *buf = basket->GetBufferRef();
+   if (R__unlikely(!buf)) {
+      TFile *file = GetFile(0);
+      if (!file) return -1;
+      basket->ReadBasketBuffers(fBasketSeek[fReadBasket], fBasketBytes[fReadBasket], file);
+      buf = basket->GetBufferRef();
+      if (!buf) return -1;
+   }
+   if (R__unlikely(!buf->IsReading())) {
+      basket->SetReadMode();
+   }
+   if (basket->GetEntryOffset()) {
+      // Variable size entries, the data of consecutive entries is not contiguous.
+      return -1;
+   }
+
+   entrySize = basket->GetNevBufSize();
+   data = buf->Buffer() + basket->GetKeylen() + (entry - first) * entrySize;
+   return fNextBasketEntry - entry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read, in one go, all the entries from entry to the end of the basket
+/// containing it and deserialize them into user_buf.
+///
+/// This is only supported for branches with a single leaf of a fundamental
+/// type or a fixed-size array of it (e.g. "x/F" or "x[3]/D"). After the call
+/// user_buf.Buffer() holds the values of the returned number of entries,
+/// contiguous and in the in-memory representation. user_buf is expanded as
+/// needed; it should be created in read mode, e.g. `TBufferFile b(TBuffer::kRead, 10000)`.
+///
+/// The function returns the number of entries read, or -1 if the branch does
+/// not support bulk reads or in case of I/O errors.
+/// In contrast to GetEntry, the leaf addresses are not updated.
+
+Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
+{
+   char *data = nullptr;
+   Int_t entrySize = 0;
+   Int_t n = PrepareBulkRead(entry, data, entrySize);
+   if (n < 0) {
+      return -1;
+   }
+   Int_t size = n * entrySize;
+   if (!user_buf.TestBit(TBuffer::kIsOwner) || user_buf.BufferSize() < size) {
+      user_buf.SetBuffer(new char[size], size, kTRUE);
+   }
+   memcpy(user_buf.Buffer(), data, size);
+   user_buf.SetBufferOffset(0);
+
+   TLeaf *leaf = static_cast<TLeaf *>(fLeaves.UncheckedAt(0));
+   if (!leaf->ReadBasketFast(user_buf, n)) {
+      return -1;
+   }
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Same as GetBulkEntries but without deserialization: user_buf is set to
+/// point directly into the basket buffer and contains the entries in their
+/// on-file (big-endian) representation. No copy is made; user_buf does not
+/// own the data, which is only valid until the next basket is read by this
+/// branch.
+///
+/// The function returns the number of entries available in user_buf, or -1
+/// if the branch does not support bulk reads or in case of I/O errors.
+
+Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf)
+{
+   char *data = nullptr;
+   Int_t entrySize = 0;
+   Int_t n = PrepareBulkRead(entry, data, entrySize);
+   if (n < 0) {
+      return -1;
+   }
+   user_buf.SetBuffer(data, n * entrySize, kFALSE);
+   return n;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of an entry and export buffers to real objects in a TClonesArray list.
 ///
@@ -1835,6 +1998,34 @@ ROOT::TIOFeatures TBranch::GetIOFeatures() const
    return fIOFeatures;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Get the range [min, max] of the values stored in the entries `first` to
+/// `last` (included) of this branch from the zone map of the baskets holding
+/// them.
+///
+/// The zone map is only recorded for branches with a single numerical leaf
+/// written with ROOT::Experimental::EIOFeatures::kGenerateZoneMap set; for
+/// the other branches false is returned.  The range of a basket whose values
+/// are not known (e.g. written before the feature was set, or holding a NaN)
+/// is [-inf, +inf].  If none of the entries holds a value (e.g. they are all
+/// empty arrays) min is greater than max.
+
+Bool_t TBranch::GetValueRange(Long64_t first, Long64_t last, Double_t &min, Double_t &max) const
+{
+   if (!fBasketMin || first < 0 || first > last || last >= fEntryNumber) return kFALSE;
+
+   Int_t basket = TMath::BinarySearch(fWriteBasket + 1, fBasketEntry, first);
+   if (basket < 0) return kFALSE;
+
+   min = TMath::Infinity();
+   max = -TMath::Infinity();
+   for (; basket <= fWriteBasket && fBasketEntry[basket] <= last; ++basket) {
+      if (fBasketMin[basket] < min) min = fBasketMin[basket];
+      if (fBasketMax[basket] > max) max = fBasketMax[basket];
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return kTRUE if an existing object in a TBranchObject must be deleted.
 
@@ -2111,6 +2302,18 @@ void TBranch::Refresh(TBranch* b)
       fBasketEntry[i] = b->fBasketEntry[i];
       fBasketSeek[i]  = b->fBasketSeek[i];
    }
+   delete [] fBasketMin;
+   delete [] fBasketMax;
+   fBasketMin = 0;
+   fBasketMax = 0;
+   if (b->fBasketMin) {
+      fBasketMin = new Double_t[fMaxBaskets];
+      fBasketMax = new Double_t[fMaxBaskets];
+      for (i=0;i<fMaxBaskets;i++) {
+         fBasketMin[i] = b->fBasketMin[i];
+         fBasketMax[i] = b->fBasketMax[i];
+      }
+   }
    fBaskets.Delete();
    Int_t nbaskets = b->fBaskets.GetSize();
    fBaskets.Expand(nbaskets);
@@ -2163,6 +2366,12 @@ void TBranch::Reset(Option_t*)
       }
    }
 
+   // The zone map is allocated again by the next Fill.
+   delete [] fBasketMin;
+   delete [] fBasketMax;
+   fBasketMin = 0;
+   fBasketMax = 0;
+
    fBaskets.Delete();
    fNBaskets = 0;
 }
@@ -2204,6 +2413,12 @@ void TBranch::ResetAfterMerge(TFileMergeInfo *)
       }
    }
 
+   // The zone map is allocated again by the next Fill.
+   delete [] fBasketMin;
+   delete [] fBasketMax;
+   fBasketMin = 0;
+   fBasketMax = 0;
+
    TBasket *reusebasket = (TBasket*)fBaskets[fWriteBasket];
    if (reusebasket) {
       fBaskets[fWriteBasket] = 0;
@@ -2785,6 +3000,28 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
       fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
    }
 
+   if (imtHelper && imtHelper->IsAsync() && where == fWriteBasket) {
+      // Hand the full basket over to a task which compresses and writes it,
+      // and carry on filling a fresh basket. The task does not touch the
+      // branch: its bookkeeping is done by FinishAsyncWriteBasket, called
+      // from the filling thread once the basket is written.
+      basket->PrepareAsyncWrite();
+      fBaskets[where] = 0;
+      if (basket == fCurrentBasket) {
+         fCurrentBasket    = 0;
+         fFirstBasketEntry = -1;
+         fNextBasketEntry  = -1;
+      }
+      ++fWriteBasket;
+      if (fWriteBasket >= fMaxBaskets) {
+         ExpandBasketArrays();
+      }
+      fBaskets.AddAtAndExpand(0,fWriteBasket);
+      fBasketEntry[fWriteBasket] = fEntryNumber;
+      imtHelper->WriteAsync(basket, where);
+      return 0;
+   }
+
    // Note: captures `basket`, `where`, and `this` by value; modifies the TBranch and basket,
    // as we make a copy of the pointer.  We cannot capture `basket` by reference as the pointer
    // itself might be modified after `WriteBasketImpl` exits.
@@ -2843,6 +3080,73 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record the position and size of a basket written asynchronously in slot
+/// `where` and release it. `nout` is the value returned by TBasket::WriteBuffer.
+
+void TBranch::FinishAsyncWriteBasket(TBasket* basket, Int_t where, Int_t nout)
+{
+   if (nout < 0) Error("TBranch::WriteBasketImpl", "basket's WriteBuffer failed.\n");
+   fBasketBytes[where] = basket->GetNbytes();
+   fBasketSeek[where]  = basket->GetSeekKey();
+   if (nout > 0) {
+      Int_t addbytes = basket->GetObjlen() + basket->GetKeylen();
+      fZipBytes += nout;
+      fTotBytes += addbytes;
+      fTree->AddTotBytes(addbytes);
+      fTree->AddZipBytes(nout);
+   }
+   --fNBaskets;
+   basket->DropBuffers();
+   delete basket;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Extend the zone map of the current write basket with the values just
+/// filled, see GetValueRange.
+///
+/// The zone map is allocated when the first basket is started after the
+/// ROOT::Experimental::EIOFeatures::kGenerateZoneMap feature is set, for
+/// plain branches with a single numerical leaf only.
+
+void TBranch::UpdateZoneMap(TBasket* basket)
+{
+   const Bool_t newBasket = basket->GetNevBuf() == 1;
+   TLeaf *leaf = (TLeaf*)fLeaves.UncheckedAt(0);
+   if (!fBasketMin) {
+      if (!newBasket || IsA() != TBranch::Class() || fNleaves != 1) return;
+      TClass *cl = leaf->IsA();
+      if (cl != TLeafB::Class() && cl != TLeafS::Class() && cl != TLeafI::Class() && cl != TLeafL::Class() &&
+          cl != TLeafF::Class() && cl != TLeafD::Class() && cl != TLeafO::Class()) {
+         return;
+      }
+      fBasketMin = new Double_t[fMaxBaskets];
+      fBasketMax = new Double_t[fMaxBaskets];
+      for (Int_t i = 0; i < fMaxBaskets; ++i) {
+         fBasketMin[i] = -TMath::Infinity();
+         fBasketMax[i] = TMath::Infinity();
+      }
+   }
+
+   Double_t &min = fBasketMin[fWriteBasket];
+   Double_t &max = fBasketMax[fWriteBasket];
+   if (newBasket) {
+      min = TMath::Infinity();
+      max = -TMath::Infinity();
+   }
+   const Int_t len = leaf->GetLen();
+   for (Int_t i = 0; i < len; ++i) {
+      Double_t value = leaf->GetValue(i);
+      if (TMath::IsNaN(value)) {
+         // A NaN compares false to everything: give up on this basket.
+         min = -TMath::Infinity();
+         max = TMath::Infinity();
+      }
+      if (value < min) min = value;
+      if (value > max) max = value;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///set the first entry number (case of TBranchSTL)
 
@@ -13,13 +13,23 @@
 #define ROOT_TBranchIMTHelper
 
 #include "Rtypes.h"
+#include "TBasket.h"
 
 #ifdef R__USE_IMT
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 /// A helper class for managing IMT work during TTree:Fill operations.
 ///
+/// In asynchronous mode (see TTree::SetAsyncBasketWrite), the helper outlives
+/// TTree::Fill: full baskets are compressed and written by tasks while the
+/// branches keep filling new baskets, and the written baskets are handed back
+/// to the filling thread through CollectWritten().
 namespace ROOT {
 namespace Internal {
 
@@ -30,6 +40,18 @@ using TaskGroup_t = ROOT::Experimental::TTaskGroup;
 #endif
 
 public:
+   /// A basket written by a task, with its slot in the branch and the number of bytes written.
+   struct TWrittenBasket {
+      TBasket *fBasket;
+      Int_t    fWhere;
+      Int_t    fNbytes;
+   };
+
+   TBranchIMTHelper() = default;
+   explicit TBranchIMTHelper(Bool_t async) : fAsync(async) {}
+
+   Bool_t IsAsync() const { return fAsync; }
+
    template<typename FN> void Run(const FN &lambda) {
 #ifdef R__USE_IMT
       if (!fGroup) { fGroup.reset(new TaskGroup_t()); }
@@ -52,10 +74,45 @@ public:
 #endif
    }
 
+   /// Compress and write the basket in slot `where` of its branch in a task.
+   /// Must be called from the filling thread.
+   void WriteAsync(TBasket *basket, Int_t where) {
+      ++fNinFlight;
+      auto write = [=]() {
+         Int_t nout = basket->WriteBuffer();
+         std::lock_guard<std::mutex> lock(fWrittenMutex);
+         fWritten.push_back({basket, where, nout});
+         return nout;
+      };
+#ifdef R__USE_IMT
+      Run(write);
+#else
+      write();
+#endif
+   }
+
+   /// Return the baskets written since the last call. Must be called from the filling thread.
+   std::vector<TWrittenBasket> CollectWritten() {
+      std::vector<TWrittenBasket> written;
+      {
+         std::lock_guard<std::mutex> lock(fWrittenMutex);
+         written.swap(fWritten);
+      }
+      fNinFlight -= written.size();
+      return written;
+   }
+
+   /// Number of baskets handed to WriteAsync and not yet returned by CollectWritten.
+   Int_t GetNinFlight() const { return fNinFlight; }
+
    Long64_t GetNbytes() { return fBytes; }
    Long64_t GetNerrors() {  return fNerrors; }
 
 private:
+   Bool_t fAsync{kFALSE};             // True if the helper is used across TTree::Fill calls.
+   Int_t  fNinFlight{0};              // Baskets given to WriteAsync and not yet collected.
+   std::mutex fWrittenMutex;          // Protects fWritten.
+   std::vector<TWrittenBasket> fWritten; // Baskets written, waiting to be collected.
    std::atomic<Long64_t> fBytes{0};   // Total number of bytes written by this helper.
    std::atomic<Int_t>    fNerrors{0}; // Total error count of all tasks done by this helper.
 #ifdef R__USE_IMT
@@ -22,6 +22,7 @@ See TBranch structure in TTree.
 #include "TVirtualPad.h"
 #include "TBrowser.h"
 #include "TClass.h"
+#include "ROOT/RByteSwapArray.hxx"
 
 #include <ctype.h>
 
@@ -323,6 +324,38 @@ Int_t TLeaf::GetLen() const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Helper routine for TLeafX::ReadBasketFast.
+///
+/// The buffer contains n consecutive entries of this leaf, in the big-endian
+/// on-file representation, starting at its current position. They are
+/// converted in place to the in-memory representation; the buffer position is
+/// not moved. Returns kFALSE if the leaf does not have a fixed size per entry.
+
+Bool_t TLeaf::ReadBasketFastImpl(TBuffer &b, Long64_t n)
+{
+   if (fLeafCount || fLen <= 0 || n < 0) {
+      return kFALSE;
+   }
+   ByteSwapInPlace(b.Buffer() + b.Length(), n * fLen, fLenType);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n big-endian values of size bytes each, stored contiguously at data,
+/// to the host byte order. This is a no-op on big-endian platforms and for
+/// single byte types.
+
+void TLeaf::ByteSwapInPlace(char *data, Long64_t n, Int_t size)
+{
+   switch (size) {
+   case 2: ROOT::Internal::ByteSwapCopy16(data, data, n); break;
+   case 4: ROOT::Internal::ByteSwapCopy32(data, data, n); break;
+   case 8: ROOT::Internal::ByteSwapCopy64(data, data, n); break;
+   default: break;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Helper routine for TLeafX::SetAddress.
 ///
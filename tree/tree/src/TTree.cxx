@@ -870,6 +870,11 @@ TTree::TTree(const char* name, const char* title, Int_t splitlevel /* = 99 */,
 
 TTree::~TTree()
 {
+   if (fAsyncWriteHelper) {
+      WaitAsyncBasketWrite();
+      delete fAsyncWriteHelper;
+      fAsyncWriteHelper = nullptr;
+   }
    if (fDirectory) {
       // We are in a directory, which may possibly be a file.
       if (fDirectory->GetList()) {
@@ -3735,6 +3740,10 @@ Long64_t TTree::Draw(const char* varexp, const TCut& selection, Option_t* option
 ///    - if expression has more than four fields the option "PARA"or "CANDLE"
 ///      can be used.
 ///    - If option contains the string "goff", no graphics is generated.
+///    - If option contains the word "mt" and implicit multi-threading is
+///      enabled, a histogram or profile with fixed binning is filled by
+///      processing the entry clusters in parallel (see TSelectorDraw::ProcessMT).
+///      The buffers returned by GetV1..GetV4 and GetW are not filled in that case.
 ///
 /// \param [in] nentries is the number of entries to process (default is all)
 ///
@@ -4377,8 +4386,19 @@ Int_t TTree::Fill()
 
 #ifdef R__USE_IMT
    const auto useIMT = ROOT::IsImplicitMTEnabled() && fIMTEnabled;
+   const auto useAsync = useIMT && fAsyncBasketWrite && !TestBit(kCircular);
    ROOT::Internal::TBranchIMTHelper imtHelper;
-   if (useIMT) {
+   if (useAsync) {
+      if (!fAsyncWriteHelper) fAsyncWriteHelper = new ROOT::Internal::TBranchIMTHelper(kTRUE);
+      // Release the baskets written since the previous entry; if the writing
+      // tasks fall too far behind, wait for them so that the number of baskets
+      // held in memory stays bounded.
+      if (fAsyncWriteHelper->GetNinFlight() > 2 * std::max(1, fLeaves.GetEntriesFast())) {
+         WaitAsyncBasketWrite();
+      } else {
+         CollectAsyncBasketWrites();
+      }
+   } else if (useIMT) {
       fIMTFlush = true;
       fIMTZipBytes.store(0);
       fIMTTotBytes.store(0);
@@ -4395,7 +4415,7 @@ Int_t TTree::Fill()
 #ifndef R__USE_IMT
       nwrite = branch->FillImpl(nullptr);
 #else
-      nwrite = branch->FillImpl(useIMT ? &imtHelper : nullptr);
+      nwrite = branch->FillImpl(useAsync ? fAsyncWriteHelper : (useIMT ? &imtHelper : nullptr));
 #endif
       if (nwrite < 0) {
          if (nerror < 2) {
@@ -4869,6 +4889,7 @@ struct BoolRAIIToggle {
 
 Int_t TTree::FlushBaskets() const
 {
+   WaitAsyncBasketWrite();
    if (!fDirectory) return 0;
    Int_t nbytes = 0;
    Int_t nerror = 0;
@@ -5337,6 +5358,7 @@ Int_t TTree::GetEntry(Long64_t entry, Int_t getall)
    if (kGetEntry & fFriendLockStatus) return 0;
 
    if (entry < 0 || entry >= fEntries) return 0;
+   if (fAsyncWriteHelper) WaitAsyncBasketWrite();
    Int_t i;
    Int_t nbytes = 0;
    fReadEntry = entry;
@@ -6882,6 +6904,7 @@ void TTree::Print(Option_t* option) const
    if (kPrint & fFriendLockStatus) {
       return;
    }
+   WaitAsyncBasketWrite();
    Int_t s = 0;
    Int_t skey = 0;
    if (fDirectory) {
@@ -7593,6 +7616,7 @@ void TTree::RemoveFriend(TTree* oldFriend)
 
 void TTree::Reset(Option_t* option)
 {
+   WaitAsyncBasketWrite();
    fNotify        = 0;
    fEntries       = 0;
    fNClusterRange = 0;
@@ -7746,6 +7770,33 @@ Bool_t TTree::SetAlias(const char* aliasName, const char* aliasFormula)
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the asynchronous writing of baskets in TTree::Fill.
+///
+/// When implicit multi-threading is enabled (see ROOT::EnableImplicitMT) and
+/// this mode is on, a basket that becomes full during TTree::Fill is handed
+/// over to a task which compresses and writes it, and the branch immediately
+/// starts filling a new basket: the compression of the baskets of all the
+/// branches overlaps with the filling of the next entries instead of only
+/// with the other branches of the same entry.
+/// The writes themselves are serialized by the file.
+///
+/// The written baskets are released by the following calls to TTree::Fill.
+/// Their bytes are added to the tree totals at the same time, so the byte
+/// based fAutoFlush and fAutoSave decisions may lag by a few baskets.
+/// FlushBaskets, Write, Reset, Print, GetEntry and the destructor wait for
+/// the baskets in flight. Call WaitAsyncBasketWrite (or FlushBaskets) before
+/// writing other objects to the same file while filling.
+///
+/// Note that the order of the baskets in the file is not deterministic in
+/// this mode. Circular trees always write their baskets synchronously.
+
+void TTree::SetAsyncBasketWrite(Bool_t enable /* = kTRUE */)
+{
+   if (!enable) WaitAsyncBasketWrite();
+   fAsyncBasketWrite = enable;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This function may be called at the start of a program to change
 /// the default value for fAutoFlush.
@@ -9211,6 +9262,30 @@ void TTree::UseCurrentStyle()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Release the baskets written asynchronously since the last call, updating
+/// the position and size of each basket in its branch and the byte counts.
+/// See SetAsyncBasketWrite.
+
+void TTree::CollectAsyncBasketWrites() const
+{
+   if (!fAsyncWriteHelper) return;
+   for (auto &written : fAsyncWriteHelper->CollectWritten()) {
+      written.fBasket->GetBranch()->FinishAsyncWriteBasket(written.fBasket, written.fWhere, written.fNbytes);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for all the baskets being written asynchronously and release them.
+/// See SetAsyncBasketWrite.
+
+void TTree::WaitAsyncBasketWrite() const
+{
+   if (!fAsyncWriteHelper || !fAsyncWriteHelper->GetNinFlight()) return;
+   fAsyncWriteHelper->Wait();
+   CollectAsyncBasketWrites();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write this object to the current directory. For more see TObject::Write
 /// If option & kFlushBasket, call FlushBasket before writing the tree.
@@ -233,6 +233,14 @@ branches that will be used very rarely.
 When reading only a small fraction of all entries such that not all branch
 buffers are read, it might be faster to run without a cache.
 
+## READING CLUSTERS AHEAD
+
+For remote files, the TreeCache can also read the baskets of the next clusters
+in a background thread while the current content of the cache is being used,
+see TTreeCache::SetReadAheadClusters or the TTreeCache.ReadAheadClusters
+rootrc variable. The refill of the cache then takes the baskets from the
+read-ahead buffers instead of waiting for the network.
+
 ## HOW TO VERIFY That the TreeCache has been used and check its performance
 
 Once your analysis loop has terminated, you can access/print the number
@@ -256,10 +264,14 @@ of effective system reads for a given file with a code like
 #include "TLeaf.h"
 #include "TFriendElement.h"
 #include "TFile.h"
+#include "TFilePrefetch.h"
 #include "TMath.h"
 #include "TBranchCacheInfo.h"
 #include "TVirtualPerfStats.h"
+#include <algorithm>
 #include <limits.h>
+#include <utility>
+#include <vector>
 
 Int_t TTreeCache::fgLearnEntries = 100;
 
@@ -282,6 +294,9 @@ TTreeCache::TTreeCache(TTree *tree, Int_t buffersize)
    fEntryNext = fEntryMin + fgLearnEntries;
    Int_t nleaves = tree->GetListOfLeaves()->GetEntries();
    fBranches = new TObjArray(nleaves);
+   Int_t nReadAhead = gEnv->GetValue("TTreeCache.ReadAheadClusters", 0);
+   if (nReadAhead > 0)
+      SetReadAheadClusters(nReadAhead);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1270,6 +1285,7 @@ Bool_t TTreeCache::FillBuffer()
    Long64_t maxReadEntry = minEntry; // If we are stopped before the end of the 2nd pass, this marker will where we need to start next time.
    Int_t nReadPrefRequest = 0;
    auto perfStats = GetTree()->GetPerfStats();
+   const Bool_t isMapped = fFile && fFile->IsMapped();
    do {
       prevNtot = ntotCurrentBuf;
       Long64_t lowestMaxEntry = fEntryMax; // The lowest maximum entry in the TTreeCache for each branch for each pass.
@@ -1301,7 +1317,7 @@ Bool_t TTreeCache::FillBuffer()
        &cursor, &lowestMaxEntry, &maxReadEntry, &minEntry,
        &reachedEnd, &skippedFirst, &oncePerBranch, &nDistinctLoad, &progress,
        &ranges, &memRanges, &reqRanges,
-       &ntotCurrentBuf, &nReadPrefRequest](EPass pass, ENarrow narrow, Long64_t maxCollectEntry) {
+       &ntotCurrentBuf, &nReadPrefRequest, isMapped](EPass pass, ENarrow narrow, Long64_t maxCollectEntry) {
          // The first pass we add one basket per branches around the requested entry
          // then in the second pass we add the other baskets of the cluster.
          // This is to support the case where the cache is too small to hold a full cluster.
@@ -1394,6 +1410,11 @@ Bool_t TTreeCache::FillBuffer()
                           b->GetName(), j, len, fBufferSizeMin);
                   continue;
                }
+               if (isMapped && b->GetCompressionLevel() != 0 && fFile->IsMapped(pos, len)) {
+                  // TBasket decompresses this basket straight from the memory mapping of the
+                  // file: copying it into the cache would only read it twice.
+                  continue;
+               }
 
                if (nReadPrefRequest && entries[j] > (reqRanges.AllIncludedRange().fMax + 1)) {
                   // There is a gap between this basket and the max of the 'lowest' already loaded basket
@@ -1716,9 +1737,90 @@ Bool_t TTreeCache::FillBuffer()
       }
    }
    fIsLearning = kFALSE;
+   if (fReadAhead && !fEnablePrefetching)
+      ScheduleReadAhead(tree);
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Submit to the read-ahead engine the baskets of the fReadAheadClusters
+/// clusters following the current content of the cache.
+///
+/// Each cluster is submitted as one block, so that it can be transferred
+/// while the current one is being processed. Clusters already submitted are
+/// not submitted again; the window is restarted when reading moves outside of it.
+
+void TTreeCache::ScheduleReadAhead(TTree *tree)
+{
+   if (fReadAheadClusters <= 0 || fEntryNext < 0 || fEntryNext >= fEntryMax)
+      return;
+
+   if (fEntryNext < fReadAheadFirst || fEntryNext > fReadAheadEntry) {
+      fReadAheadFirst = fEntryNext;
+      fReadAheadEntry = fEntryNext;
+   }
+
+   std::vector<std::pair<Long64_t, Int_t>> baskets;
+   std::vector<Long64_t> pos;
+   std::vector<Int_t> len;
+
+   TTree::TClusterIterator clusterIter = tree->GetClusterIterator(fEntryNext);
+   for (Int_t c = 0; c < fReadAheadClusters; ++c) {
+      Long64_t clusterStart = clusterIter();
+      Long64_t clusterEnd = clusterIter.GetNextEntry();
+      if (clusterStart >= fEntryMax || clusterEnd <= clusterStart)
+         break;
+      if (clusterEnd <= fReadAheadEntry)
+         continue; // already submitted
+
+      baskets.clear();
+      for (Int_t i = 0; i < fNbranches; ++i) {
+         TBranch *b = (TBranch*)fBranches->UncheckedAt(i);
+         if (b->GetDirectory() == 0 || b->GetDirectory()->GetFile() != fFile)
+            continue;
+         Int_t nb = b->GetMaxBaskets();
+         Int_t *lbaskets = b->GetBasketBytes();
+         Long64_t *entries = b->GetBasketEntry();
+         if (!lbaskets || !entries || nb <= 0)
+            continue;
+         Int_t blistsize = b->GetListOfBaskets()->GetSize();
+         Int_t j = TMath::BinarySearch(nb, entries, clusterStart);
+         if (j < 0 || entries[j] < clusterStart)
+            ++j;
+         for (; j < nb && entries[j] < clusterEnd; ++j) {
+            // Already in memory, no need to read it.
+            if (j < blistsize && b->GetListOfBaskets()->UncheckedAt(j))
+               continue;
+            Long64_t bpos = b->GetBasketSeek(j);
+            if (bpos <= 0 || lbaskets[j] <= 0 || lbaskets[j] > fBufferSizeMin)
+               continue;
+            baskets.emplace_back(bpos, lbaskets[j]);
+         }
+      }
+      fReadAheadEntry = clusterEnd;
+      if (baskets.empty())
+         continue;
+
+      // The read-ahead engine looks up pieces by binary search on the position.
+      std::sort(baskets.begin(), baskets.end());
+      baskets.erase(std::unique(baskets.begin(), baskets.end(),
+                                [](const std::pair<Long64_t, Int_t> &a, const std::pair<Long64_t, Int_t> &b) {
+                                   return a.first == b.first;
+                                }),
+                    baskets.end());
+      pos.clear();
+      len.clear();
+      for (auto &basket : baskets) {
+         pos.push_back(basket.first);
+         len.push_back(basket.second);
+      }
+      fReadAhead->ReadBlock(pos.data(), len.data(), pos.size());
+      if (gDebug > 5)
+         Info("ScheduleReadAhead", "Submitted %d baskets for the cluster [%lld, %lld[", (Int_t)pos.size(),
+              clusterStart, clusterEnd);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the desired prefill type from the environment or resource variable
 /// - 0 - No prefill
@@ -1965,6 +2067,8 @@ Int_t TTreeCache::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 void TTreeCache::ResetCache()
 {
    TFileCacheRead::Prefetch(0,0);
+   fReadAheadFirst = -1;
+   fReadAheadEntry = -1;
 
    if (fEnablePrefetching) {
       fFirstTime = kTRUE;
@@ -2023,6 +2127,8 @@ void TTreeCache::SetEntryRange(Long64_t emin, Long64_t emax)
    fEntryMin  = emin;
    fEntryMax  = emax;
    fEntryNext  = fEntryMin + fgLearnEntries * (fIsLearning && !fIsManual);
+   fReadAheadFirst = -1;
+   fReadAheadEntry = -1;
    if (gDebug > 0)
       Info("SetEntryRange", "fEntryMin=%lld, fEntryMax=%lld, fEntryNext=%lld",
                              fEntryMin, fEntryMax, fEntryNext);
@@ -2047,6 +2153,32 @@ void TTreeCache::SetFile(TFile *file, TFile::ECacheAction action)
       prevFile->SetCacheRead(0, fTree, action);
    }
    TFileCacheRead::SetFile(file, action);
+   if (action == TFile::kDisconnect) {
+      fReadAheadFirst = -1;
+      fReadAheadEntry = -1;
+      // The new file might be local, or remote when the previous one was not.
+      if (fReadAheadClusters > 0)
+         SetReadAhead(fReadAheadClusters);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of clusters to read in advance in a background thread.
+///
+/// After each refill of the cache, the baskets of the branches in the cache
+/// belonging to the next 'n' clusters are submitted to the read-ahead engine
+/// (see TFileCacheRead::SetReadAhead), which transfers them while the current
+/// cluster is processed. The next refill then mostly copies from memory.
+/// This only applies to remote files and costs up to n+1 clusters worth of
+/// memory. If n is 0, read-ahead is disabled.
+/// The default can be set with the rootrc variable TTreeCache.ReadAheadClusters.
+
+void TTreeCache::SetReadAheadClusters(Int_t n)
+{
+   fReadAheadClusters = n > 0 ? n : 0;
+   fReadAheadFirst = -1;
+   fReadAheadEntry = -1;
+   SetReadAhead(fReadAheadClusters);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
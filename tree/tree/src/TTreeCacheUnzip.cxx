@@ -35,6 +35,19 @@ The application reading data is carefully synchronized, in order to:
 This is supposed to cancel a part of the unzipping latency, at the
 expenses of cpu time.
 
+As soon as the baskets of a cluster have been transferred into the
+cache, they are handed to the implicit multi-threading task pool in
+groups of at least fUnzipGroupSize compressed bytes. The groups follow
+the order in which the baskets will be read (by first entry, across
+all branches) rather than their order in the file, so that the
+application finds the baskets it needs first already unzipped.
+
+The memory held by unzipped baskets that have not been picked up yet
+is bounded by the unzip buffer size: when it is reached, the tasks
+stop and are resumed by the reading thread once it has consumed half
+of the pending baskets. This keeps a bounded window of unzipped
+buffers in front of the reader.
+
 The default parameters are the same of the prev version, i.e. 20%
 of the TTreeCache cache size. To change it use
 TTreeCache::SetUnzipBufferSize(Long64_t bufferSize)
@@ -53,9 +66,11 @@ where bufferSize must be passed in bytes.
 #include "TVirtualMutex.h"
 
 #ifdef R__USE_IMT
-#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TTaskGroup.hxx"
 #endif
 
+#include <algorithm>
+
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
 extern "C" int R__unzip_header(Int_t *nin, UChar_t *bufin, Int_t *lout);
 
@@ -149,10 +164,14 @@ void TTreeCacheUnzip::UnzipState::SetFinished(Int_t index) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Mark the basket as finished without unzipped block, the main thread unzips it.
+/// Returns the length of the unzipped block which is freed, if any.
 
-void TTreeCacheUnzip::UnzipState::SetMissed(Int_t index) {
+Int_t TTreeCacheUnzip::UnzipState::SetMissed(Int_t index) {
+   Int_t len = fUnzipChunks[index] ? fUnzipLen[index] : 0;
    fUnzipChunks[index].reset();
    fUnzipStatus[index].store((Byte_t)kFinished);
+   return len;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -173,6 +192,24 @@ Bool_t TTreeCacheUnzip::UnzipState::TryUnzipping(Int_t index) {
    return fUnzipStatus[index].compare_exchange_weak(oldValue, newValue, std::memory_order_release, std::memory_order_relaxed);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Drop a basket which will not be read. An untouched basket is marked as
+/// finished, so that no task unzips it, and the unzipped block of a finished
+/// one is freed. Returns the length of the freed block, or -1 if the basket
+/// is being unzipped.
+
+Int_t TTreeCacheUnzip::UnzipState::Discard(Int_t index) {
+   Byte_t oldValue = kUntouched;
+   if (fUnzipStatus[index].compare_exchange_strong(oldValue, (Byte_t)kFinished))
+      return 0;
+   if (oldValue == kProgress)
+      return -1;
+   Int_t len = fUnzipChunks[index] ? fUnzipLen[index] : 0;
+   fUnzipLen[index] = 0;
+   fUnzipChunks[index].reset();
+   return len;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
@@ -182,10 +219,15 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipPendingBytes(0),
+   fUnzipThrottled(kFALSE),
+   fUnzipScheduled(kFALSE),
+   fDiscardNext(0),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNThrottled(0)
 {
    // Default Constructor.
    Init();
@@ -201,10 +243,15 @@ TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tre
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipPendingBytes(0),
+   fUnzipThrottled(kFALSE),
+   fUnzipScheduled(kFALSE),
+   fDiscardNext(0),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNThrottled(0)
 {
    Init();
 }
@@ -327,6 +374,8 @@ Bool_t TTreeCacheUnzip::FillBuffer()
 
    //clear cache buffer
    TFileCacheRead::Prefetch(0,0);
+   fSeekEntry.clear();
+   fSeekEntryEnd.clear();
 
    //store baskets
    for (Int_t i = 0; i < fNbranches; i++) {
@@ -358,6 +407,8 @@ Bool_t TTreeCacheUnzip::FillBuffer()
          fNReadPref++;
 
          TFileCacheRead::Prefetch(pos, len);
+         fSeekEntry.push_back(entries[j]);
+         fSeekEntryEnd.push_back((j < nb - 1 && entries[j+1] > entries[j]) ? entries[j+1] : b->GetEntries());
       }
       if (gDebug > 0) printf("Entry: %lld, registering baskets branch %s, fEntryNext=%lld, fNseek=%d, fNtot=%d\n", entry, ((TBranch*)fBranches->UncheckedAt(i))->GetName(), fEntryNext, fNseek, fNtot);
    }
@@ -523,6 +574,9 @@ void TTreeCacheUnzip::ResetCache()
    // Reset all the lists and wipe all the chunks
    fCycle++;
    fUnzipState.Clear(fNseekMax);
+   fUnzipPendingBytes = 0;
+   fUnzipThrottled = kFALSE;
+   fUnzipScheduled = kFALSE;
 
    if(fNseekMax < fNseek){
       if (gDebug > 0)
@@ -532,6 +586,17 @@ void TTreeCacheUnzip::ResetCache()
       fNseekMax = fNseek;
    }
    fEmpty = kTRUE;
+
+   // Order in which the reader moves past the baskets, see DiscardUnzipped
+   fDiscardOrder.clear();
+   fDiscardLater.clear();
+   fDiscardNext = 0;
+   if ((Int_t)fSeekEntryEnd.size() == fNseek) {
+      for (Int_t i = 0; i < fNseek; i++)
+         fDiscardOrder.push_back(i);
+      std::stable_sort(fDiscardOrder.begin(), fDiscardOrder.end(),
+                       [this](Int_t i, Int_t j) { return fSeekEntryEnd[i] < fSeekEntryEnd[j]; });
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -612,6 +677,7 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
          if (locbuff) delete [] locbuff;
          return 1;
       }
+      fUnzipPendingBytes += loclen;
       fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
       fNUnzip++;
    } else {
@@ -624,55 +690,127 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
 
 #ifdef R__USE_IMT
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping 
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// We create a TTaskGroup and asynchronously map each group of baskets (> 100 kB in total)
+/// to a task. The purpose of creating TTaskGroup is to avoid competing with main thread.
+///
+/// Only the baskets which are still untouched are scheduled, in the order in which
+/// they will be read, so this can also be called to resume unzipping after the
+/// tasks were paused by a full unzip buffer. Tasks are added to the running
+/// TTaskGroup if there is one.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
+   if (!ROOT::IsImplicitMTEnabled() || !fIsTransferred || fIsLearning)
+      return 0;
+   fUnzipScheduled = kTRUE;
+
+   auto unzipFunction = [this](const std::vector<Int_t> &indices) {
+      for (auto ii : indices) {
          // If cache is invalidated and we should return immediately.
-         if (!fIsTransferred) return nullptr;
+         if (!fIsTransferred) return;
 
-         for (auto ii : indices) {
-            if(fUnzipState.TryUnzipping(ii)) {
-               Int_t res = UnzipCache(ii);
-               if(res)
-                  if (gDebug > 0)
-                     Info("UnzipCache", "Unzipping failed or cache is in learning state");
-            }
+         // Do not run further ahead of the reader than the unzip buffer allows; the
+         // remaining baskets stay untouched and are rescheduled by ReleaseUnzipped.
+         if (fUnzipBufferSize > 0 && fUnzipPendingBytes.load() >= fUnzipBufferSize) {
+            fUnzipThrottled = kTRUE;
+            return;
          }
-         return nullptr;
-      };
-
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
-      std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
+
+         if(fUnzipState.TryUnzipping(ii)) {
+            Int_t res = UnzipCache(ii);
+            if(res)
+               if (gDebug > 0)
+                  Info("UnzipCache", "Unzipping failed or cache is in learning state");
          }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
       }
-      ROOT::TThreadExecutor pool;
-      pool.Foreach(unzipFunction, basketIndices);
    };
 
-   fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
-   fUnzipTaskGroup->Run(mapFunction);
+   // Unzip in reading order: the baskets of all branches holding the first entries come first.
+   std::vector<Int_t> order(fNseek);
+   for (Int_t i = 0; i < fNseek; i++)
+      order[i] = i;
+   if ((Int_t)fSeekEntry.size() == fNseek) {
+      std::stable_sort(order.begin(), order.end(),
+                       [this](Int_t i, Int_t j) { return fSeekEntry[i] < fSeekEntry[j]; });
+   }
+
+   if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
+   std::vector<std::vector<Int_t>> basketIndices;
+   std::vector<Int_t> indices;
+   Int_t accusz = 0;
+   for (auto i : order) {
+      if (!fUnzipState.IsUntouched(i)) continue;
+      accusz += fSeekLen[i];
+      indices.push_back(i);
+      if (accusz >= fUnzipGroupSize) {
+         basketIndices.push_back(std::move(indices));
+         indices.clear();
+         accusz = 0;
+      }
+   }
+   if (!indices.empty())
+      basketIndices.push_back(std::move(indices));
+   if (basketIndices.empty())
+      return 0;
+
+   if (!fUnzipTaskGroup)
+      fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
+   for (auto &group : basketIndices) {
+      fUnzipTaskGroup->Run([unzipFunction, group]() { unzipFunction(group); });
+   }
 
    return 0;
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Account for an unzipped block handed over to a basket. If the unzipping
+/// tasks were paused because the unzip buffer was full and at least half of it
+/// is free again, schedule the remaining baskets.
+
+void TTreeCacheUnzip::ReleaseUnzipped(Long64_t len)
+{
+   fUnzipPendingBytes -= len;
+#ifdef R__USE_IMT
+   if (fUnzipThrottled && fUnzipPendingBytes.load() <= fUnzipBufferSize / 2) {
+      fUnzipThrottled = kFALSE;
+      fNThrottled++;
+      CreateTasks();
+   }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The reader has moved on to a basket starting at the given entry: the baskets
+/// ending before it will not be read. Free their unzipped blocks, which would
+/// otherwise fill the unzip buffer until the cache is reset, and do not let the
+/// tasks unzip them. A basket which is still needed after all is unzipped by the
+/// main thread.
+
+void TTreeCacheUnzip::DiscardUnzipped(Long64_t entry)
+{
+   Long64_t freed = 0;
+   for (auto it = fDiscardLater.begin(); it != fDiscardLater.end();) {
+      Int_t len = fUnzipState.Discard(*it);
+      if (len < 0) {
+         ++it;
+      } else {
+         freed += len;
+         it = fDiscardLater.erase(it);
+      }
+   }
+   while (fDiscardNext < (Int_t)fDiscardOrder.size() && fSeekEntryEnd[fDiscardOrder[fDiscardNext]] <= entry) {
+      Int_t index = fDiscardOrder[fDiscardNext++];
+      Int_t len = fUnzipState.Discard(index);
+      if (len < 0)
+         fDiscardLater.push_back(index);
+      else
+         freed += len;
+   }
+   if (freed > 0)
+      ReleaseUnzipped(freed);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// We try to read a buffer that has already been unzipped
 /// Returns -1 in case of read failure, 0 in case it's not in the
@@ -716,6 +854,10 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
          // In order to get its info
          Int_t seekidx = fSeekIndex[loc];
 
+         // The baskets that end before this one starts were skipped by the reader
+         if ((Int_t)fSeekEntryEnd.size() == fNseek && fNseekMax >= fNseek)
+            DiscardUnzipped(fSeekEntry[seekidx]);
+
          do {
 
             // If the block is ready we get it immediately.
@@ -733,6 +875,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                }
 
                fNFound++;
+               ReleaseUnzipped(fUnzipState.fUnzipLen[seekidx]);
                return fUnzipState.fUnzipLen[seekidx];
             }
 
@@ -782,11 +925,12 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
             }
 
             fNStalls++;
+            ReleaseUnzipped(fUnzipState.fUnzipLen[seekidx]);
             return fUnzipState.fUnzipLen[seekidx];
-         } else {
+         } else if (seekidx >= 0) {
             // This is a complete miss. We want to avoid the background tasks
             // to try unzipping this block in the future.
-            fUnzipState.SetMissed(seekidx);
+            ReleaseUnzipped(fUnzipState.SetMissed(seekidx));
          }
       } else {
          loc = -1;
@@ -814,17 +958,25 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
          fUnzipTaskGroup->Cancel();
          fUnzipTaskGroup.reset();
       }
+      fUnzipScheduled = kFALSE;
 #endif
       {
          // Fill new baskets into cache.
          R__LOCKGUARD(fIOMutex);
-	 fFile->Seek(pos);
-	 res = fFile->ReadBuffer(fCompBuffer, len);
+         fFile->Seek(pos);
+         res = fFile->ReadBuffer(fCompBuffer, len);
       } // end of lock scope
+   }
 #ifdef R__USE_IMT
+   if (fParallel && !fIsLearning && !fUnzipScheduled) {
+      // The cache content has just been transferred: start unzipping it in the background
+      // right away, leaving out the basket which is unzipped below by the reader itself.
+      loc = (Int_t)TMath::BinarySearch(fNseek, fSeekSort, pos);
+      if (fNseekMax >= fNseek && loc >= 0 && loc < fNseek && pos == fSeekSort[loc])
+         fUnzipPendingBytes -= fUnzipState.SetMissed(fSeekIndex[loc]);
       CreateTasks();
-#endif
    }
+#endif
 
    if (res) res = -1;
 
@@ -968,6 +1120,7 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
    printf("Number of misses: %d\n", fNMissed);
+   printf("Number of unzip pauses (full buffer): %d\n", fNThrottled);
 
    TTreeCache::Print(option);
 }
@@ -35,7 +35,14 @@ Class implementing or helping  the various TTree cloning method
 #include "TLeafC.h"
 #include "TFileCacheRead.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -99,6 +106,13 @@ Bool_t TTreeCloner::CompareEntry::operator()(UInt_t i1, UInt_t i2)
 /// This means that on the file the baskets will be in the order
 /// in which they will be needed when reading the whole tree
 /// sequentially.
+///
+/// If 'method' also contains "recompress", the baskets of the branches
+/// whose compression settings differ from the ones of the corresponding
+/// output branch are uncompressed and compressed again with the output
+/// settings, without being unstreamed (see WriteRecompressedBaskets).
+/// Otherwise the baskets are always copied as they are, keeping the
+/// compression of the input.
 
 TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t options) :
    fWarningMsg(),
@@ -119,6 +133,7 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t option
    fPidOffset(0),
    fCloneMethod(TTreeCloner::kDefault),
    fToStartEntries(0),
+   fRecompress(kFALSE),
    fCacheSize(0LL),
    fFileCache(nullptr),
    fPrevCache(nullptr)
@@ -135,6 +150,7 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t option
       //::Info("TTreeCloner::TTreeCloner","use: kSortBasketsByOffset");
       fCloneMethod = TTreeCloner::kSortBasketsByOffset;
    }
+   fRecompress = opt.Contains("recompress");
    if (fToTree) fToStartEntries = fToTree->GetEntries();
 
    if (fFromTree == nullptr) {
@@ -685,6 +701,10 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
 
 void TTreeCloner::WriteBaskets()
 {
+   if (fRecompress) {
+      WriteRecompressedBaskets();
+      return;
+   }
    TBasket *basket = new TBasket();
    for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
@@ -721,3 +741,106 @@ void TTreeCloner::WriteBaskets()
    }
    delete basket;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transfer the basket from the input file to the output file, recompressing
+/// the ones whose branch compression settings differ between the input and
+/// the output (see TBasket::RecompressBuffer). The content of the baskets is
+/// not unstreamed.
+///
+/// The baskets are read in batches. When implicit multi-threading is enabled
+/// the baskets of a batch are recompressed in parallel; they are then written
+/// in the same order as by WriteBaskets.
+
+void TTreeCloner::WriteRecompressedBaskets()
+{
+   UInt_t batchSize = 16;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled()) {
+      batchSize = std::max(batchSize, 4 * ROOT::GetImplicitMTPoolSize());
+   }
+#endif
+
+   std::vector<std::unique_ptr<TBasket>> baskets;
+   std::vector<UInt_t> slots;     // Index in fBasketIndex of each basket of the batch.
+   std::vector<UInt_t> toRecompress;
+   std::vector<Int_t> status;
+
+   auto writeBatch = [&]() {
+      status.assign(baskets.size(), 0);
+      auto recompress = [&](UInt_t k) {
+         TBranch *to = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[slots[k]] ] );
+         status[k] = baskets[k]->RecompressBuffer(to->GetCompressionSettings());
+      };
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled() && toRecompress.size() > 1) {
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(recompress, toRecompress);
+      } else
+#endif
+      {
+         for (auto k : toRecompress) {
+            recompress(k);
+         }
+      }
+
+      for (UInt_t k = 0; k < baskets.size(); ++k) {
+         TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[slots[k]] ] );
+         TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[slots[k]] ] );
+         Int_t index = fBasketNum[ fBasketIndex[slots[k]] ];
+         if (status[k]) {
+            Warning("TTreeCloner::WriteRecompressedBaskets", "Could not recompress basket %d of branch %s, it is copied as is.",
+                    index, from->GetName());
+         }
+         TBasket *basket = baskets[k].get();
+         basket->IncrementPidOffset(fPidOffset);
+         basket->CopyTo(to->GetFile(0));
+         to->AddBasket(*basket,kTRUE,fToStartEntries + from->GetBasketEntry()[index]);
+      }
+      baskets.clear();
+      slots.clear();
+      toRecompress.clear();
+   };
+
+   for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+      TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+
+      TFile *fromfile = from->GetFile(0);
+
+      Int_t index = fBasketNum[ fBasketIndex[j] ];
+
+      Long64_t pos = from->GetBasketSeek(index);
+      if (pos!=0) {
+         if (fFileCache && j >= notCached) {
+            notCached = FillCache(notCached);
+         }
+         std::unique_ptr<TBasket> basket(new TBasket());
+         if (from->GetBasketBytes()[index] == 0) {
+            from->GetBasketBytes()[index] = basket->ReadBasketBytes(pos, fromfile);
+         }
+         Int_t len = from->GetBasketBytes()[index];
+
+         basket->LoadBasketBuffers(pos,len,fromfile,fFromTree);
+         if (from->GetCompressionSettings() != to->GetCompressionSettings()) {
+            toRecompress.push_back(baskets.size());
+         }
+         baskets.push_back(std::move(basket));
+         slots.push_back(j);
+         if (baskets.size() >= batchSize) {
+            writeBatch();
+         }
+      } else {
+         // Keep the order of the baskets.
+         writeBatch();
+         TBasket *frombasket = from->GetBasket( index );
+         if (frombasket && frombasket->GetNevBuf()>0) {
+            TBasket *tobasket = (TBasket*)frombasket->Clone();
+            tobasket->SetBranch(to);
+            to->AddBasket(*tobasket, kFALSE, fToStartEntries+from->GetBasketEntry()[index]);
+            to->FlushOneBasket(to->GetWriteBasket());
+         }
+      }
+   }
+   writeBatch();
+}
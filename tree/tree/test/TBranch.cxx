@@ -1,10 +1,16 @@
+#include "ROOT/TIOFeatures.hxx"
 #include "TFile.h"
+#include "TMath.h"
+#include "TMemFile.h"
 #include "TTree.h"
 #include "TBranch.h"
+#include "TBufferFile.h"
 #include "TRandom.h"
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 class TBranchTest : public ::testing::Test {
 protected:
    virtual void SetUp()
@@ -153,3 +159,82 @@ TEST_F(TBranchTest, twoPreviousTest)
    ASSERT_TRUE(branch->GetListOfBaskets()->At(7));
    delete file;
 }
+
+TEST_F(TBranchTest, bulkEntriesTest)
+{
+   TFile *file = new TFile("TBranchTestTree.root");
+   TTree *tree = (TTree *)file->Get("tree");
+   TBranch *branch = tree->GetBranch("branch");
+   Float_t data = 0;
+   branch->SetAddress(&data);
+
+   // Read all entries basket by basket and compare with the
+   // values obtained entry by entry.
+   std::vector<Float_t> values;
+   TBufferFile buf(TBuffer::kRead, 10000);
+   Long64_t entry = 0;
+   while (entry < tree->GetEntries()) {
+      Int_t n = branch->GetBulkEntries(entry, buf);
+      ASSERT_GT(n, 0);
+      const Float_t *bulk = reinterpret_cast<const Float_t *>(buf.Buffer());
+      values.insert(values.end(), bulk, bulk + n);
+      entry += n;
+   }
+   ASSERT_EQ(tree->GetEntries(), (Long64_t)values.size());
+   for (Long64_t i = 0; i < tree->GetEntries(); ++i) {
+      branch->GetEntry(i);
+      EXPECT_EQ(data, values[i]);
+   }
+
+   // The serialized variant points into the basket and leaves the data big-endian.
+   TBufferFile serialized(TBuffer::kRead, 10000);
+   Int_t n = branch->GetEntriesSerialized(12, serialized);
+   ASSERT_GT(n, 0);
+   EXPECT_FALSE(serialized.TestBit(TBuffer::kIsOwner));
+   for (Int_t i = 0; i < n; ++i) {
+      Float_t value;
+      serialized >> value;
+      EXPECT_EQ(values[12 + i], value);
+   }
+   delete file;
+}
+
+TEST(TBranch, ZoneMap)
+{
+   TMemFile file("TBranchZoneMap.root", "RECREATE");
+   TTree tree("tree", "A test tree");
+   ROOT::TIOFeatures features;
+   features.Set(ROOT::Experimental::EIOFeatures::kGenerateZoneMap);
+   tree.SetIOFeatures(features);
+   tree.SetAutoFlush(10);
+   Int_t idx = 0;
+   Double_t value = 0;
+   tree.Branch("idx", &idx);
+   tree.Branch("value", &value);
+   for (idx = 0; idx < 100; idx++) {
+      value = idx % 10 == 3 ? TMath::QuietNaN() : 0.5 * idx;
+      tree.Fill();
+   }
+   tree.FlushBaskets();
+
+   Double_t min = 0, max = 0;
+   TBranch *branch = tree.GetBranch("idx");
+   ASSERT_TRUE(branch->GetValueRange(20, 29, min, max));
+   EXPECT_LE(min, 20);
+   EXPECT_GE(max, 29);
+   ASSERT_TRUE(branch->GetValueRange(0, 99, min, max));
+   EXPECT_EQ(min, 0);
+   EXPECT_EQ(max, 99);
+   EXPECT_FALSE(branch->GetValueRange(0, 100, min, max));
+
+   // A basket holding a NaN has an unknown range.
+   ASSERT_TRUE(tree.GetBranch("value")->GetValueRange(0, 99, min, max));
+   EXPECT_EQ(min, -TMath::Infinity());
+   EXPECT_EQ(max, TMath::Infinity());
+
+   // No zone map without the feature.
+   TTree plain("plain", "A test tree");
+   plain.Branch("idx", &idx);
+   for (idx = 0; idx < 10; idx++) plain.Fill();
+   EXPECT_FALSE(plain.GetBranch("idx")->GetValueRange(0, 9, min, max));
+}
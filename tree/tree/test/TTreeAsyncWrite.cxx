@@ -0,0 +1,60 @@
+#include "TFile.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#ifdef R__USE_IMT
+
+// Fill a tree whose baskets are written asynchronously and check that all the
+// entries read back, including the ones in baskets still in flight when the
+// tree is written.
+TEST(TTreeAsyncWrite, FillAndRead)
+{
+   ROOT::EnableImplicitMT(4);
+   const Long64_t nentries = 100000;
+   {
+      TFile file("TTreeAsyncWrite.root", "RECREATE");
+      TTree tree("tree", "A test tree");
+      tree.SetAsyncBasketWrite();
+      EXPECT_TRUE(tree.GetAsyncBasketWrite());
+      Int_t i = 0;
+      Double_t x = 0;
+      Float_t y[4] = {0};
+      tree.Branch("i", &i);
+      tree.Branch("x", &x);
+      tree.Branch("y", y, "y[4]/F", 1024);
+      for (Long64_t ev = 0; ev < nentries; ++ev) {
+         i = ev;
+         x = 0.5 * ev;
+         for (Int_t j = 0; j < 4; ++j)
+            y[j] = ev + j;
+         tree.Fill();
+      }
+      tree.Write();
+      EXPECT_EQ(nentries, tree.GetEntries());
+      EXPECT_LT(0, tree.GetZipBytes());
+      EXPECT_LT(1, tree.GetBranch("y")->GetWriteBasket());
+   }
+   ROOT::DisableImplicitMT();
+
+   TFile file("TTreeAsyncWrite.root");
+   TTree *tree = nullptr;
+   file.GetObject("tree", tree);
+   ASSERT_NE(nullptr, tree);
+   ASSERT_EQ(nentries, tree->GetEntries());
+   Int_t i = -1;
+   Double_t x = -1;
+   Float_t y[4];
+   tree->SetBranchAddress("i", &i);
+   tree->SetBranchAddress("x", &x);
+   tree->SetBranchAddress("y", y);
+   for (Long64_t ev = 0; ev < nentries; ++ev) {
+      ASSERT_LT(0, tree->GetEntry(ev));
+      ASSERT_EQ(ev, i);
+      ASSERT_DOUBLE_EQ(0.5 * ev, x);
+      ASSERT_FLOAT_EQ(ev + 3, y[3]);
+   }
+}
+
+#endif
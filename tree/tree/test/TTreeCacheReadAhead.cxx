@@ -0,0 +1,170 @@
+#include "TFile.h"
+#include "TFilePrefetch.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+#include "TUrl.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifndef R__WIN32
+#include <unistd.h>
+
+static const char *gFileName = "ttreecachereadahead_test.root";
+static const Int_t gNEntries = 16000;
+static const Int_t gClusterSize = 1000;
+
+////////////////////////////////////////////////////////////////////////////////
+/// A local file that the caches treat as remote, so that read-ahead is enabled.
+/// TFile reads are not safe from two threads, so ReadBuffers uses positioned reads,
+/// which leave the file offset alone. The reads issued by the thread that
+/// opened the file are counted.
+class TRemoteLikeFile : public TFile {
+   TUrl fRemoteUrl;
+   std::thread::id fOwnerThread = std::this_thread::get_id();
+   std::atomic<Int_t> fOwnerReads{0};
+
+public:
+   TRemoteLikeFile(const char *name) : TFile(name), fRemoteUrl(TString::Format("root://localhost/%s", name)) {}
+
+   const TUrl *GetEndpointUrl() const override { return &fRemoteUrl; }
+
+   Bool_t ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf) override
+   {
+      if (!buf)
+         return TFile::ReadBuffers(buf, pos, len, nbuf);
+      if (std::this_thread::get_id() == fOwnerThread)
+         ++fOwnerReads;
+      Long64_t k = 0;
+      for (Int_t i = 0; i < nbuf; ++i) {
+         if (pread(GetFd(), buf + k, len[i], pos[i] + GetArchiveOffset()) != len[i])
+            return kTRUE;
+         k += len[i];
+      }
+      return kFALSE;
+   }
+
+   Int_t GetOwnerReads() const { return fOwnerReads; }
+};
+
+static void CreateSampleFile()
+{
+   // Uncompressed, so that a cluster takes a known size: about 132 kB.
+   TFile f(gFileName, "RECREATE", "", 0);
+   TTree t("t", "Tree for read-ahead tests.");
+   Int_t i;
+   Double_t v[16];
+   t.Branch("i", &i, "i/I");
+   t.Branch("v", v, "v[16]/D");
+   t.SetAutoFlush(gClusterSize);
+   for (i = 0; i < gNEntries; ++i) {
+      for (Int_t j = 0; j < 16; ++j)
+         v[j] = i + 0.5 * j;
+      t.Fill();
+   }
+   t.Write();
+}
+
+struct ReadResult {
+   Bool_t fIsReadAhead = kFALSE;
+   Int_t fReads = 0;
+   Long64_t fReadAheadHits = 0;
+};
+
+static ReadResult ReadSampleFile(Int_t readAheadClusters)
+{
+   ReadResult result;
+   TRemoteLikeFile f(gFileName);
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   EXPECT_NE(t, nullptr);
+   if (!t)
+      return result;
+
+   // Room for one cluster only: the cache is refilled at every cluster.
+   t->SetCacheSize(200 * 1024);
+   t->AddBranchToCache("*", kTRUE);
+   t->StopCacheLearningPhase();
+   auto cache = dynamic_cast<TTreeCache *>(f.GetCacheRead(t));
+   EXPECT_NE(cache, nullptr);
+   if (!cache)
+      return result;
+   cache->SetReadAheadClusters(readAheadClusters);
+   result.fIsReadAhead = cache->IsReadAhead();
+
+   Int_t i;
+   Double_t v[16];
+   t->SetBranchAddress("i", &i);
+   t->SetBranchAddress("v", v);
+   for (Long64_t entry = 0; entry < t->GetEntries(); ++entry) {
+      t->GetEntry(entry);
+      EXPECT_EQ(entry, i);
+      EXPECT_DOUBLE_EQ(entry + 7.5, v[15]);
+   }
+   result.fReads = f.GetOwnerReads();
+   result.fReadAheadHits = cache->GetReadAheadHits();
+   // Stop the read-ahead thread while the file is still a TRemoteLikeFile.
+   f.Close();
+   return result;
+}
+
+TEST(TTreeCache, ReadAhead)
+{
+   CreateSampleFile();
+
+   const auto noReadAhead = ReadSampleFile(0);
+   EXPECT_FALSE(noReadAhead.fIsReadAhead);
+   EXPECT_EQ(0, noReadAhead.fReadAheadHits);
+   EXPECT_GE(noReadAhead.fReads, gNEntries / gClusterSize);
+
+   for (Int_t nClusters : {1, 3}) {
+      const auto readAhead = ReadSampleFile(nClusters);
+      EXPECT_TRUE(readAhead.fIsReadAhead);
+      EXPECT_GT(readAhead.fReadAheadHits, 0);
+      // The clusters after the first are taken from the read-ahead buffers.
+      EXPECT_LT(readAhead.fReads, noReadAhead.fReads);
+   }
+
+   gSystem->Unlink(gFileName);
+}
+
+TEST(TFilePrefetch, ReadBufferIfRequested)
+{
+   CreateSampleFile();
+   {
+      TRemoteLikeFile f(gFileName);
+      std::vector<char> expected(300);
+      ASSERT_FALSE(f.ReadBuffer(expected.data(), 100, 300));
+
+      TFilePrefetch prefetch(&f);
+      // Only one block is kept: submitting a new block recycles the previous one.
+      prefetch.SetMaxReadBlocks(1);
+      EXPECT_EQ(1, prefetch.GetMaxReadBlocks());
+      ASSERT_EQ(0, prefetch.ThreadStart());
+
+      std::vector<char> buf(100);
+      // Nothing was requested: no waiting, nothing read.
+      EXPECT_FALSE(prefetch.ReadBufferIfRequested(buf.data(), 100, 100));
+
+      Long64_t posA[] = {100, 300};
+      Int_t lenA[] = {100, 100};
+      prefetch.ReadBlock(posA, lenA, 2);
+      ASSERT_TRUE(prefetch.ReadBufferIfRequested(buf.data(), 300, 100));
+      EXPECT_EQ(0, memcmp(buf.data(), &expected[200], 100));
+      EXPECT_FALSE(prefetch.ReadBufferIfRequested(buf.data(), 200, 100));
+
+      Long64_t posB[] = {200};
+      Int_t lenB[] = {100};
+      prefetch.ReadBlock(posB, lenB, 1);
+      ASSERT_TRUE(prefetch.ReadBufferIfRequested(buf.data(), 200, 100));
+      EXPECT_EQ(0, memcmp(buf.data(), &expected[100], 100));
+      EXPECT_FALSE(prefetch.ReadBufferIfRequested(buf.data(), 100, 100));
+   }
+   gSystem->Unlink(gFileName);
+}
+#endif
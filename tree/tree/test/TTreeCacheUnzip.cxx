@@ -0,0 +1,114 @@
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCacheUnzip.h"
+
+#include "gtest/gtest.h"
+
+static const char *gFileName = "ttreecacheunzip_test.root";
+static const Int_t gNEntries = 20000;
+
+static void CreateSampleFile()
+{
+   TFile f(gFileName, "RECREATE");
+   TTree t("t", "Tree for parallel unzipping tests.");
+   Int_t i;
+   Double_t d;
+   Float_t v[8];
+   t.Branch("i", &i, "i/I", 1024);
+   t.Branch("d", &d, "d/D", 2048);
+   t.Branch("v", v, "v[8]/F", 4096);
+   t.SetAutoFlush(2500);
+   for (i = 0; i < gNEntries; ++i) {
+      d = 0.5 * i;
+      for (Int_t j = 0; j < 8; ++j)
+         v[j] = i + j;
+      t.Fill();
+   }
+   t.Write();
+}
+
+static void VerifySampleFile(Long64_t unzipBufferSize)
+{
+   TFile f(gFileName);
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   ASSERT_NE(t, nullptr);
+   t->SetCacheSize(1024 * 1024);
+   auto cache = dynamic_cast<TTreeCacheUnzip *>(f.GetCacheRead(t));
+   ASSERT_NE(cache, nullptr);
+   if (unzipBufferSize > 0)
+      cache->SetUnzipBufferSize(unzipBufferSize);
+
+   Int_t i;
+   Double_t d;
+   Float_t v[8];
+   t->SetBranchAddress("i", &i);
+   t->SetBranchAddress("d", &d);
+   t->SetBranchAddress("v", v);
+   for (Long64_t entry = 0; entry < t->GetEntries(); ++entry) {
+      t->GetEntry(entry);
+      ASSERT_EQ(entry, i);
+      ASSERT_DOUBLE_EQ(0.5 * entry, d);
+      ASSERT_FLOAT_EQ(entry + 7, v[7]);
+   }
+}
+
+// The unzipping cache is only used in builds with implicit multi-threading.
+#ifdef R__USE_IMT
+TEST(TTreeCacheUnzip, ParallelRead)
+{
+   CreateSampleFile();
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   ROOT::EnableImplicitMT(4);
+   VerifySampleFile(0);
+   // An unzip buffer smaller than a cluster forces the tasks to pause and resume.
+   VerifySampleFile(8 * 1024);
+   ROOT::DisableImplicitMT();
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+   gSystem->Unlink(gFileName);
+}
+
+TEST(TTreeCacheUnzip, SkippedBaskets)
+{
+   CreateSampleFile();
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   ROOT::EnableImplicitMT(4);
+   {
+      TFile f(gFileName);
+      TTree *t = nullptr;
+      f.GetObject("t", t);
+      ASSERT_NE(t, nullptr);
+      t->SetCacheSize(1024 * 1024);
+      t->AddBranchToCache("*", kTRUE);
+      t->StopCacheLearningPhase();
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(f.GetCacheRead(t));
+      ASSERT_NE(cache, nullptr);
+      const Long64_t unzipBufferSize = 32 * 1024;
+      cache->SetUnzipBufferSize(unzipBufferSize);
+
+      // All the baskets are unzipped ahead, but d is never read and v only for the first entries of
+      // each cluster: the baskets skipped by the reader must not use up the unzip buffer.
+      Int_t i;
+      Float_t v[8];
+      TBranch *bi = t->GetBranch("i");
+      TBranch *bv = t->GetBranch("v");
+      bi->SetAddress(&i);
+      bv->SetAddress(v);
+      for (Long64_t entry = 0; entry < t->GetEntries(); ++entry) {
+         bi->GetEntry(entry);
+         ASSERT_EQ(entry, i);
+         if (entry % 2500 < 10) {
+            bv->GetEntry(entry);
+            ASSERT_FLOAT_EQ(entry + 7, v[7]);
+         }
+      }
+      // Only the baskets of d and v holding the last entries can still be waiting to be read
+      EXPECT_LT(cache->GetUnzipPendingBytes(), unzipBufferSize);
+   }
+   ROOT::DisableImplicitMT();
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+   gSystem->Unlink(gFileName);
+}
+#endif
@@ -20,11 +20,14 @@
 #include "TError.h"
 #include "TEntryList.h"
 #include "TFriendElement.h"
+#include "TTreeCache.h"
 #include "ROOT/RMakeUnique.hxx"
 #include "ROOT/TThreadedObject.hxx"
 
 #include <string.h>
+#include <algorithm>
 #include <functional>
+#include <utility>
 #include <vector>
 
 
@@ -68,6 +71,13 @@ namespace ROOT {
       using ClustersAndEntries = std::pair<std::vector<std::vector<EntryCluster>>, std::vector<Long64_t>>;
       ClustersAndEntries MakeClusters(const std::string &treename, const std::vector<std::string> &filenames);
 
+      std::vector<EntryCluster> MakeTasks(const std::vector<EntryCluster> &clusters, Long64_t target, bool split);
+
+      std::vector<Long64_t> GetSelectedEntries(TEntryList entryList);
+      std::vector<EntryCluster> MakeSelectedEntriesTasks(const std::vector<EntryCluster> &clusters,
+                                                         const std::vector<Long64_t> &selectedEntries,
+                                                         Long64_t target, bool split);
+
       class TTreeView {
       private:
          using TreeReaderEntryListPair = std::pair<std::unique_ptr<TTreeReader>, std::unique_ptr<TEntryList>>;
@@ -76,6 +86,16 @@ namespace ROOT {
          std::vector<std::unique_ptr<TChain>> fFriends; ///< Friends of the tree/chain
          std::unique_ptr<TChain> fChain;                ///< Chain on which to operate
          std::vector<Long64_t> fLoadedEntries;          ///<! Per-task loaded entries (for task interleaving)
+         std::vector<std::pair<Long64_t, Long64_t>> fCacheEntryRanges; ///<! Per-task TTreeCache entry ranges ({-1, -1} if unrestricted)
+
+         ////////////////////////////////////////////////////////////////////////////////
+         /// Return the TTreeCache of the current tree of fChain, if any.
+         TTreeCache *GetCurrentTreeCache() const
+         {
+            TTree *tree = fChain->GetTree();
+            TFile *file = tree ? tree->GetCurrentFile() : nullptr;
+            return file ? dynamic_cast<TTreeCache *>(file->GetCacheRead(tree)) : nullptr;
+         }
 
          ////////////////////////////////////////////////////////////////////////////////
          /// Construct fChain, also adding friends if needed and injecting knowledge of offsets if available.
@@ -112,18 +132,30 @@ namespace ROOT {
             }
          }
 
-         TreeReaderEntryListPair MakeReaderWithEntryList(TEntryList &globalList, Long64_t start, Long64_t end)
+         TreeReaderEntryListPair
+         MakeReaderWithEntryList(const std::vector<Long64_t> &selectedEntries, Long64_t start, Long64_t end)
          {
             // TEntryList and SetEntriesRange do not work together (the former has precedence).
             // We need to construct a TEntryList that contains only those entry numbers in our desired range.
             auto localList = std::make_unique<TEntryList>();
-            Long64_t entry = globalList.GetEntry(0);
-            do {
-               if (entry >= end)
-                  break;
-               else if (entry >= start)
-                  localList->Enter(entry);
-            } while ((entry = globalList.Next()) >= 0);
+            const auto first = std::lower_bound(selectedEntries.begin(), selectedEntries.end(), start);
+            const auto last = std::lower_bound(first, selectedEntries.end(), end);
+            for (auto entry = first; entry != last; ++entry)
+               localList->Enter(*entry);
+
+            // Restrict the cache of the tree holding the entries to the baskets they need
+            if (first != last) {
+               const Long64_t localFirst = fChain->LoadTree(*first);
+               TTree *tree = fChain->GetTree();
+               const Long64_t localLast = localFirst + (*(last - 1) - *first);
+               TTreeCache *cache = GetCurrentTreeCache();
+               if (cache && localFirst >= 0 && localLast < tree->GetEntries()) {
+                  cache->SetEntryRange(localFirst, localLast + 1);
+                  // remembered to be restored when an interleaved task gives the tree back to this one
+                  if (!fCacheEntryRanges.empty())
+                     fCacheEntryRanges.back() = std::make_pair(localFirst, localLast + 1);
+               }
+            }
 
             auto reader = std::make_unique<TTreeReader>(fChain.get(), localList.get());
             return std::make_pair(std::move(reader), std::move(localList));
@@ -147,17 +179,21 @@ namespace ROOT {
          /// Get a TTreeReader for the current tree of this view.
          TreeReaderEntryListPair GetTreeReader(Long64_t start, Long64_t end, const std::string &treeName,
                                                const std::vector<std::string> &fileNames, const FriendInfo &friendInfo,
-                                               TEntryList entryList, const std::vector<Long64_t> &nEntries,
+                                               const std::vector<Long64_t> &selectedEntries,
+                                               const std::vector<Long64_t> &nEntries,
                                                const std::vector<std::vector<Long64_t>> &friendEntries)
          {
-            const bool usingLocalEntries = friendInfo.fFriendNames.empty() && entryList.GetN() == 0;
-            if (fChain == nullptr || (usingLocalEntries && fileNames[0] != fChain->GetListOfFiles()->At(0)->GetTitle()))
+            const bool usingLocalEntries = friendInfo.fFriendNames.empty() && selectedEntries.empty();
+            // the chain is rebuilt if it does not contain exactly the files that this task needs
+            const auto nChainFiles = fChain ? static_cast<std::size_t>(fChain->GetListOfFiles()->GetEntries()) : 0u;
+            if (fChain == nullptr || (usingLocalEntries && (fileNames.size() != nChainFiles ||
+                                                            fileNames[0] != fChain->GetListOfFiles()->At(0)->GetTitle())))
                MakeChain(treeName, fileNames, friendInfo, nEntries, friendEntries);
 
             std::unique_ptr<TTreeReader> reader;
             std::unique_ptr<TEntryList> localList;
-            if (entryList.GetN() > 0) {
-               std::tie(reader, localList) = MakeReaderWithEntryList(entryList, start, end);
+            if (!selectedEntries.empty()) {
+               std::tie(reader, localList) = MakeReaderWithEntryList(selectedEntries, start, end);
             } else {
                reader = MakeReader(start, end);
             }
@@ -168,15 +204,24 @@ namespace ROOT {
 
          //////////////////////////////////////////////////////////////////////////
          /// Push a new loaded entry to the stack.
-         void PushTaskFirstEntry(Long64_t entry) { fLoadedEntries.push_back(entry); }
+         void PushTaskFirstEntry(Long64_t entry)
+         {
+            fLoadedEntries.push_back(entry);
+            fCacheEntryRanges.emplace_back(-1, -1);
+         }
 
          //////////////////////////////////////////////////////////////////////////
-         /// Restore the tree of the previous loaded entry, if any.
+         /// Restore the tree of the previous loaded entry, if any, and the entry range of its TTreeCache.
          void PopTaskFirstEntry()
          {
             fLoadedEntries.pop_back();
+            fCacheEntryRanges.pop_back();
             if (fLoadedEntries.size() > 0) {
                fChain->LoadTree(fLoadedEntries.back());
+               const auto &range = fCacheEntryRanges.back();
+               TTreeCache *cache = range.first >= 0 ? GetCurrentTreeCache() : nullptr;
+               if (cache)
+                  cache->SetEntryRange(range.first, range.second);
             }
          }
       };
@@ -189,9 +234,14 @@ namespace ROOT {
       /// User-defined selection of entry numbers to be processed, empty if none was provided
       const TEntryList fEntryList;
       const Internal::FriendInfo fFriendInfo;
+      /// Global entry range [begin, end) to process, set via SetEntriesRange. An end of -1 means "until the end".
+      std::pair<Long64_t, Long64_t> fEntriesRange{0, -1};
+      bool fHasEntriesRange{false}; ///< True if SetEntriesRange was called: tasks then use global entry numbers
 
       ROOT::TThreadedObject<ROOT::Internal::TTreeView> treeView; ///<! Thread-local TreeViews
 
+      static unsigned fgTasksPerWorkerHint; ///< Number of tasks per worker thread aimed at when sizing tasks
+
       Internal::FriendInfo GetFriendInfo(TTree &tree);
       std::string FindTreeName();
 
@@ -201,7 +251,11 @@ namespace ROOT {
       TTreeProcessorMT(TTree &tree, const TEntryList &entries);
       TTreeProcessorMT(TTree &tree);
 
+      void SetEntriesRange(Long64_t beginEntry, Long64_t endEntry = -1);
       void Process(std::function<void(TTreeReader &)> func);
+
+      static void SetTasksPerWorkerHint(unsigned m);
+      static unsigned GetTasksPerWorkerHint();
    };
 
 } // End of namespace ROOT
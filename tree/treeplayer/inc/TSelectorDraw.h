@@ -60,6 +60,7 @@ protected:
    Bool_t         fCleanElist;     //  true if original Tree elist must be saved
    Bool_t         fObjEval;        //  true if fVar1 returns an object (or pointer to).
    Long64_t       fCurrentSubEntry; // Current subentry when fSelectMultiple is true. Used to fill TEntryListArray
+   Bool_t         fProcessedMT;    //! true if the entries were processed by ProcessMT
 
 protected:
    virtual void      ClearFormula();
@@ -105,11 +106,14 @@ public:
    // See TSelectorDraw::GetVal
    virtual Double_t *GetV4() const   {return GetVal(3);}
    virtual Double_t *GetW() const    {return fW;}
+   Bool_t            IsProcessedMT() const {return fProcessedMT;}
    virtual Bool_t    Notify();
    virtual Bool_t    Process(Long64_t /*entry*/) { return kFALSE; }
    virtual void      ProcessFill(Long64_t entry);
    virtual void      ProcessFillMultiple(Long64_t entry);
    virtual void      ProcessFillObject(Long64_t entry);
+   virtual Bool_t    ProcessMT(Long64_t nentries, Long64_t firstentry);
+   static  Bool_t    CanProcessMT(TTree *tree, const char *expressions);
    virtual void      SetEstimate(Long64_t n);
    virtual UInt_t    SplitNames(const TString &varexp, std::vector<TString> &names);
    virtual void      TakeAction();
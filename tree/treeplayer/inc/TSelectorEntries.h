@@ -48,7 +48,9 @@ public :
    virtual void     Init(TTree *tree);
    virtual Bool_t   Notify();
    virtual Bool_t   Process(Long64_t entry);
+   virtual Bool_t   ProcessMT(Long64_t nentries, Long64_t firstentry);
    virtual Int_t    GetEntry(Long64_t entry, Int_t getall = 0);
+   TTreeFormula    *GetSelect() const { return fSelect; }
    virtual Long64_t GetSelectedRows() const { return fSelectedRows; }
    virtual void     SetOption(const char *option) { fOption = option; }
    virtual void     SetObject(TObject *obj) { fObject = obj; }
@@ -131,6 +131,9 @@ protected:
 
    RealInstanceCache fRealInstanceCache; //! Cache accelerating the GetRealInstance function
 
+   void                *fJitFunc;   //! Wrapper of the JIT-compiled version of the formula, if any
+   std::vector<Double_t> fJitValues; //! Values of the leaves passed to the JIT-compiled formula
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -162,6 +165,9 @@ protected:
 
    void              Convert(UInt_t fromVersion);
 
+   Bool_t            GenerateJitCode(std::string &code) const;
+   Double_t          EvalJit(Int_t instance);
+
 private:
    // Not implemented yet
    TTreeFormula(const TTreeFormula&);
@@ -183,6 +189,11 @@ public:
    virtual LongDouble_t   EvalInstanceLD(Int_t i=0, const char *stringStack[]=0) {return EvalInstance<LongDouble_t>(i, stringStack); }
 
    virtual const char *EvalStringInstance(Int_t i=0);
+           Bool_t      CompileJit();
+           Bool_t      IsJitCompiled() const { return fJitFunc != 0; }
+           Bool_t      CanSkipEntryRange(Long64_t first, Long64_t last) const;
+   static  Bool_t      IsJitEnabled();
+   static  void        SetJitEnabled(Bool_t enable = kTRUE);
    virtual void*       EvalObject(Int_t i=0);
    // EvalInstance should be const.  See comment on GetNdata()
    TFormLeafInfo      *GetLeafInfo(Int_t code) const;
@@ -25,6 +25,8 @@
 #include "TVirtualIndex.h"
 #include "TTreeFormula.h"
 
+#include <vector>
+
 class TTreeIndex : public TVirtualIndex {
 
 protected:
@@ -38,6 +40,12 @@ protected:
    TTreeFormula  *fMinorFormula;        //! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  //! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  //! Pointer to minor TreeFormula in Parent tree (if any)
+   std::vector<Long64_t> fFenceValues;      //! Major values of every kFenceStep-th sorted entry
+   std::vector<Long64_t> fFenceValuesMinor; //! Minor values of every kFenceStep-th sorted entry
+   std::vector<Long64_t> fSortedRuns;       //! Start of each sorted run concatenated by Append
+
+   void           BuildFences();
+   Bool_t         FillValuesMT(Long64_t *major, Long64_t *minor);
 
 private:
    TTreeIndex(const TTreeIndex&);            // Not implemented.
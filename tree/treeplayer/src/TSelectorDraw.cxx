@@ -35,6 +35,19 @@ A specialized TSelector for TTree::Draw.
 #include "TStyle.h"
 #include "TClass.h"
 #include "TColor.h"
+#include "TChain.h"
+#include "TCutG.h"
+#include "TFile.h"
+#include "TMath.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#endif
 
 ClassImp(TSelectorDraw);
 
@@ -77,6 +90,7 @@ TSelectorDraw::TSelectorDraw()
    fWeight         = 1;
    fCurrentSubEntry = -1;
    fTreeElistArray  = 0;
+   fProcessedMT     = kFALSE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -110,6 +124,7 @@ void TSelectorDraw::Begin(TTree *tree)
    fTree = tree;
    fDimension = 0;
    fAction = 0;
+   fProcessedMT = kFALSE;
 
    TObject *obj = fInput->FindObject("varexp");
    const char *varexp0   = obj ? obj->GetTitle() : "";
@@ -1004,6 +1019,7 @@ Bool_t TSelectorDraw::CompileVariables(const char *varexp, const char *selection
 
       if (fManager) {
          fManager->Sync();
+         if (fSelect && TTreeFormula::IsJitEnabled()) fSelect->CompileJit();
 
          if (fManager->GetMultiplicity() == -1) fTree->SetBit(TTree::kForceRead);
          if (fManager->GetMultiplicity() >= 1) fMultiplicity = fManager->GetMultiplicity();
@@ -1029,6 +1045,11 @@ Bool_t TSelectorDraw::CompileVariables(const char *varexp, const char *selection
    }
    fManager->Sync();
 
+   if (TTreeFormula::IsJitEnabled()) {
+      if (fSelect) fSelect->CompileJit();
+      for (i = 0; i < ncols; ++i) fVar[i]->CompileJit();
+   }
+
    if (fManager->GetMultiplicity() == -1) fTree->SetBit(TTree::kForceRead);
    if (fManager->GetMultiplicity() >= 1) fMultiplicity = fManager->GetMultiplicity();
 
@@ -1337,6 +1358,256 @@ void TSelectorDraw::ProcessFillObject(Long64_t /*entry*/)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the entries of tree can be processed with
+/// ROOT::TTreeProcessorMT by TSelectorDraw::ProcessMT and
+/// TSelectorEntries::ProcessMT.
+///
+/// This requires implicit multi-threading to be enabled, the tree (or chain)
+/// to be read from files opened read-only, no entry or event list to be set
+/// and expressions not to refer to graphical cuts, whose formulas would be
+/// shared by the threads.
+
+Bool_t TSelectorDraw::CanProcessMT(TTree *tree, const char *expressions)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || !tree) return kFALSE;
+   if (tree->GetEntryList() || tree->GetEventList()) return kFALSE;
+   if (tree->IsA() != TChain::Class()) {
+      TFile *file = tree->GetCurrentFile();
+      if (!file || file->IsWritable() || tree->GetDirectory() != file) return kFALSE;
+   }
+   TIter next(gROOT->GetListOfSpecials());
+   while (TObject *obj = next()) {
+      if (obj->InheritsFrom(TCutG::Class()) && strstr(expressions, obj->GetName())) return kFALSE;
+   }
+   return kTRUE;
+#else
+   (void)tree;
+   (void)expressions;
+   return kFALSE;
+#endif
+}
+
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the draw option holds "mt" as a separate word, delimited by
+/// blanks, commas or semicolons, so that other options do not enable it.
+
+static Bool_t HasMTOption(const TString &option)
+{
+   TString opt = option;
+   opt.ToLower();
+   TString token;
+   Ssiz_t from = 0;
+   while (opt.Tokenize(token, from, "[ ,;]")) {
+      if (token == "mt") return kTRUE;
+   }
+   return kFALSE;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram over the entry clusters of the tree in parallel.
+///
+/// This is only done when the draw option contains the word "mt", because the buffers
+/// returned by GetVal (GetV1..GetV4, GetW) are not filled in this mode.
+///
+/// Each task compiles its own copy of the formulas on the tree of its thread
+/// and fills a histogram local to the thread, the local histograms are added
+/// to the output histogram at the end.  Return false, without touching the
+/// output histogram, when the draw must be done by the sequential loop:
+/// no "mt" option, implicit multi-threading disabled (see CanProcessMT), output that is not a
+/// histogram or profile with fixed binning (e.g. a graph or a histogram whose
+/// limits are computed from the first entries), string or object variables,
+/// TEntryListArray or TTree::SetUpdate.  IsProcessedMT tells which loop was used.
+
+Bool_t TSelectorDraw::ProcessMT(Long64_t nentries, Long64_t firstentry)
+{
+#ifdef R__USE_IMT
+   if (!HasMTOption(GetOption())) return kFALSE;
+   if (fObjEval || fTreeElistArray || fTree->GetUpdate() || nentries <= 0) return kFALSE;
+
+   TH1 *hist = dynamic_cast<TH1*>(fObject);
+   if (!hist || hist->GetBuffer()) return kFALSE;
+   switch (fAction) {
+      case 1: case 2: case 4: case 23: break;
+      case 3: if (hist->TestBit(kCanDelete)) return kFALSE; break;
+      default: return kFALSE;
+   }
+   if (hist->GetXaxis()->CanExtend() || hist->GetYaxis()->CanExtend() || hist->GetZaxis()->CanExtend())
+      return kFALSE;
+
+   TString expressions = fSelect ? fSelect->GetTitle() : "";
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (!fVar[i] || fVar[i]->IsString()) return kFALSE;
+      expressions.Append(":").Append(fVar[i]->GetTitle());
+   }
+   if (fSelect && fSelect->IsString()) return kFALSE;
+   if (!CanProcessMT(fTree, expressions)) return kFALSE;
+
+   // A chain weight applies to all its trees only if it was set as global.
+   const Bool_t globalWeight = fTree->IsA() != TChain::Class() || fTree->TestBit(TChain::kGlobalWeight);
+   const Bool_t useJit = TTreeFormula::IsJitEnabled();
+
+   std::mutex mutex;
+   std::map<std::thread::id, std::unique_ptr<TH1>> partials;
+   Long64_t nselected = 0;
+   Bool_t failed = kFALSE;
+
+   auto processRange = [&](TTreeReader &reader) {
+      if (!reader.Next()) return;
+      TTree *tree = reader.GetTree();
+
+      TH1 *local = 0;
+      std::unique_ptr<TTreeFormula> select;
+      std::vector<std::unique_ptr<TTreeFormula>> vars(fDimension);
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         if (failed) return;
+
+         auto &partial = partials[std::this_thread::get_id()];
+         if (!partial) {
+            TDirectory::TContext ctxt(nullptr);
+            partial.reset((TH1*)hist->Clone());
+            partial->SetDirectory(nullptr);
+            partial->Reset();
+         }
+         local = partial.get();
+
+         TIter nextAlias(fTree->GetListOfAliases());
+         while (TObject *alias = nextAlias()) tree->SetAlias(alias->GetName(), alias->GetTitle());
+
+         TTreeFormulaManager *manager = new TTreeFormulaManager;
+         if (fSelect) {
+            select.reset(new TTreeFormula("Selection", fSelect->GetTitle(), tree));
+            failed |= !select->GetNdim();
+            manager->Add(select.get());
+         }
+         for (Int_t i = 0; i < fDimension; ++i) {
+            vars[i].reset(new TTreeFormula(fVar[i]->GetName(), fVar[i]->GetTitle(), tree));
+            failed |= !vars[i]->GetNdim();
+            manager->Add(vars[i].get());
+         }
+         manager->Sync();
+         if (failed) return;
+      }
+      if (select) select->SetQuickLoad(kTRUE);
+      for (auto &var : vars) var->SetQuickLoad(kTRUE);
+      if (useJit) {
+         if (select) select->CompileJit();
+         for (auto &var : vars) var->CompileJit();
+      }
+      TTreeFormulaManager *manager = vars.empty() ? select->GetManager() : vars[0]->GetManager();
+
+      Double_t first[4] = {0, 0, 0, 0};
+      Double_t val[4] = {0, 0, 0, 0};
+      auto fill = [&](const Double_t *v, Double_t w) {
+         switch (fAction) {
+            case 1:  local->Fill(v[0], w); break;
+            case 2:  ((TH2*)local)->Fill(v[1], v[0], w); break;
+            case 3:  ((TH3*)local)->Fill(v[2], v[1], v[0], w); break;
+            case 4:  ((TProfile*)local)->Fill(v[1], v[0], w); break;
+            case 23: ((TProfile2D*)local)->Fill(v[2], v[1], v[0], w); break;
+         }
+      };
+
+      Long64_t nfill = 0;
+      Int_t treeNumber = tree->GetTreeNumber();
+      Double_t weight = globalWeight ? fWeight : tree->GetWeight();
+      Long64_t clusterEnd = -1;
+      Bool_t skipCluster = kFALSE;
+      do {
+         if (tree->GetTreeNumber() != treeNumber) {
+            treeNumber = tree->GetTreeNumber();
+            manager->UpdateFormulaLeaves();
+            if (!globalWeight) weight = tree->GetWeight();
+            clusterEnd = -1;
+         }
+
+         // Same cluster skipping as TTreePlayer::Process.
+         if (select) {
+            const Long64_t localEntry = tree->GetTree()->GetReadEntry();
+            if (localEntry >= clusterEnd) {
+               TTree::TClusterIterator clusterIter = tree->GetTree()->GetClusterIterator(localEntry);
+               clusterIter.Next();
+               clusterEnd = TMath::Min(clusterIter.GetNextEntry(), tree->GetTree()->GetEntries());
+               skipCluster = select->CanSkipEntryRange(localEntry, clusterEnd - 1);
+            }
+            if (skipCluster) continue;
+         }
+
+         // Same logic as ProcessFill and ProcessFillMultiple.
+         if (!fMultiplicity) {
+            if (fForceRead && manager->GetNdata() <= 0) continue;
+            Double_t w = weight;
+            if (select) {
+               w = weight * select->EvalInstance(0);
+               if (!w) continue;
+            }
+            for (Int_t k = 0; k < fDimension; ++k) val[k] = vars[k]->EvalInstance(0);
+            fill(val, w);
+            ++nfill;
+            continue;
+         }
+
+         Int_t ndata = manager->GetNdata();
+         if (!ndata) continue;
+
+         Double_t w0 = weight;
+         if (select) {
+            w0 = weight * select->EvalInstance(0);
+            if (!w0 && !fSelectMultiple) continue;
+         }
+         Bool_t haveFirst = kFALSE;
+         if (w0) {
+            for (Int_t k = 0; k < fDimension; ++k) first[k] = vars[k]->EvalInstance(0);
+            fill(first, w0);
+            ++nfill;
+            haveFirst = kTRUE;
+         } else {
+            for (Int_t k = 0; k < fDimension; ++k) vars[k]->ResetLoading();
+         }
+         for (Int_t i = 1; i < ndata; ++i) {
+            Double_t ww = w0;
+            if (fSelectMultiple) {
+               ww = weight * select->EvalInstance(i);
+               if (ww == 0) continue;
+               if (!haveFirst) {
+                  for (Int_t k = 0; k < fDimension; ++k) {
+                     if (!fVarMultiple[k]) first[k] = vars[k]->EvalInstance(0);
+                  }
+                  haveFirst = kTRUE;
+               }
+            }
+            for (Int_t k = 0; k < fDimension; ++k) val[k] = fVarMultiple[k] ? vars[k]->EvalInstance(i) : first[k];
+            fill(val, ww);
+            ++nfill;
+         }
+      } while (reader.Next());
+
+      std::lock_guard<std::mutex> lock(mutex);
+      nselected += nfill;
+   };
+
+   ROOT::TTreeProcessorMT processor(*fTree);
+   processor.SetEntriesRange(firstentry, firstentry + nentries);
+   processor.Process(processRange);
+
+   if (failed) return kFALSE;
+
+   for (auto &partial : partials) hist->Add(partial.second.get());
+   fSelectedRows += nselected;
+   fNfill = 0;
+   fProcessedMT = kTRUE;
+   return kTRUE;
+#else
+   (void)nentries;
+   (void)firstentry;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set number of entries to estimate variable limits.
 
@@ -38,7 +38,15 @@ To use this file, try the following session on your Tree T:
 #include "TSelectorEntries.h"
 #include "TTree.h"
 #include "TTreeFormula.h"
+#include "TMath.h"
 #include "TSelectorScalar.h"
+#include "TSelectorDraw.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#include <atomic>
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default, constructor.
@@ -192,6 +200,94 @@ Bool_t TSelectorEntries::Process(Long64_t /* entry */)
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Count the selected entries over the entry clusters of the tree in
+/// parallel, each task compiling its own copy of the selection on the tree
+/// of its thread.
+///
+/// Return false when the entries must be counted by the sequential loop,
+/// see TSelectorDraw::CanProcessMT.
+
+Bool_t TSelectorEntries::ProcessMT(Long64_t nentries, Long64_t firstentry)
+{
+#ifdef R__USE_IMT
+   if (!fSelect || fSelect->IsString() || nentries <= 0) return kFALSE;
+   if (!TSelectorDraw::CanProcessMT(fChain, fSelect->GetTitle())) return kFALSE;
+
+   std::atomic<Long64_t> nselected(0);
+   std::atomic<Bool_t> failed(kFALSE);
+   const Bool_t useJit = TTreeFormula::IsJitEnabled();
+
+   auto processRange = [&](TTreeReader &reader) {
+      if (failed || !reader.Next()) return;
+      TTree *tree = reader.GetTree();
+
+      TIter nextAlias(fChain->GetListOfAliases());
+      while (TObject *alias = nextAlias()) tree->SetAlias(alias->GetName(), alias->GetTitle());
+
+      TTreeFormula select("Selection", fSelect->GetTitle(), tree);
+      if (!select.GetNdim()) {
+         failed = kTRUE;
+         return;
+      }
+      select.SetQuickLoad(kTRUE);
+      if (useJit) select.CompileJit();
+
+      // Same logic as Process.
+      Long64_t nsel = 0;
+      Int_t treeNumber = tree->GetTreeNumber();
+      Long64_t clusterEnd = -1;
+      Bool_t skipCluster = kFALSE;
+      do {
+         if (tree->GetTreeNumber() != treeNumber) {
+            treeNumber = tree->GetTreeNumber();
+            select.UpdateFormulaLeaves();
+            clusterEnd = -1;
+         }
+
+         // Same cluster skipping as TTreePlayer::Process.
+         const Long64_t localEntry = tree->GetTree()->GetReadEntry();
+         if (localEntry >= clusterEnd) {
+            TTree::TClusterIterator clusterIter = tree->GetTree()->GetClusterIterator(localEntry);
+            clusterIter.Next();
+            clusterEnd = TMath::Min(clusterIter.GetNextEntry(), tree->GetTree()->GetEntries());
+            skipCluster = select.CanSkipEntryRange(localEntry, clusterEnd - 1);
+         }
+         if (skipCluster) continue;
+         if (!fSelectMultiple) {
+            if (select.EvalInstance(0)) ++nsel;
+            continue;
+         }
+         Int_t ndata = select.GetNdata();
+         if (!ndata) continue;
+         if (select.EvalInstance(0)) {
+            ++nsel;
+         } else {
+            for (Int_t i = 1; i < ndata; i++) {
+               if (select.EvalInstance(i)) {
+                  ++nsel;
+                  break;
+               }
+            }
+         }
+      } while (reader.Next());
+      nselected += nsel;
+   };
+
+   ROOT::TTreeProcessorMT processor(*fChain);
+   processor.SetEntriesRange(firstentry, firstentry + nentries);
+   processor.Process(processRange);
+
+   if (failed) return kFALSE;
+   fSelectedRows += nselected;
+   return kTRUE;
+#else
+   (void)nentries;
+   (void)firstentry;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the selection expression.
 
@@ -45,6 +45,8 @@
 #include "TFormLeafInfoReference.h"
 
 #include "TEntryList.h"
+#include "TEnv.h"
+#include "TVirtualMutex.h"
 
 #include <ctype.h>
 #include <stdio.h>
@@ -52,6 +54,10 @@
 #include <stdlib.h>
 #include <typeinfo>
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
 
 const Int_t kMaxLen     = 1024;
 
@@ -137,6 +143,7 @@ TTreeFormula::TTreeFormula(): ROOT::v5::TFormula(), fQuickLoad(kFALSE), fNeedLoa
    fManager      = 0;
    fMultiplicity = 0;
    fConstLD      = 0;
+   fJitFunc      = 0;
 
    Int_t j,k;
    for (j=0; j<kMAXCODES; j++) {
@@ -187,6 +194,7 @@ void TTreeFormula::Init(const char*name, const char* expression)
    fAxis         = 0;
    fHasCast      = 0;
    fConstLD      = 0;
+   fJitFunc      = 0;
    Int_t i,j,k;
    fManager      = new TTreeFormulaManager;
    fManager->Add(this);
@@ -3992,6 +4000,8 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
       }
    }
 
+   if (std::is_same<T,Double_t>::value && fJitFunc) return EvalJit(instance);
+
    T tab[kMAXFOUND];
    const Int_t kMAXSTRINGFOUND = 10;
    const char *stringStackLocal[kMAXSTRINGFOUND];
@@ -4391,6 +4401,373 @@ template double TTreeFormula::EvalInstance<double> (int, char const**);
 template long double TTreeFormula::EvalInstance<long double> (int, char const**);
 template long long TTreeFormula::EvalInstance<long long> (int, char const**);
 
+namespace {
+
+// -1 until the "TreeFormula.Jit" resource has been read.
+std::atomic<Int_t> gTreeFormulaJitEnabled{-1};
+
+// Helpers reproducing the guards of TTreeFormula::EvalInstance, declared
+// once to the interpreter before the first formula is compiled.
+const char *gTreeFormulaJitHelpers =
+   "#include \"TMath.h\"\n"
+   "#include <algorithm>\n"
+   "namespace ROOT { namespace Internal { namespace TTreeFormulaJit {\n"
+   "inline Double_t Div(Double_t a, Double_t b) { return b == 0 ? 0 : a / b; }\n"
+   "inline Double_t Mod(Double_t a, Double_t b) { return Double_t(Long64_t(a) % Long64_t(b)); }\n"
+   "inline Double_t Tan(Double_t a) { return TMath::Cos(a) == 0 ? 0 : TMath::Tan(a); }\n"
+   "inline Double_t ACos(Double_t a) { return TMath::Abs(a) > 1 ? 0 : TMath::ACos(a); }\n"
+   "inline Double_t ASin(Double_t a) { return TMath::Abs(a) > 1 ? 0 : TMath::ASin(a); }\n"
+   "inline Double_t TanH(Double_t a) { return TMath::CosH(a) == 0 ? 0 : TMath::TanH(a); }\n"
+   "inline Double_t ACosH(Double_t a) { return a < 1 ? 0 : TMath::ACosH(a); }\n"
+   "inline Double_t ATanH(Double_t a) { return TMath::Abs(a) > 1 ? 0 : TMath::ATanH(a); }\n"
+   "inline Double_t Sqrt(Double_t a) { return TMath::Sqrt(TMath::Abs(a)); }\n"
+   "inline Double_t Log(Double_t a) { return a > 0 ? TMath::Log(a) : 0; }\n"
+   "inline Double_t Log10(Double_t a) { return a > 0 ? TMath::Log10(a) : 0; }\n"
+   "inline Double_t Exp(Double_t a) { return a < -700 ? 0 : TMath::Exp(a > 700 ? 700 : a); }\n"
+   "inline Double_t Sign(Double_t a) { return a < 0 ? -1 : 1; }\n"
+   "inline Double_t Int(Double_t a) { return Double_t(Long64_t(a)); }\n"
+   "inline Double_t Not(Double_t a) { return a != 0 ? 0 : 1; }\n"
+   "inline Double_t Bool(bool a) { return a ? 1 : 0; }\n"
+   "inline Double_t BitAnd(Double_t a, Double_t b) { return ULong64_t(a) & ULong64_t(b); }\n"
+   "inline Double_t BitOr(Double_t a, Double_t b) { return ULong64_t(a) | ULong64_t(b); }\n"
+   "inline Double_t LeftShift(Double_t a, Double_t b) { return ULong64_t(a) << ULong64_t(b); }\n"
+   "inline Double_t RightShift(Double_t a, Double_t b) { return ULong64_t(a) >> ULong64_t(b); }\n"
+   "} } }\n";
+
+// Signature of the interpreter wrapper of a compiled formula.
+typedef void (*TTreeFormulaJitFunc_t)(void*, int, void**, void*);
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if TTree::Draw and TTree::Scan should try to JIT-compile
+/// their formulas (see TTreeFormula::CompileJit).
+///
+/// The default is taken from the resource "TreeFormula.Jit" and can be
+/// overridden with TTreeFormula::SetJitEnabled.
+
+Bool_t TTreeFormula::IsJitEnabled()
+{
+   if (gTreeFormulaJitEnabled < 0) {
+      R__LOCKGUARD(gROOTMutex);
+      if (gTreeFormulaJitEnabled < 0)
+         gTreeFormulaJitEnabled = gEnv->GetValue("TreeFormula.Jit", 0) ? 1 : 0;
+   }
+   return gTreeFormulaJitEnabled > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the JIT compilation of the formulas used by TTree::Draw
+/// and TTree::Scan.
+
+void TTreeFormula::SetJitEnabled(Bool_t enable)
+{
+   gTreeFormulaJitEnabled = enable ? 1 : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the operations of this formula into a C++ expression of the
+/// array `v`, where `v[code]` holds the value of the leaf `code`.
+///
+/// Return false if the formula uses a feature that the compiled version
+/// does not support (strings, arrays, aliases, method calls, conditional
+/// operators, function calls, random numbers, ...); such a formula keeps
+/// being evaluated by EvalInstance.
+
+Bool_t TTreeFormula::GenerateJitCode(std::string &code) const
+{
+   if (fNoper < 2 || fNcodes <= 0 || fMultiplicity != 0 || fAxis) return kFALSE;
+   if (TestBit(kMissingLeaf)) return kFALSE;
+   for (Int_t c = 0; c < fNcodes; ++c) {
+      if (fLookupType[c] != kDirect || fCodes[c] < 0 || IsLeafString(c)) return kFALSE;
+   }
+
+   const std::string ns = "ROOT::Internal::TTreeFormulaJit::";
+   std::vector<std::string> stack;
+   char buf[64];
+
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t oper = GetOper()[i];
+      const Int_t action = oper >> kTFOperShift;
+
+      std::string unary, binary, infix;
+      switch (action) {
+         case kEnd:
+            i = fNoper;
+            continue;
+         case kConstant:
+            snprintf(buf, sizeof(buf), "(%.17g)", fConst[oper & kTFOperMask]);
+            stack.push_back(buf);
+            continue;
+         case kDefinedVariable:
+            snprintf(buf, sizeof(buf), "v[%d]", oper & kTFOperMask);
+            stack.push_back(buf);
+            continue;
+         case kpi:
+            stack.push_back("TMath::ACos(-1)");
+            continue;
+         case kBoolOptimize:
+            // The generated && and || already skip their right operand.
+            continue;
+
+         case kAdd:         infix = "+";  break;
+         case kSubstract:   infix = "-";  break;
+         case kMultiply:    infix = "*";  break;
+         case kAnd:         infix = "&&"; break;
+         case kOr:          infix = "||"; break;
+         case kEqual:       infix = "=="; break;
+         case kNotEqual:    infix = "!="; break;
+         case kLess:        infix = "<";  break;
+         case kGreater:     infix = ">";  break;
+         case kLessThan:    infix = "<="; break;
+         case kGreaterThan: infix = ">="; break;
+
+         case kDivide:      binary = ns + "Div";        break;
+         case kModulo:      binary = ns + "Mod";        break;
+         case katan2:       binary = "TMath::ATan2";    break;
+         case kfmod:        binary = "fmod";            break;
+         case kpow:         binary = "TMath::Power";    break;
+         case kmin:         binary = "std::min<Double_t>"; break;
+         case kmax:         binary = "std::max<Double_t>"; break;
+         case kBitAnd:      binary = ns + "BitAnd";     break;
+         case kBitOr:       binary = ns + "BitOr";      break;
+         case kLeftShift:   binary = ns + "LeftShift";  break;
+         case kRightShift:  binary = ns + "RightShift"; break;
+
+         case kcos:     unary = "TMath::Cos";   break;
+         case ksin:     unary = "TMath::Sin";   break;
+         case ktan:     unary = ns + "Tan";     break;
+         case kacos:    unary = ns + "ACos";    break;
+         case kasin:    unary = ns + "ASin";    break;
+         case katan:    unary = "TMath::ATan";  break;
+         case kcosh:    unary = "TMath::CosH";  break;
+         case ksinh:    unary = "TMath::SinH";  break;
+         case ktanh:    unary = ns + "TanH";    break;
+         case kacosh:   unary = ns + "ACosH";   break;
+         case kasinh:   unary = "TMath::ASinH"; break;
+         case katanh:   unary = ns + "ATanH";   break;
+         case ksq:      unary = "TMath::Sq";    break;
+         case ksqrt:    unary = ns + "Sqrt";    break;
+         case klog:     unary = ns + "Log";     break;
+         case klog10:   unary = ns + "Log10";   break;
+         case kexp:     unary = ns + "Exp";     break;
+         case kabs:     unary = "TMath::Abs";   break;
+         case ksign:    unary = ns + "Sign";    break;
+         case kint:     unary = ns + "Int";     break;
+         case kNot:     unary = ns + "Not";     break;
+         case kSignInv: unary = "-";            break;
+
+         default:
+            return kFALSE;
+      }
+
+      if (!unary.empty()) {
+         if (stack.empty()) return kFALSE;
+         stack.back() = unary + "(" + stack.back() + ")";
+         continue;
+      }
+      if (stack.size() < 2) return kFALSE;
+      std::string rhs = stack.back();
+      stack.pop_back();
+      std::string &lhs = stack.back();
+      if (!binary.empty()) {
+         lhs = binary + "(" + lhs + "," + rhs + ")";
+      } else if (infix == "+" || infix == "-" || infix == "*") {
+         lhs = "(" + lhs + infix + rhs + ")";
+      } else {
+         lhs = ns + "Bool(" + lhs + infix + rhs + ")";
+      }
+   }
+
+   if (stack.size() != 1) return kFALSE;
+   code = stack.front();
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile this formula with the interpreter's JIT so that
+/// EvalInstance<Double_t> calls a function instead of walking the operation
+/// stack.
+///
+/// Only formulas made of constants, numerical non-array leaves and the
+/// arithmetic, comparison, logical and mathematical operators are supported.
+/// For any other formula false is returned and the formula keeps being
+/// interpreted.  Formulas with the same expression share the compiled code.
+
+Bool_t TTreeFormula::CompileJit()
+{
+   if (fJitFunc) return kTRUE;
+   if (!gCling) return kFALSE;
+
+   std::string expr;
+   if (!GenerateJitCode(expr)) return kFALSE;
+
+   static std::unordered_map<std::string, void*> gJitCache;
+   static Bool_t gHelpersDeclared = kFALSE;
+
+   R__LOCKGUARD(gROOTMutex);
+
+   auto found = gJitCache.find(expr);
+   if (found != gJitCache.end()) {
+      fJitFunc = found->second;
+   } else {
+      if (!gHelpersDeclared) {
+         if (!gCling->Declare(gTreeFormulaJitHelpers)) return kFALSE;
+         gHelpersDeclared = kTRUE;
+      }
+      TString funcName = TString::Format("R__TTreeFormulaJit_%zx", std::hash<std::string>()(expr));
+      std::string decl = "#pragma cling optimize(2)\nDouble_t ";
+      decl += funcName.Data();
+      decl += "(const Double_t *v) { return " + expr + "; }\n";
+
+      void *fptr = 0;
+      if (gCling->Declare(decl.c_str())) {
+         TMethodCall method;
+         method.InitWithPrototype(funcName, "const Double_t*");
+         if (method.IsValid())
+            fptr = (void*)gCling->CallFunc_IFacePtr(method.GetCallFunc()).fGeneric;
+      }
+      if (!fptr) {
+         Warning("CompileJit", "Could not compile %s, it will be interpreted", GetTitle());
+         return kFALSE;
+      }
+      gJitCache[expr] = fptr;
+      fJitFunc = fptr;
+   }
+   fJitValues.assign(fNcodes, 0.);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the leaves used by this formula and evaluate its compiled version.
+
+Double_t TTreeFormula::EvalJit(Int_t instance)
+{
+   const Bool_t willLoad = (instance==0 || fNeedLoading); fNeedLoading = kFALSE;
+   if (willLoad) fDidBooleanOptimization = kFALSE;
+
+   for (Int_t code = 0; code < fNcodes; ++code) {
+      TT_EVAL_INIT_LOOP;
+      fJitValues[code] = leaf->GetTypedValue<Double_t>(real_instance);
+   }
+
+   const Double_t *values = fJitValues.data();
+   void *args[1] = { &values };
+   Double_t result = 0;
+   (*(TTreeFormulaJitFunc_t)fJitFunc)(0, 1, args, &result);
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the zone maps of the branches used by this formula prove
+/// that it is zero for all the entries `first` to `last` of the current tree,
+/// so that a selection does not need to read them (see
+/// TBranch::GetValueRange).
+///
+/// The formula is evaluated on the range of values of its leaves.  Only
+/// formulas made of constants, numerical leaves of the tree itself that are
+/// not variable size arrays, and the arithmetic, comparison and logical
+/// operators are supported; for any other formula false is returned.
+
+Bool_t TTreeFormula::CanSkipEntryRange(Long64_t first, Long64_t last) const
+{
+   if (fNoper < 1 || fNcodes <= 0 || fAxis) return kFALSE;
+   if (TestBit(kMissingLeaf)) return kFALSE;
+   TTree *tree = fTree ? fTree->GetTree() : 0;
+   if (!tree) return kFALSE;
+
+   typedef std::pair<Double_t, Double_t> Range_t;
+   std::vector<Range_t> ranges(fNcodes);
+   for (Int_t c = 0; c < fNcodes; ++c) {
+      if (fLookupType[c] != kDirect || fCodes[c] < 0 || IsLeafString(c)) return kFALSE;
+      TLeaf *leaf = GetLeaf(c);
+      if (!leaf || leaf->GetLeafCount() || leaf->GetBranch()->GetTree() != tree) return kFALSE;
+      if (!leaf->GetBranch()->GetValueRange(first, last, ranges[c].first, ranges[c].second)) return kFALSE;
+      if (ranges[c].first > ranges[c].second) return kFALSE;
+   }
+
+   // 1 if the range only holds true values, 0 if it is only 0 and -1 otherwise.
+   auto truth = [](const Range_t &r) { return (r.first > 0 || r.second < 0) ? 1 : (r.first == 0 && r.second == 0) ? 0 : -1; };
+   auto boolean = [](Int_t t) { return t < 0 ? Range_t(0, 1) : Range_t(t, t); };
+
+   std::vector<Range_t> stack;
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t oper = GetOper()[i];
+      const Int_t action = oper >> kTFOperShift;
+
+      switch (action) {
+         case kEnd:
+            i = fNoper;
+            continue;
+         case kConstant:
+            stack.push_back(Range_t(fConst[oper & kTFOperMask], fConst[oper & kTFOperMask]));
+            continue;
+         case kDefinedVariable:
+            stack.push_back(ranges[oper & kTFOperMask]);
+            continue;
+         case kpi:
+            stack.push_back(Range_t(TMath::Pi(), TMath::Pi()));
+            continue;
+         case kBoolOptimize:
+            continue;
+         case kSignInv:
+            if (stack.empty()) return kFALSE;
+            stack.back() = Range_t(-stack.back().second, -stack.back().first);
+            continue;
+         case kNot: {
+            if (stack.empty()) return kFALSE;
+            Int_t t = truth(stack.back());
+            stack.back() = boolean(t < 0 ? t : 1 - t);
+            continue;
+         }
+      }
+
+      if (stack.size() < 2) return kFALSE;
+      const Range_t b = stack.back();
+      stack.pop_back();
+      Range_t &a = stack.back();
+      switch (action) {
+         case kAdd:
+            a = Range_t(a.first + b.first, a.second + b.second);
+            break;
+         case kSubstract:
+            a = Range_t(a.first - b.second, a.second - b.first);
+            break;
+         case kMultiply: {
+            const Double_t p[4] = {a.first * b.first, a.first * b.second, a.second * b.first, a.second * b.second};
+            a = Range_t(*std::min_element(p, p + 4), *std::max_element(p, p + 4));
+            break;
+         }
+         case kLess:        a = boolean(a.second < b.first ? 1 : a.first >= b.second ? 0 : -1); break;
+         case kLessThan:    a = boolean(a.second <= b.first ? 1 : a.first > b.second ? 0 : -1); break;
+         case kGreater:     a = boolean(a.first > b.second ? 1 : a.second <= b.first ? 0 : -1); break;
+         case kGreaterThan: a = boolean(a.first >= b.second ? 1 : a.second < b.first ? 0 : -1); break;
+         case kEqual:
+         case kNotEqual: {
+            Int_t t = (a.second < b.first || b.second < a.first) ? 0 : (a.first == a.second && a == b) ? 1 : -1;
+            a = boolean((action == kEqual || t < 0) ? t : 1 - t);
+            break;
+         }
+         case kAnd: {
+            Int_t ta = truth(a), tb = truth(b);
+            a = boolean((ta == 0 || tb == 0) ? 0 : (ta == 1 && tb == 1) ? 1 : -1);
+            break;
+         }
+         case kOr: {
+            Int_t ta = truth(a), tb = truth(b);
+            a = boolean((ta == 1 || tb == 1) ? 1 : (ta == 0 && tb == 0) ? 0 : -1);
+            break;
+         }
+         default:
+            return kFALSE;
+      }
+      // e.g. infinity minus infinity
+      if (TMath::IsNaN(a.first) || TMath::IsNaN(a.second)) return kFALSE;
+   }
+
+   return stack.size() == 1 && truth(stack.front()) == 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return DataMember corresponding to code.
 ///
@@ -16,6 +16,19 @@ A Tree Index with majorname and minorname.
 #include "TTreeIndex.h"
 #include "TTree.h"
 #include "TMath.h"
+#include "TROOT.h"
+#include "TSelectorDraw.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#endif
+
+#include <algorithm>
 
 ClassImp(TTreeIndex);
 
@@ -39,6 +52,66 @@ struct IndexSortComparator {
   Long64_t *fValMajor, *fValMinor;
 };
 
+namespace {
+
+// Distance between two fences, i.e. size of the blocks searched by FindValues
+// once the fences have located the block of a value.
+const Long64_t kFenceStep = 256;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the consecutive sorted runs of index, runs holding the start of each
+/// run followed by the total size.
+
+void R__MergeSortedRuns(Long64_t *index, std::vector<Long64_t> runs, IndexSortComparator comp)
+{
+   while (runs.size() > 2) {
+      const std::size_t nmerges = (runs.size() - 1) / 2;
+      auto mergePair = [&](std::size_t i) {
+         std::inplace_merge(index + runs[2*i], index + runs[2*i+1], index + runs[2*i+2], comp);
+      };
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled() && nmerges > 1) {
+         std::vector<std::size_t> pairs(nmerges);
+         for (std::size_t i = 0; i < nmerges; ++i) pairs[i] = i;
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(mergePair, pairs);
+      } else
+#endif
+      for (std::size_t i = 0; i < nmerges; ++i) mergePair(i);
+
+      std::vector<Long64_t> merged;
+      for (std::size_t i = 0; i < nmerges; ++i) merged.push_back(runs[2*i]);
+      if ((runs.size() - 1) % 2) merged.push_back(runs[runs.size() - 2]);
+      merged.push_back(runs.back());
+      runs.swap(merged);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort index according to comp.  With implicit multi-threading enabled, large
+/// indices are sorted in chunks in parallel and the chunks are then merged.
+
+void R__SortIndex(Long64_t *index, Long64_t n, IndexSortComparator comp)
+{
+#ifdef R__USE_IMT
+   const Long64_t nchunks = ROOT::IsImplicitMTEnabled() ? ROOT::GetImplicitMTPoolSize() : 1;
+   if (nchunks > 1 && n > 16 * kFenceStep * nchunks) {
+      std::vector<Long64_t> runs;
+      for (Long64_t i = 0; i < nchunks; ++i) runs.push_back(i * n / nchunks);
+      runs.push_back(n);
+      std::vector<Long64_t> chunks(nchunks);
+      for (Long64_t i = 0; i < nchunks; ++i) chunks[i] = i;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Long64_t i) { std::sort(index + runs[i], index + runs[i+1], comp); }, chunks);
+      R__MergeSortedRuns(index, runs, comp);
+      return;
+   }
+#endif
+   std::sort(index, index + n, comp);
+}
+
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -165,21 +238,23 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    Long64_t *tmp_minor = new Long64_t[fN];
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+   if (!FillValuesMT(tmp_major, tmp_minor)) {
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
    }
    fIndex = new Long64_t[fN];
    for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
+   R__SortIndex(fIndex, fN, IndexSortComparator(tmp_major, tmp_minor) );
    //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
@@ -191,6 +266,7 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    delete [] tmp_major;
    delete [] tmp_minor;
    fTree->LoadTree(oldEntry);
+   BuildFences();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -228,6 +304,13 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       Long64_t oldn = fN;
       fN += add->GetN();
 
+      // Both parts are sorted: remember where the new one starts so that the
+      // final sort only needs to merge them.
+      if (fSortedRuns.empty()) fSortedRuns.push_back(0);
+      if (oldn > fSortedRuns.back()) fSortedRuns.push_back(oldn);
+      fFenceValues.clear();
+      fFenceValuesMinor.clear();
+
       Long64_t *oldIndex = fIndex;
       Long64_t *oldValues = GetIndexValues();
       Long64_t *oldValues2 = GetIndexValuesMinor();
@@ -268,7 +351,14 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       Long64_t *conv = new Long64_t[fN];
 
       for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
+      if (fSortedRuns.empty()) {
+         R__SortIndex(conv, fN, IndexSortComparator(addValues, addValues2) );
+      } else {
+         std::vector<Long64_t> runs(fSortedRuns);
+         runs.push_back(fN);
+         R__MergeSortedRuns(conv, runs, IndexSortComparator(addValues, addValues2) );
+         fSortedRuns.clear();
+      }
       //Long64_t *w = fIndexValues;
       //TMath::Sort(fN,w,conv,0);
 
@@ -285,9 +375,87 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       delete [] addValues2;
       delete [] ind;
       delete [] conv;
+      BuildFences();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sample every kFenceStep-th value of the sorted index.  These fences are
+/// small enough to stay in cache and let FindValues restrict the bisection of
+/// the large value arrays to a single block.
+
+void TTreeIndex::BuildFences()
+{
+   fFenceValues.clear();
+   fFenceValuesMinor.clear();
+   if (fN < 2 * kFenceStep || !fIndexValues || !fIndexValuesMinor) return;
+   const Long64_t nfences = (fN + kFenceStep - 1) / kFenceStep;
+   fFenceValues.reserve(nfences);
+   fFenceValuesMinor.reserve(nfences);
+   for (Long64_t i = 0; i < fN; i += kFenceStep) {
+      fFenceValues.push_back(fIndexValues[i]);
+      fFenceValuesMinor.push_back(fIndexValuesMinor[i]);
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the major and minor values of all the entries of the tree over its
+/// clusters in parallel, each task using its own formulas.
+///
+/// Return false if implicit multi-threading is disabled or the tree cannot be
+/// processed in parallel (see TSelectorDraw::CanProcessMT), in which case
+/// the values are evaluated sequentially.
+
+Bool_t TTreeIndex::FillValuesMT(Long64_t *major, Long64_t *minor)
+{
+#ifdef R__USE_IMT
+   if (!TSelectorDraw::CanProcessMT(fTree, fMajorName + ":" + fMinorName)) return kFALSE;
+
+   std::mutex mutex;
+   std::atomic<Bool_t> failed(kFALSE);
+
+   auto fillRange = [&](TTreeReader &reader) {
+      if (failed || !reader.Next()) return;
+      TTree *tree = reader.GetTree();
+
+      std::unique_ptr<TTreeFormula> majorFormula, minorFormula;
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         TIter nextAlias(fTree->GetListOfAliases());
+         while (TObject *alias = nextAlias()) tree->SetAlias(alias->GetName(), alias->GetTitle());
+         majorFormula.reset(new TTreeFormula("Major", fMajorName.Data(), tree));
+         minorFormula.reset(new TTreeFormula("Minor", fMinorName.Data(), tree));
+      }
+      if (majorFormula->GetNdim() != 1 || minorFormula->GetNdim() != 1) {
+         failed = kTRUE;
+         return;
+      }
+
+      Int_t current = tree->GetTreeNumber();
+      do {
+         const Long64_t entry = reader.GetCurrentEntry();
+         if (entry >= fN) break;
+         if (tree->GetTreeNumber() != current) {
+            current = tree->GetTreeNumber();
+            majorFormula->UpdateFormulaLeaves();
+            minorFormula->UpdateFormulaLeaves();
+         }
+         major[entry] = (Long64_t) majorFormula->EvalInstance<LongDouble_t>();
+         minor[entry] = (Long64_t) minorFormula->EvalInstance<LongDouble_t>();
+      } while (reader.Next());
+   };
+
+   ROOT::TTreeProcessorMT processor(*fTree);
+   processor.SetEntriesRange(0, fN);
+   processor.Process(fillRange);
+   return !failed;
+#else
+   (void)major;
+   (void)minor;
+   return kFALSE;
+#endif
+}
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -354,6 +522,24 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
 Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
 {
    Long64_t mid, step, pos = 0, count = fN;
+   if (!fFenceValues.empty()) {
+      // find the first fence not lower than major|minor, the value is then
+      // located in the block ending at this fence
+      const Long64_t nfences = fFenceValues.size();
+      Long64_t fpos = 0, fcount = nfences;
+      while( fcount > 0 ) {
+         step = fcount / 2;
+         mid = fpos + step;
+         if( fFenceValues[mid] < major
+             || ( fFenceValues[mid] == major &&  fFenceValuesMinor[mid] < minor ) ) {
+            fpos = mid+1;
+            fcount -= step + 1;
+         } else
+            fcount = step;
+      }
+      pos = fpos > 0 ? (fpos-1) * kFenceStep + 1 : 0;
+      count = (fpos < nfences ? fpos * kFenceStep : fN) - pos;
+   }
    // find lower bound using bisection
    while( count > 0 ) {
       step = count / 2;
@@ -561,6 +747,7 @@ void TTreeIndex::Streamer(TBuffer &R__b)
       fIndex      = new Long64_t[fN];
       R__b.ReadFastArray(fIndex,fN);
       R__b.CheckByteCount(R__s, R__c, TTreeIndex::IsA());
+      BuildFences();
    } else {
       R__c = R__b.WriteVersion(TTreeIndex::IsA(), kTRUE);
       TVirtualIndex::Streamer(R__b);
@@ -2244,6 +2244,19 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
 
    Bool_t process = (selector->GetAbort() != TSelector::kAbortProcess &&
                     (selector->Version() != 0 || selector->GetStatus() != -1)) ? kTRUE : kFALSE;
+
+   // TTree::Draw and TTree::Project with the "mt" option, and
+   // TTree::GetEntries(selection), can process the entry clusters in parallel
+   // when implicit multi-threading is enabled.
+   if (process && ROOT::IsImplicitMTEnabled()) {
+      Bool_t processedMT = kFALSE;
+      if (selector->IsA() == TSelectorDraw::Class())
+         processedMT = ((TSelectorDraw*)selector)->ProcessMT(nentries, firstentry);
+      else if (selector->IsA() == TSelectorEntries::Class())
+         processedMT = ((TSelectorEntries*)selector)->ProcessMT(nentries, firstentry);
+      if (processedMT) process = kFALSE;
+   }
+
    if (process) {
 
       Long64_t readbytesatstart = 0;
@@ -2284,6 +2297,18 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
       fSelectorUpdate = selector;
       UpdateFormulaLeaves();
 
+      // Skip the clusters in which the zone maps of the branches prove that
+      // no entry passes the selection (see TTreeFormula::CanSkipEntryRange).
+      TTreeFormula *pruneSelect = 0;
+      if (!fTree->GetEntryList()) {
+         if (selector->IsA() == TSelectorDraw::Class())
+            pruneSelect = ((TSelectorDraw*)selector)->GetSelect();
+         else if (selector->IsA() == TSelectorEntries::Class())
+            pruneSelect = ((TSelectorEntries*)selector)->GetSelect();
+      }
+      Long64_t clusterEnd = -1;
+      Int_t clusterTree = -1;
+
       for (entry=firstentry;entry<firstentry+nentries;entry++) {
          entryNumber = fTree->GetEntryNumber(entry);
          if (entryNumber < 0) break;
@@ -2291,6 +2316,16 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
          if (gROOT->IsInterrupted()) break;
          localEntry = fTree->LoadTree(entryNumber);
          if (localEntry < 0) break;
+         if (pruneSelect && (localEntry >= clusterEnd || fTree->GetTreeNumber() != clusterTree)) {
+            clusterTree = fTree->GetTreeNumber();
+            TTree::TClusterIterator clusterIter = fTree->GetTree()->GetClusterIterator(localEntry);
+            clusterIter.Next();
+            clusterEnd = TMath::Min(clusterIter.GetNextEntry(), fTree->GetTree()->GetEntries());
+            if (pruneSelect->CanSkipEntryRange(localEntry, clusterEnd - 1)) {
+               entry += clusterEnd - localEntry - 1;
+               continue;
+            }
+         }
          if(useCutFill) {
             if (selector->ProcessCut(localEntry))
                selector->ProcessFill(localEntry); //<==call user analysis function
@@ -2645,6 +2680,10 @@ Long64_t TTreePlayer::Scan(const char *varexp, const char *selection,
       }
    }
 
+   // The columns are formatted by TTreeFormula::PrintValue, only the selection
+   // benefits from the compiled evaluation.
+   if (select && TTreeFormula::IsJitEnabled()) select->CompileJit();
+
 //*-*- Print header
    onerow = "***********";
    if (hasArray) onerow += "***********";
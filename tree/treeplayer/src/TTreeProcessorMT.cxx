@@ -19,15 +19,19 @@ passes a function whose only parameter is a TTreeReader. The function iterates
 on a subrange of entries by using that TTreeReader.
 
 The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the subranges,
-each corresponding to a cluster in the TTree. This is possible thanks to the use
-of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
-objects.
+each made of one or more clusters of the TTree, or of a part of a large cluster, so that
+about GetTasksPerWorkerHint() subranges are processed by each worker thread. This is
+possible thanks to the use of a ROOT::TThreadedObject, so that each thread works with its
+own TFile and TTree objects.
 */
 
 #include "TROOT.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace ROOT;
 
 namespace ROOT {
@@ -39,12 +43,9 @@ MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNa
 {
    // Note that as a side-effect of opening all files that are going to be used in the
    // analysis once, all necessary streamers will be loaded into memory.
-   TDirectory::TContext c;
-   std::vector<std::vector<EntryCluster>> clustersPerFile;
-   std::vector<Long64_t> entriesPerFile;
-   const auto nFileNames = fileNames.size();
-   Long64_t offset = 0ll;
-   for (auto i = 0u; i < nFileNames; ++i) {
+   using FileClusters = std::pair<std::vector<EntryCluster>, Long64_t>;
+   auto getFileClusters = [&](unsigned i) {
+      TDirectory::TContext c;
       std::unique_ptr<TFile> f(TFile::Open(fileNames[i].c_str())); // need TFile::Open to load plugins if need be
       TTree *t = nullptr; // not a leak, t will be deleted by f
       f->GetObject(treeName.c_str(), t);
@@ -55,17 +56,128 @@ MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNa
       std::vector<EntryCluster> clusters;
       while ((start = clusterIter()) < entries) {
          end = clusterIter.GetNextEntry();
-         // Add the current file's offset to start and end to make them (chain) global
-         clusters.emplace_back(EntryCluster{start + offset, end + offset});
+         clusters.emplace_back(EntryCluster{start, end});
+      }
+      return FileClusters(std::move(clusters), entries);
+   };
+
+   // The files are opened in parallel: with many files, opening them one after the other dominates the start-up time
+   const auto nFileNames = fileNames.size();
+   std::vector<FileClusters> fileClusters;
+   if (nFileNames > 1 && ROOT::IsImplicitMTEnabled()) {
+      TThreadExecutor pool;
+      fileClusters = pool.Map(getFileClusters, ROOT::TSeqU(nFileNames));
+   } else {
+      for (auto i = 0u; i < nFileNames; ++i)
+         fileClusters.emplace_back(getFileClusters(i));
+   }
+
+   std::vector<std::vector<EntryCluster>> clustersPerFile;
+   std::vector<Long64_t> entriesPerFile;
+   Long64_t offset = 0ll;
+   for (auto &fc : fileClusters) {
+      // Add the current file's offset to start and end to make them (chain) global
+      for (auto &c : fc.first) {
+         c.start += offset;
+         c.end += offset;
       }
-      offset += entries;
-      clustersPerFile.emplace_back(std::move(clusters));
-      entriesPerFile.emplace_back(entries);
+      offset += fc.second;
+      clustersPerFile.emplace_back(std::move(fc.first));
+      entriesPerFile.emplace_back(fc.second);
    }
 
    return std::make_pair(std::move(clustersPerFile), std::move(entriesPerFile));
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Group the clusters of a file in tasks of about `target` entries.
+/// Consecutive clusters are merged as long as the task does not exceed the
+/// target. If `split` is true, clusters larger than twice the target are split
+/// in pieces of about `target` entries: each piece reads and decompresses the
+/// baskets of the whole cluster again, so this only pays off when there are
+/// not enough clusters to occupy the workers.
+std::vector<EntryCluster> MakeTasks(const std::vector<EntryCluster> &clusters, Long64_t target, bool split)
+{
+   if (target <= 0)
+      return clusters;
+
+   std::vector<EntryCluster> tasks;
+   for (const auto &c : clusters) {
+      const Long64_t n = c.end - c.start;
+      if (split && n > 2 * target) {
+         const Long64_t nPieces = n / target;
+         for (Long64_t p = 0; p < nPieces; ++p)
+            tasks.emplace_back(EntryCluster{c.start + n * p / nPieces, c.start + n * (p + 1) / nPieces});
+      } else if (!tasks.empty() && tasks.back().end == c.start && tasks.back().end - tasks.back().start + n <= target) {
+         tasks.back().end = c.end;
+      } else {
+         tasks.emplace_back(c);
+      }
+   }
+   return tasks;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Return the sorted global entry numbers selected by the entry list.
+std::vector<Long64_t> GetSelectedEntries(TEntryList entryList)
+{
+   std::vector<Long64_t> entries;
+   entries.reserve(entryList.GetN());
+   for (Long64_t entry = entryList.GetEntry(0); entry >= 0; entry = entryList.Next())
+      entries.emplace_back(entry);
+   std::sort(entries.begin(), entries.end());
+   entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+   return entries;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Group the clusters of a file in tasks of about `target` selected entries.
+/// Clusters without selected entries are dropped, consecutive clusters are
+/// merged as long as the task stays below the target and, if `split` is true,
+/// clusters holding more selected entries than the target are split at
+/// selected entries. The returned ranges start at a selected entry and end
+/// after one.
+std::vector<EntryCluster> MakeSelectedEntriesTasks(const std::vector<EntryCluster> &clusters,
+                                                   const std::vector<Long64_t> &selectedEntries, Long64_t target,
+                                                   bool split)
+{
+   std::vector<EntryCluster> tasks;
+   EntryCluster task{0ll, 0ll};
+   Long64_t nInTask = 0ll;
+   auto flushTask = [&]() {
+      if (nInTask > 0)
+         tasks.emplace_back(task);
+      nInTask = 0ll;
+   };
+
+   for (const auto &c : clusters) {
+      const auto first = std::lower_bound(selectedEntries.begin(), selectedEntries.end(), c.start);
+      const auto last = std::lower_bound(first, selectedEntries.end(), c.end);
+      const Long64_t n = last - first;
+      if (n == 0)
+         continue;
+      if (split && n > target) {
+         flushTask();
+         const Long64_t nPieces = (n + target - 1) / target;
+         for (Long64_t p = 0; p < nPieces; ++p) {
+            const auto pieceFirst = first + n * p / nPieces;
+            const auto pieceLast = first + n * (p + 1) / nPieces;
+            tasks.emplace_back(EntryCluster{*pieceFirst, *(pieceLast - 1) + 1});
+         }
+         continue;
+      }
+      if (nInTask + n > target)
+         flushTask();
+      if (nInTask == 0)
+         task.start = *first;
+      task.end = *(last - 1) + 1;
+      nInTask += n;
+   }
+   flushTask();
+
+   return tasks;
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector containing the number of entries of each file of each friend TChain
 std::vector<std::vector<Long64_t>> GetFriendEntries(const std::vector<std::pair<std::string, std::string>> &friendNames,
@@ -91,6 +203,8 @@ std::vector<std::vector<Long64_t>> GetFriendEntries(const std::vector<std::pair<
 }
 }
 
+unsigned TTreeProcessorMT::fgTasksPerWorkerHint = 10U;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get and store the names, aliases and file names of the friends of the tree.
 /// \param[in] tree The main tree whose friends to 
@@ -229,6 +343,23 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree, const TEntryList &entries)
 /// \param[in] tree Tree or chain of files containing the tree to process.
 TTreeProcessorMT::TTreeProcessorMT(TTree &tree) : TTreeProcessorMT(tree, TEntryList()) {}
 
+//////////////////////////////////////////////////////////////////////////////
+/// Restrict the processing to the global entry range [beginEntry, endEntry).
+/// Only the clusters that overlap with the range are scheduled, and the
+/// first and last of them are trimmed to the range boundaries.
+/// After this call, the TTreeReaders passed to the user function always use
+/// entry numbers that are global to the whole dataset, also when the input
+/// is made of several files.
+/// \param[in] beginEntry First entry to process.
+/// \param[in] endEntry Entry after the last one to process, -1 to process until the end of the dataset.
+void TTreeProcessorMT::SetEntriesRange(Long64_t beginEntry, Long64_t endEntry)
+{
+   if (beginEntry < 0 || (endEntry >= 0 && endEntry < beginEntry))
+      throw std::runtime_error("TTreeProcessorMT::SetEntriesRange: invalid range of entries");
+   fEntriesRange = std::make_pair(beginEntry, endEntry);
+   fHasEntriesRange = true;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// Process the entries of a TTree in parallel. The user-provided function
 /// receives a TTreeReader which can be used to iterate on a subrange of
@@ -245,17 +376,21 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree) : TTreeProcessorMT(tree, TEntryL
 /// be processed in parallel. This means that the code of the user function
 /// should be thread safe.
 ///
+/// If a TEntryList was provided, only the clusters holding selected entries
+/// are processed, and the subranges are sized by their number of selected
+/// entries rather than by cluster.
+///
 /// \param[in] func User-defined function that processes a subrange of entries
 void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 {
    const std::vector<Internal::NameAlias> &friendNames = fFriendInfo.fFriendNames;
    const std::vector<std::vector<std::string>> &friendFileNames = fFriendInfo.fFriendFileNames;
 
-   // If an entry list or friend trees are present, we need to generate clusters with global entry numbers,
-   // so we do it here for all files.
+   // If an entry list, friend trees or an entry range are present, we need to generate clusters with global entry
+   // numbers, so we do it here for all files.
    const bool hasFriends = !friendNames.empty();
    const bool hasEntryList = fEntryList.GetN() > 0;
-   const bool shouldRetrieveAllClusters = hasFriends || hasEntryList;
+   const bool shouldRetrieveAllClusters = hasFriends || hasEntryList || fHasEntriesRange;
    const auto clustersAndEntries =
       shouldRetrieveAllClusters ? Internal::MakeClusters(fTreeName, fFileNames) : Internal::ClustersAndEntries{};
    const auto &clusters = clustersAndEntries.first;
@@ -265,14 +400,52 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const auto friendEntries =
       hasFriends ? Internal::GetFriendEntries(friendNames, friendFileNames) : std::vector<std::vector<Long64_t>>{};
 
-   TThreadExecutor pool;
-   // Parent task, spawns tasks that process each of the entry clusters for each input file
+   // The tasks are sized so that each worker processes about fgTasksPerWorkerHint of them: enough for the
+   // work-stealing scheduler to balance the load, without drowning the processing in tiny tasks.
+   const Long64_t nWorkers = std::max(1u, ROOT::GetImplicitMTPoolSize());
+   const Long64_t nTasks = nWorkers * static_cast<Long64_t>(fgTasksPerWorkerHint);
+   auto getTaskSize = [nTasks](Long64_t nEntries) { return nTasks > 0 ? std::max(1ll, nEntries / nTasks) : 0ll; };
+
+   // With an entry list, only the clusters holding selected entries are processed, in tasks balanced by the
+   // number of selected entries.
+   const auto selectedEntries = hasEntryList ? Internal::GetSelectedEntries(fEntryList) : std::vector<Long64_t>{};
+   const Long64_t nSelected = selectedEntries.size();
+   const Long64_t selectedPerTask = std::max(1ll, nTasks > 0 ? getTaskSize(nSelected) : nSelected);
+
+   // Only the clusters that overlap with the requested range are scheduled, trimmed to its boundaries
    using Internal::EntryCluster;
+   auto getClustersInRange = [this](const std::vector<EntryCluster> &fileClusters) {
+      if (!fHasEntriesRange)
+         return fileClusters;
+      std::vector<EntryCluster> clustersInRange;
+      const auto rangeBegin = fEntriesRange.first;
+      const auto rangeEnd = fEntriesRange.second;
+      for (const auto &c : fileClusters) {
+         if (c.end <= rangeBegin || (rangeEnd >= 0 && c.start >= rangeEnd))
+            continue;
+         clustersInRange.push_back({std::max(c.start, rangeBegin), rangeEnd >= 0 ? std::min(c.end, rangeEnd) : c.end});
+      }
+      return clustersInRange;
+   };
+
+   // Number of entries and clusters to process, if the clusters of all files are known
+   Long64_t totalEntries = std::accumulate(entries.begin(), entries.end(), 0ll);
+   if (fHasEntriesRange) {
+      const auto rangeEnd = fEntriesRange.second >= 0 ? std::min(fEntriesRange.second, totalEntries) : totalEntries;
+      totalEntries = std::max(0ll, rangeEnd - fEntriesRange.first);
+   }
+   Long64_t totalClusters = 0ll;
+   for (const auto &fileClusters : clusters)
+      totalClusters += getClustersInRange(fileClusters).size();
+
+   TThreadExecutor pool;
+   // Parent task, spawns the tasks that process the entry clusters of each input file. Without global entry
+   // numbers, the clusters of a file are only looked up when its task runs, while other files are processed.
    auto processFile = [&](std::size_t fileIdx) {
 
       // If cluster information is already present, build TChains with all input files and use global entry numbers
       // Otherwise get cluster information only for the file we need to process and use local entry numbers
-      const bool shouldUseGlobalEntries = hasFriends || hasEntryList;
+      const bool shouldUseGlobalEntries = shouldRetrieveAllClusters;
       // theseFiles contains either all files or just the single file to process
       const auto &theseFiles = shouldUseGlobalEntries ? fFileNames : std::vector<std::string>({fFileNames[fileIdx]});
       // Evaluate clusters (with local entry numbers) and number of entries for this file, if needed
@@ -293,14 +466,29 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
          std::unique_ptr<TTreeReader> reader;
          std::unique_ptr<TEntryList> elist;
          std::tie(reader, elist) = treeView->GetTreeReader(c.start, c.end, fTreeName, theseFiles, fFriendInfo,
-                                                           fEntryList, theseEntries, friendEntries);
+                                                           selectedEntries, theseEntries, friendEntries);
          func(*reader);
 
          // In case of task interleaving, we need to load here the tree of the parent task
          treeView->PopTaskFirstEntry();
       };
 
-      pool.Foreach(processCluster, thisFileClusters);
+      auto clustersInRange = getClustersInRange(thisFileClusters);
+
+      // Splitting a cluster makes several tasks read and decompress the same baskets: only do it when there are
+      // fewer clusters than workers. When the files are discovered one by one, the totals are estimated assuming
+      // files of similar size.
+      const Long64_t nClusters =
+         shouldUseGlobalEntries ? totalClusters : static_cast<Long64_t>(clustersInRange.size() * fFileNames.size());
+      const bool split = nClusters < nWorkers;
+      if (hasEntryList) {
+         clustersInRange = Internal::MakeSelectedEntriesTasks(clustersInRange, selectedEntries, selectedPerTask, split);
+      } else {
+         const Long64_t nEntries = shouldUseGlobalEntries ? totalEntries : theseEntries[0] * fFileNames.size();
+         clustersInRange = Internal::MakeTasks(clustersInRange, getTaskSize(nEntries), split);
+      }
+      if (!clustersInRange.empty())
+         pool.Foreach(processCluster, clustersInRange);
    };
 
    std::vector<std::size_t> fileIdxs(fFileNames.size());
@@ -311,3 +499,27 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 
    pool.Foreach(processFile, fileIdxs);
 }
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Sets the hint for the number of tasks created per worker thread.
+/// \param[in] m The number of tasks aimed at for each worker thread.
+///
+/// Consecutive clusters of the input are merged so that about `m` tasks are
+/// created for each worker thread of the implicit multi-threading pool. More
+/// tasks balance the load better, at the cost of more overhead per entry.
+/// Clusters are only split when there are fewer of them than worker threads,
+/// since the pieces of a cluster read and decompress the same baskets.
+/// A value of 0 processes exactly one cluster per task (one file per task
+/// when processing a TEntryList).
+void TTreeProcessorMT::SetTasksPerWorkerHint(unsigned m)
+{
+   fgTasksPerWorkerHint = m;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Retrieve the current value for the desired number of tasks per worker.
+/// \return The desired number of tasks to be created per worker. TTreeProcessorMT uses this value as an hint.
+unsigned TTreeProcessorMT::GetTasksPerWorkerHint()
+{
+   return fgTasksPerWorkerHint;
+}
@@ -0,0 +1,84 @@
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+static TTree *MakeJitTree()
+{
+   double x = 0.;
+   float y = 0.;
+   int n = 0;
+
+   TTree *tree = new TTree("jit", "TTreeFormula JIT test tree");
+   tree->Branch("x", &x, "x/D");
+   tree->Branch("y", &y, "y/F");
+   tree->Branch("n", &n, "n/I");
+   for (int entry = 0; entry < 50; ++entry) {
+      x = 0.37 * entry - 5.;
+      y = 1.5f - 0.1f * entry;
+      n = entry;
+      tree->Fill();
+   }
+   tree->ResetBranchAddresses();
+   return tree;
+}
+
+TEST(TTreeFormulaJit, SameResultsAsInterpreter)
+{
+   std::unique_ptr<TTree> tree(MakeJitTree());
+
+   const char *expressions[] = {"x*y+3",
+                                "x/y - n%7",
+                                "sqrt(x)*log(y)+exp(-x*x)",
+                                "x>0 && (y<0.5 || n==3)",
+                                "!(n&3) + (n<<2) - abs(x)",
+                                "pi*x - atan2(y,x) + pow(x,2)",
+                                "min(x,y)*max(n,4)/(y-y)"};
+
+   for (const char *expr : expressions) {
+      TTreeFormula interpreted("interpreted", expr, tree.get());
+      TTreeFormula compiled("compiled", expr, tree.get());
+      ASSERT_GT(compiled.GetNdim(), 0) << expr;
+      EXPECT_TRUE(compiled.CompileJit()) << expr;
+      EXPECT_FALSE(interpreted.IsJitCompiled()) << expr;
+
+      for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+         tree->LoadTree(entry);
+         EXPECT_DOUBLE_EQ(interpreted.EvalInstance(), compiled.EvalInstance()) << expr << " entry " << entry;
+      }
+   }
+}
+
+TEST(TTreeFormulaJit, UnsupportedFormula)
+{
+   std::unique_ptr<TTree> tree(MakeJitTree());
+
+   TTreeFormula cond("cond", "x>0 ? x : y", tree.get());
+   EXPECT_FALSE(cond.CompileJit());
+   EXPECT_FALSE(cond.IsJitCompiled());
+
+   TTreeFormula entry("entry", "Entry$*x", tree.get());
+   EXPECT_FALSE(entry.CompileJit());
+}
+
+TEST(TTreeFormulaJit, Draw)
+{
+   std::unique_ptr<TTree> tree(MakeJitTree());
+
+   Long64_t interpreted = tree->Draw("x*y", "x>0 && n%3==1", "goff");
+   std::vector<double> expected(tree->GetV1(), tree->GetV1() + interpreted);
+   EXPECT_FALSE(tree->GetVar1()->IsJitCompiled());
+   EXPECT_FALSE(tree->GetSelect()->IsJitCompiled());
+
+   TTreeFormula::SetJitEnabled(kTRUE);
+   Long64_t compiled = tree->Draw("x*y", "x>0 && n%3==1", "goff");
+   TTreeFormula::SetJitEnabled(kFALSE);
+   EXPECT_TRUE(tree->GetVar1()->IsJitCompiled());
+   EXPECT_TRUE(tree->GetSelect()->IsJitCompiled());
+
+   ASSERT_EQ(interpreted, compiled);
+   for (Long64_t i = 0; i < compiled; ++i)
+      EXPECT_DOUBLE_EQ(expected[i], tree->GetV1()[i]);
+}
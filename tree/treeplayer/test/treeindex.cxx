@@ -0,0 +1,65 @@
+#include "TTree.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+static TTree *MakeIndexTree(int first, int nentries)
+{
+   int run = 0;
+   int event = 0;
+   TTree *tree = new TTree("idx", "TTreeIndex test tree");
+   tree->SetDirectory(nullptr);
+   tree->Branch("run", &run, "run/I");
+   tree->Branch("event", &event, "event/I");
+   for (int i = first; i < first + nentries; ++i) {
+      // Entries are not stored in index order.
+      const int key = (i * 7919) % 100000;
+      run = key / 1000;
+      event = key % 1000;
+      tree->Fill();
+   }
+   tree->ResetBranchAddresses();
+   return tree;
+}
+
+TEST(TTreeIndex, FindAllEntries)
+{
+   const int n = 5000;
+   std::unique_ptr<TTree> tree(MakeIndexTree(0, n));
+   ASSERT_EQ(tree->BuildIndex("run", "event"), n);
+
+   for (int i = 0; i < n; ++i) {
+      const int key = (i * 7919) % 100000;
+      EXPECT_EQ(tree->GetEntryNumberWithIndex(key / 1000, key % 1000), i);
+   }
+   EXPECT_EQ(tree->GetEntryNumberWithIndex(-1, 0), -1);
+   EXPECT_EQ(tree->GetEntryNumberWithIndex(1000, 0), -1);
+}
+
+TEST(TTreeIndex, AppendSortedRuns)
+{
+   const int n1 = 3000;
+   const int n2 = 2000;
+   std::unique_ptr<TTree> tree1(MakeIndexTree(0, n1));
+   std::unique_ptr<TTree> tree2(MakeIndexTree(n1, n2));
+   ASSERT_EQ(tree1->BuildIndex("run", "event"), n1);
+   ASSERT_EQ(tree2->BuildIndex("run", "event"), n2);
+
+   // Same sequence as the fast merge of TTree::CopyEntries.
+   auto index = static_cast<TTreeIndex *>(tree1->GetTreeIndex());
+   index->Append(tree2->GetTreeIndex(), kTRUE);
+   index->Append(nullptr, kFALSE);
+   ASSERT_EQ(index->GetN(), n1 + n2);
+
+   for (Long64_t i = 1; i < index->GetN(); ++i) {
+      const Long64_t *major = index->GetIndexValues();
+      const Long64_t *minor = index->GetIndexValuesMinor();
+      EXPECT_TRUE(major[i - 1] < major[i] || (major[i - 1] == major[i] && minor[i - 1] <= minor[i]));
+   }
+   for (int i = 0; i < n1 + n2; ++i) {
+      const int key = (i * 7919) % 100000;
+      EXPECT_EQ(index->GetEntryNumberWithIndex(key / 1000, key % 1000), i);
+   }
+}
@@ -0,0 +1,130 @@
+#include <string>
+#include <vector>
+
+#include <TChain.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TROOT.h>
+#include <TSelectorDraw.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <TTreePlayer.h>
+
+#include "gtest/gtest.h"
+
+void WriteDrawFiles(const std::string &treename, const std::vector<std::string> &filenames)
+{
+   double x = 0.;
+   int n = 0;
+   float arr[10];
+   int entry = 0;
+   for (const auto &f : filenames) {
+      TFile file(f.c_str(), "recreate");
+      TTree t(treename.c_str(), treename.c_str());
+      t.Branch("x", &x, "x/D");
+      t.Branch("n", &n, "n/I");
+      t.Branch("arr", arr, "arr[n]/F");
+      t.SetAutoFlush(100);
+      for (auto i = 0; i < 2000; ++i, ++entry) {
+         x = ((entry * 7919) % 1000) / 100. - 5.;
+         n = entry % 10;
+         for (auto j = 0; j < n; ++j)
+            arr[j] = x * j;
+         t.Fill();
+      }
+      t.Write();
+   }
+}
+
+bool IsProcessedMT(TTree &tree)
+{
+   auto player = static_cast<TTreePlayer *>(tree.GetPlayer());
+   return static_cast<TSelectorDraw *>(player->GetSelector())->IsProcessedMT();
+}
+
+void ExpectSameHistograms(const TH1 &serial, const TH1 &parallel)
+{
+   ASSERT_EQ(serial.GetNcells(), parallel.GetNcells());
+   EXPECT_DOUBLE_EQ(serial.GetEntries(), parallel.GetEntries());
+   for (auto bin = 0; bin < serial.GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(serial.GetBinContent(bin), parallel.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(serial.GetBinError(bin), parallel.GetBinError(bin));
+   }
+}
+
+TEST(TreeDrawMT, SameResultsAsSequential)
+{
+   const std::string treename = "drawmt";
+   const std::vector<std::string> filenames = {"drawmt_0.root", "drawmt_1.root", "drawmt_2.root"};
+   WriteDrawFiles(treename, filenames);
+
+   TChain chain(treename.c_str());
+   for (const auto &f : filenames)
+      chain.Add(f.c_str());
+
+   struct Query {
+      const char *varexp;
+      const char *selection;
+   };
+   const std::vector<Query> queries = {{"x>>hs(50,-5,5)", "n>2"},
+                                       {"arr>>hs(40,-50,50)", "arr>0"},
+                                       {"x:n>>hs(10,0,10,20,-5,5)", ""},
+                                       {"arr:x>>hs(20,-5,5)", "Iteration$>1"}};
+
+   for (const auto &q : queries) {
+      const std::string parallelExp = std::string(q.varexp).replace(std::string(q.varexp).find(">>hs"), 4, ">>hp");
+
+      ROOT::DisableImplicitMT();
+      Long64_t serialRows = chain.Draw(q.varexp, q.selection, "goff");
+      auto serial = static_cast<TH1 *>(gDirectory->Get("hs"));
+      ASSERT_NE(serial, nullptr) << q.varexp;
+
+      ROOT::EnableImplicitMT(4);
+      Long64_t parallelRows = chain.Draw(parallelExp.c_str(), q.selection, "goff mt");
+      EXPECT_TRUE(IsProcessedMT(chain)) << parallelExp;
+      auto parallel = static_cast<TH1 *>(gDirectory->Get("hp"));
+      ASSERT_NE(parallel, nullptr) << parallelExp;
+      ROOT::DisableImplicitMT();
+
+      EXPECT_EQ(serialRows, parallelRows) << q.varexp;
+      ExpectSameHistograms(*serial, *parallel);
+      delete serial;
+      delete parallel;
+   }
+
+   // Without the "mt" option the sequential loop fills the buffers of GetV1.
+   ROOT::EnableImplicitMT(4);
+   Long64_t rows = chain.Draw("x>>hv(50,-5,5)", "n>2", "goff");
+   EXPECT_FALSE(IsProcessedMT(chain));
+   ASSERT_GT(rows, 0);
+   ASSERT_NE(chain.GetV1(), nullptr);
+   for (Long64_t i = 0; i < rows; ++i) {
+      EXPECT_GE(chain.GetV1()[i], -5.);
+      EXPECT_LT(chain.GetV1()[i], 5.);
+   }
+   ROOT::DisableImplicitMT();
+   delete gDirectory->Get("hv");
+
+   // "mt" must be a separate word of the option: letters of other options do not enable it.
+   ROOT::EnableImplicitMT(4);
+   for (const char *option : {"goffmt", "goff amt", "goff,mtx"}) {
+      chain.Draw("x>>ho(50,-5,5)", "n>2", option);
+      EXPECT_FALSE(IsProcessedMT(chain)) << option;
+      delete gDirectory->Get("ho");
+   }
+   chain.Draw("x>>ho(50,-5,5)", "n>2", "goff,MT");
+   EXPECT_TRUE(IsProcessedMT(chain));
+   delete gDirectory->Get("ho");
+   ROOT::DisableImplicitMT();
+
+   ROOT::DisableImplicitMT();
+   Long64_t serialCount = chain.GetEntries("x>1 && arr>2");
+   ROOT::EnableImplicitMT(4);
+   Long64_t parallelCount = chain.GetEntries("x>1 && arr>2");
+   ROOT::DisableImplicitMT();
+   EXPECT_EQ(serialCount, parallelCount);
+   EXPECT_GT(serialCount, 0);
+
+   for (const auto &f : filenames)
+      gSystem->Unlink(f.c_str());
+}
@@ -4,7 +4,10 @@
 #include <string>
 #include <thread>
 
+#include <TChain.h>
+#include <TEntryList.h>
 #include <TFile.h>
+#include <TROOT.h>
 #include <TTree.h>
 #include <TSystem.h>
 #include <TTreeReader.h>
@@ -71,3 +74,160 @@ TEST(TreeProcessorMT, ManyFiles)
 
    DeleteFiles(filenames);
 }
+
+TEST(TreeProcessorMT, SparseEntryList)
+{
+   const auto nFiles = 20u;
+   const std::string treename = "t";
+   std::vector<std::string> filenames;
+   for (auto i = 0u; i < nFiles; ++i)
+      filenames.emplace_back("treeprocmt_elist_" + std::to_string(i) + ".root");
+
+   WriteFiles(treename, filenames);
+
+   TChain chain(treename.c_str());
+   for (const auto &f : filenames)
+      chain.Add(f.c_str());
+
+   // Select a few entries of files 3 and 17 only: v is the global entry number + 1
+   TEntryList entries;
+   int expectedSum = 0;
+   for (auto entry : {31, 33, 38, 170, 179}) {
+      entries.Enter(entry);
+      expectedSum += entry + 1;
+   }
+
+   std::atomic_int sum(0);
+   std::atomic_int count(0);
+   std::atomic_int emptyTasks(0);
+   auto sumValues = [&](TTreeReader &r) {
+      TTreeReaderValue<int> v(r, "v");
+      int n = 0;
+      while (r.Next()) {
+         sum += *v;
+         ++n;
+      }
+      count += n;
+      if (n == 0)
+         ++emptyTasks;
+   };
+
+   ROOT::TTreeProcessorMT proc(chain, entries);
+   proc.Process(sumValues);
+
+   EXPECT_EQ(count.load(), 5);
+   EXPECT_EQ(sum.load(), expectedSum);
+   // The clusters of the files without selected entries are not scheduled
+   EXPECT_EQ(emptyTasks.load(), 0);
+
+   DeleteFiles(filenames);
+}
+
+static int CountTasks(const std::string &filename, const std::string &treename, unsigned tasksPerWorker, int &count)
+{
+   const auto oldHint = ROOT::TTreeProcessorMT::GetTasksPerWorkerHint();
+   ROOT::TTreeProcessorMT::SetTasksPerWorkerHint(tasksPerWorker);
+   std::atomic_int nTasks(0);
+   std::atomic_int nEntries(0);
+   ROOT::TTreeProcessorMT proc(filename, treename);
+   proc.Process([&](TTreeReader &r) {
+      ++nTasks;
+      while (r.Next())
+         ++nEntries;
+   });
+   ROOT::TTreeProcessorMT::SetTasksPerWorkerHint(oldHint);
+   count = nEntries;
+   return nTasks;
+}
+
+TEST(TreeProcessorMT, TaskSizing)
+{
+   const std::string treename = "t";
+   const std::string filename = "treeprocmt_tasksizing.root";
+   const auto nWorkers = std::max(1u, ROOT::GetImplicitMTPoolSize());
+   int count = 0;
+
+   {
+      // Many small clusters are merged
+      TFile f(filename.c_str(), "recreate");
+      TTree t(treename.c_str(), treename.c_str());
+      int v = 0;
+      t.Branch("v", &v);
+      t.SetAutoFlush(10);
+      for (v = 0; v < 1000; ++v)
+         t.Fill();
+      t.Write();
+   }
+   EXPECT_EQ(CountTasks(filename, treename, 0, count), 100);
+   EXPECT_EQ(count, 1000);
+   if (2 * nWorkers < 100) {
+      EXPECT_LT(CountTasks(filename, treename, 2, count), 100);
+      EXPECT_EQ(count, 1000);
+   }
+
+   {
+      // A single large cluster is split if there are several workers
+      TFile f(filename.c_str(), "recreate");
+      TTree t(treename.c_str(), treename.c_str());
+      int v = 0;
+      t.Branch("v", &v);
+      t.SetAutoFlush(0);
+      for (v = 0; v < 1000; ++v)
+         t.Fill();
+      t.Write();
+   }
+   const int nClusters = CountTasks(filename, treename, 0, count);
+   EXPECT_EQ(count, 1000);
+   if (nClusters == 1 && nWorkers > 1) {
+      EXPECT_GE(CountTasks(filename, treename, 4, count), int(4 * nWorkers));
+      EXPECT_EQ(count, 1000);
+   }
+
+   gSystem->Unlink(filename.c_str());
+}
+
+static Long64_t CountBytesRead(const std::string &filename, const std::string &treename, unsigned tasksPerWorker)
+{
+   const auto oldHint = ROOT::TTreeProcessorMT::GetTasksPerWorkerHint();
+   ROOT::TTreeProcessorMT::SetTasksPerWorkerHint(tasksPerWorker);
+   const auto before = TFile::GetFileBytesRead();
+   ROOT::TTreeProcessorMT proc(filename, treename);
+   proc.Process([&](TTreeReader &r) {
+      TTreeReaderValue<double> v(r, "v");
+      while (r.Next())
+         *v;
+   });
+   ROOT::TTreeProcessorMT::SetTasksPerWorkerHint(oldHint);
+   return TFile::GetFileBytesRead() - before;
+}
+
+TEST(TreeProcessorMT, ClustersNotSplitWhenWorkersAreBusy)
+{
+   const std::string treename = "t";
+   const std::string filename = "treeprocmt_bytesread.root";
+   const auto nWorkers = 4u;
+   ROOT::EnableImplicitMT(nWorkers);
+
+   {
+      // More clusters than workers, each bigger than the task size aimed at
+      TFile f(filename.c_str(), "recreate");
+      TTree t(treename.c_str(), treename.c_str());
+      double v = 0;
+      t.Branch("v", &v);
+      t.SetAutoFlush(10000);
+      for (int i = 0; i < 16 * 10000; ++i) {
+         v = i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   // One task per cluster reads each basket once: the default sizing must not read more
+   const auto bytesPerCluster = CountBytesRead(filename, treename, 0);
+   EXPECT_GT(bytesPerCluster, 0);
+   EXPECT_LE(CountBytesRead(filename, treename, ROOT::TTreeProcessorMT::GetTasksPerWorkerHint()), bytesPerCluster);
+   EXPECT_LE(CountBytesRead(filename, treename, 100), bytesPerCluster);
+
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(filename.c_str());
+}
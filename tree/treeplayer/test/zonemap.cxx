@@ -0,0 +1,107 @@
+#include "ROOT/TIOFeatures.hxx"
+#include "TFile.h"
+#include "TMemFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+static TTree *MakeZoneMapTree(bool zoneMap, const char *name = "zm")
+{
+   int x = 0;
+   float y = 0;
+   TTree *tree = new TTree(name, "Zone map test tree");
+   if (zoneMap) {
+      ROOT::TIOFeatures features;
+      features.Set(ROOT::Experimental::EIOFeatures::kGenerateZoneMap);
+      tree->SetIOFeatures(features);
+   }
+   tree->SetAutoFlush(100);
+   tree->Branch("x", &x, "x/I");
+   tree->Branch("y", &y, "y/F");
+   for (int i = 0; i < 1000; ++i) {
+      x = i;
+      y = (i % 100) * 0.5;
+      tree->Fill();
+   }
+   tree->FlushBaskets();
+   tree->ResetBranchAddresses();
+   return tree;
+}
+
+TEST(TTreeFormula, CanSkipEntryRange)
+{
+   TMemFile file("zonemap.root", "RECREATE");
+   std::unique_ptr<TTree> tree(MakeZoneMapTree(true));
+   tree->LoadTree(0);
+
+   TTreeFormula greater("greater", "x > 450", tree.get());
+   EXPECT_TRUE(greater.CanSkipEntryRange(0, 99));
+   EXPECT_TRUE(greater.CanSkipEntryRange(300, 399));
+   EXPECT_FALSE(greater.CanSkipEntryRange(400, 499));
+   EXPECT_FALSE(greater.CanSkipEntryRange(900, 999));
+
+   TTreeFormula both("both", "x >= 100 && 2*x - 1 < 200", tree.get());
+   EXPECT_TRUE(both.CanSkipEntryRange(0, 99));
+   EXPECT_FALSE(both.CanSkipEntryRange(100, 199));
+   EXPECT_TRUE(both.CanSkipEntryRange(200, 299));
+
+   TTreeFormula either("either", "!(x < 500) || y > 60", tree.get());
+   EXPECT_TRUE(either.CanSkipEntryRange(0, 99));
+   EXPECT_FALSE(either.CanSkipEntryRange(500, 599));
+
+   // Functions are not supported.
+   TTreeFormula func("func", "sqrt(x) > 100", tree.get());
+   EXPECT_FALSE(func.CanSkipEntryRange(0, 99));
+
+   std::unique_ptr<TTree> plain(MakeZoneMapTree(false));
+   plain->LoadTree(0);
+   TTreeFormula noZoneMap("noZoneMap", "x > 450", plain.get());
+   EXPECT_FALSE(noZoneMap.CanSkipEntryRange(0, 99));
+}
+
+TEST(TTreeFormula, ZoneMapSelection)
+{
+   TMemFile file("zonemap.root", "RECREATE");
+   std::unique_ptr<TTree> tree(MakeZoneMapTree(true));
+   std::unique_ptr<TTree> plain(MakeZoneMapTree(false));
+   for (const char *selection : {"x > 450", "x >= 100 && x < 250", "x < 30 || x > 970", "y > 40 && x > 800"}) {
+      EXPECT_EQ(tree->GetEntries(selection), plain->GetEntries(selection)) << selection;
+      EXPECT_EQ(tree->Draw("y", selection, "goff"), plain->Draw("y", selection, "goff")) << selection;
+   }
+}
+
+TEST(TTreeFormula, ZoneMapReadsFewerBytes)
+{
+   const char *fileName = "zonemap_bytes.root";
+   {
+      TFile file(fileName, "RECREATE");
+      MakeZoneMapTree(true, "zm");
+      MakeZoneMapTree(false, "plain");
+      file.Write();
+   }
+
+   TFile file(fileName);
+   // Read the baskets one by one, so that the bytes of the skipped clusters are not prefetched.
+   auto getEntries = [&file](const char *treeName, const char *selection, Long64_t &bytesRead) {
+      auto tree = static_cast<TTree *>(file.Get(treeName));
+      tree->SetCacheSize(0);
+      const auto before = file.GetBytesRead();
+      const auto entries = tree->GetEntries(selection);
+      bytesRead = file.GetBytesRead() - before;
+      delete tree;
+      return entries;
+   };
+   for (const char *selection : {"x > 450", "x >= 100 && x < 250", "x < 30 || x > 970", "y > 40 && x > 800"}) {
+      Long64_t zoneMapBytes = 0;
+      Long64_t plainBytes = 0;
+      EXPECT_EQ(getEntries("plain", selection, plainBytes), getEntries("zm", selection, zoneMapBytes)) << selection;
+      EXPECT_GT(zoneMapBytes, 0) << selection;
+      EXPECT_LT(zoneMapBytes, plainBytes) << selection;
+   }
+
+   gSystem->Unlink(fileName);
+}